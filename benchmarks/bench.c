@@ -0,0 +1,332 @@
+// Times the Slice99 functions across item sizes and lengths.
+//
+// Usage: ./bench [MIN_MS]
+//
+// Every function is run repeatedly until at least MIN_MS milliseconds (10 by default) elapse. The
+// results are printed to stdout as CSV: `function,item_size,len,bytes,ns_per_op,gb_per_s`, where
+// `bytes` is the number of bytes processed by one call (0 for constant-time functions).
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <slice99.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    // Filled with zeros; `lhs` and `rhs` hold the same contents before and after every benchmark.
+    Slice99 lhs, rhs;
+
+    // Filled with zeros, except for the first item (0xEE bytes) and the last item (0xFF bytes).
+    Slice99 haystack;
+
+    void *backup;
+} Fixture;
+
+typedef size_t (*BenchFn)(const Fixture *f);
+
+static volatile uintptr_t sink;
+static size_t cmp_item_size;
+
+// An item of distinct bytes, so that `Slice99_fill` cannot take its `memset` path.
+static unsigned char fill_item[64];
+
+static int bytes_cmp(const void *lhs, const void *rhs) {
+    return memcmp(lhs, rhs, cmp_item_size);
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * UINT64_C(1000000000) + (uint64_t)ts.tv_nsec;
+}
+
+#define BENCH(name) static size_t bench_##name(const Fixture *f)
+
+// Constant-time functions {
+
+BENCH(new) {
+    const Slice99 result = Slice99_new(f->lhs.ptr, f->lhs.item_size, f->lhs.len);
+    sink = (uintptr_t)result.ptr;
+    return 0;
+}
+
+BENCH(size) {
+    sink = Slice99_size(f->lhs);
+    return 0;
+}
+
+BENCH(get) {
+    sink = (uintptr_t)Slice99_get(f->lhs, (ptrdiff_t)(sink % f->lhs.len));
+    return 0;
+}
+
+BENCH(first) {
+    sink = (uintptr_t)Slice99_first(f->lhs);
+    return 0;
+}
+
+BENCH(last) {
+    sink = (uintptr_t)Slice99_last(f->lhs);
+    return 0;
+}
+
+BENCH(sub) {
+    const Slice99 result = Slice99_sub(f->lhs, 0, (ptrdiff_t)(f->lhs.len / 2));
+    sink = (uintptr_t)result.ptr + result.len;
+    return 0;
+}
+
+BENCH(advance) {
+    const Slice99 result = Slice99_advance(f->lhs, (ptrdiff_t)(f->lhs.len / 2));
+    sink = (uintptr_t)result.ptr + result.len;
+    return 0;
+}
+
+BENCH(split_at) {
+    Slice99 lhs, rhs;
+    Slice99_split_at(f->lhs, f->lhs.len / 2, &lhs, &rhs);
+    sink = (uintptr_t)lhs.ptr + (uintptr_t)rhs.ptr;
+    return 0;
+}
+
+BENCH(swap) {
+    Slice99_swap(f->lhs, 0, (ptrdiff_t)f->lhs.len - 1, f->backup);
+    return 0;
+}
+
+// } (Constant-time functions)
+
+// Linear-time functions {
+
+BENCH(primitive_eq) {
+    sink = Slice99_primitive_eq(f->lhs, f->rhs);
+    return Slice99_size(f->lhs);
+}
+
+BENCH(eq) {
+    sink = Slice99_eq(f->lhs, f->rhs, bytes_cmp);
+    return Slice99_size(f->lhs);
+}
+
+BENCH(primitive_starts_with) {
+    sink = Slice99_primitive_starts_with(f->lhs, f->rhs);
+    return Slice99_size(f->lhs);
+}
+
+BENCH(starts_with) {
+    sink = Slice99_starts_with(f->lhs, f->rhs, bytes_cmp);
+    return Slice99_size(f->lhs);
+}
+
+BENCH(primitive_ends_with) {
+    sink = Slice99_primitive_ends_with(f->lhs, f->rhs);
+    return Slice99_size(f->lhs);
+}
+
+BENCH(ends_with) {
+    sink = Slice99_ends_with(f->lhs, f->rhs, bytes_cmp);
+    return Slice99_size(f->lhs);
+}
+
+BENCH(primitive_find_item) {
+    sink = (uintptr_t)Slice99_primitive_find_item(f->haystack, Slice99_last(f->haystack));
+    return Slice99_size(f->haystack);
+}
+
+BENCH(primitive_rfind_item) {
+    sink = (uintptr_t)Slice99_primitive_rfind_item(f->haystack, Slice99_first(f->haystack));
+    return Slice99_size(f->haystack);
+}
+
+BENCH(find_item) {
+    sink = (uintptr_t)Slice99_find_item(f->haystack, Slice99_last(f->haystack), bytes_cmp);
+    return Slice99_size(f->haystack);
+}
+
+BENCH(primitive_find) {
+    const Slice99 needle = Slice99_advance(f->haystack, (ptrdiff_t)f->haystack.len - 2);
+    sink = (uintptr_t)Slice99_primitive_find(f->haystack, needle);
+    return Slice99_size(f->haystack);
+}
+
+BENCH(primitive_rfind) {
+    const Slice99 needle = Slice99_sub(f->haystack, 0, 2);
+    sink = (uintptr_t)Slice99_primitive_rfind(f->haystack, needle);
+    return Slice99_size(f->haystack);
+}
+
+BENCH(find) {
+    const Slice99 needle = Slice99_advance(f->haystack, (ptrdiff_t)f->haystack.len - 2);
+    sink = (uintptr_t)Slice99_find(f->haystack, needle, bytes_cmp);
+    return Slice99_size(f->haystack);
+}
+
+BENCH(split_iter) {
+    Slice99SplitIter iter = Slice99SplitIter_by_item(f->haystack, Slice99_last(f->haystack));
+    Slice99 piece;
+    while (Slice99SplitIter_next(&iter, &piece)) {
+        sink = piece.len;
+    }
+    return Slice99_size(f->haystack);
+}
+
+BENCH(copy) {
+    Slice99_copy(f->lhs, f->rhs);
+    return Slice99_size(f->lhs);
+}
+
+BENCH(copy_non_overlapping) {
+    Slice99_copy_non_overlapping(f->lhs, f->rhs);
+    return Slice99_size(f->lhs);
+}
+
+BENCH(swap_with_slice) {
+    Slice99_swap_with_slice(f->lhs, f->rhs, f->backup);
+    return Slice99_size(f->lhs);
+}
+
+BENCH(reverse) {
+    Slice99_reverse(f->lhs, f->backup);
+    return Slice99_size(f->lhs);
+}
+
+BENCH(fill) {
+    Slice99_fill(f->lhs, fill_item);
+    return Slice99_size(f->lhs);
+}
+
+// Must follow `fill` to restore the zeros of `lhs`.
+BENCH(memset) {
+    Slice99_memset(f->lhs, 0);
+    return Slice99_size(f->lhs);
+}
+
+// } (Linear-time functions)
+
+#undef BENCH
+
+static const struct {
+    const char *name;
+    BenchFn fn;
+    // The minimum length of a slice required by the function.
+    size_t min_len;
+} benchmarks[] = {
+#define ENTRY(name, min_len) {#name, bench_##name, min_len}
+    ENTRY(new, 1),
+    ENTRY(size, 1),
+    ENTRY(get, 1),
+    ENTRY(first, 1),
+    ENTRY(last, 1),
+    ENTRY(sub, 1),
+    ENTRY(advance, 1),
+    ENTRY(split_at, 1),
+    ENTRY(swap, 2),
+    ENTRY(primitive_eq, 1),
+    ENTRY(eq, 1),
+    ENTRY(primitive_starts_with, 1),
+    ENTRY(starts_with, 1),
+    ENTRY(primitive_ends_with, 1),
+    ENTRY(ends_with, 1),
+    ENTRY(primitive_find_item, 1),
+    ENTRY(primitive_rfind_item, 1),
+    ENTRY(find_item, 1),
+    ENTRY(primitive_find, 2),
+    ENTRY(primitive_rfind, 2),
+    ENTRY(find, 2),
+    ENTRY(split_iter, 1),
+    ENTRY(copy, 1),
+    ENTRY(copy_non_overlapping, 1),
+    ENTRY(swap_with_slice, 1),
+    ENTRY(reverse, 1),
+    ENTRY(fill, 1),
+    ENTRY(memset, 1),
+#undef ENTRY
+};
+
+static const size_t item_sizes[] = {1, 4, 8, 16, 64};
+
+// From 16 B up to 64 MiB, which exceeds the last-level cache of most machines.
+static const size_t sizes[] = {
+    16, 256, 4096, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024, 64 * 1024 * 1024,
+};
+
+static double run(BenchFn fn, const Fixture *f, uint64_t min_ns, size_t *bytes) {
+    for (uint64_t iters = 1;; iters *= 2) {
+        const uint64_t start = now_ns();
+        for (uint64_t i = 0; i < iters; i++) {
+            *bytes = fn(f);
+        }
+        const uint64_t elapsed = now_ns() - start;
+
+        if (elapsed >= min_ns) {
+            return (double)elapsed / (double)iters;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const uint64_t min_ns = (argc > 1 ? strtoull(argv[1], NULL, 10) : 10) * UINT64_C(1000000);
+    const size_t max_size = sizes[SLICE99_ARRAY_LEN(sizes) - 1];
+
+    unsigned char *lhs = malloc(max_size), *rhs = malloc(max_size), *haystack = malloc(max_size),
+                  *backup = malloc(64);
+    if (lhs == NULL || rhs == NULL || haystack == NULL || backup == NULL) {
+        fputs("Failed to allocate the benchmark buffers.\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    // Also faults the pages in, so that the first benchmark does not pay for it.
+    memset(lhs, 0, max_size);
+    memset(rhs, 0, max_size);
+
+    for (size_t i = 0; i < sizeof fill_item; i++) {
+        fill_item[i] = (unsigned char)(i + 1);
+    }
+
+    puts("function,item_size,len,bytes,ns_per_op,gb_per_s");
+
+    for (size_t i = 0; i < SLICE99_ARRAY_LEN(item_sizes); i++) {
+        const size_t item_size = item_sizes[i];
+        cmp_item_size = item_size;
+
+        for (size_t j = 0; j < SLICE99_ARRAY_LEN(sizes); j++) {
+            const size_t len = sizes[j] / item_size;
+            if (len == 0) {
+                continue;
+            }
+
+            const Fixture f = {
+                .lhs = Slice99_new(lhs, item_size, len),
+                .rhs = Slice99_new(rhs, item_size, len),
+                .haystack = Slice99_new(haystack, item_size, len),
+                .backup = backup,
+            };
+
+            memset(haystack, 0, Slice99_size(f.haystack));
+            memset(Slice99_first(f.haystack), 0xEE, item_size);
+            memset(Slice99_last(f.haystack), 0xFF, item_size);
+
+            for (size_t k = 0; k < SLICE99_ARRAY_LEN(benchmarks); k++) {
+                if (len < benchmarks[k].min_len) {
+                    continue;
+                }
+
+                size_t bytes = 0;
+                const double ns_per_op = run(benchmarks[k].fn, &f, min_ns, &bytes);
+
+                printf(
+                    "%s,%zu,%zu,%zu,%.3f,%.3f\n", benchmarks[k].name, item_size, len, bytes,
+                    ns_per_op, (double)bytes / ns_per_op);
+            }
+        }
+    }
+
+    free(lhs);
+    free(rhs);
+    free(haystack);
+    free(backup);
+}
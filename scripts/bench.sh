@@ -0,0 +1,8 @@
+#!/bin/bash
+
+mkdir -p benchmarks/build
+cd benchmarks/build
+cmake ..
+cmake --build .
+./bench "$@"
+cd ../..
@@ -5,3 +5,5 @@ cd tests/build
 cmake ..
 cmake --build .
 ./test
+./test_disable_asserts
+./mmap_c99
@@ -28,11 +28,38 @@ SOFTWARE.
  *
  * Some macros are automatically defined in case they have not been defined before including this
  * header file; these are: #SLICE99_ASSERT, #SLICE99_MEMCMP, #SLICE99_MEMCPY, #SLICE99_MEMMOVE,
- * #SLICE99_STRLEN, #SLICE99_VSPRINTF, #SLICE99_VSNPRINTF, and #SLICE99_SNPRINTF. They represent the
- * corresponding standard library's functions, although actual implementations can differ. If you
- * develop software for a freestanding environment, these macros must be defined beforehand. If you
- * do not want to implement string formatting macros from `stdio.h`, define `SLICE99_DISABLE_STDIO`
- * and Slice99 will not require them from you.
+ * #SLICE99_MEMCHR, #SLICE99_MEMSET, #SLICE99_MEMRCHR, #SLICE99_STRLEN, #SLICE99_VSPRINTF,
+ * #SLICE99_VSNPRINTF, and #SLICE99_SNPRINTF. They represent the corresponding standard library's
+ * functions, although actual implementations can differ. If you develop software for a
+ * freestanding environment, these macros must be defined beforehand, except for #SLICE99_MEMRCHR,
+ * which defaults to a built-in implementation. If you do not want to implement string formatting
+ * macros from `stdio.h`, define `SLICE99_DISABLE_STDIO` and Slice99 will not require them from you.
+ *
+ * Slice99 never allocates memory by itself, except for the functions that explicitly say so. They
+ * use #SLICE99_REALLOC and #SLICE99_FREE, which are defined in the same manner unless
+ * `SLICE99_DISABLE_STDLIB` is defined. In the latter case, #Slice99Arena can only allocate from
+ * the caller-provided buffer.
+ *
+ * Some functions use SSE2 intrinsics when compiling for x86-64 with GCC or Clang (and SSSE3,
+ * SSE4.2, or ARMv8 CRC32 intrinsics when enabled by the compiler flags). Define
+ * `SLICE99_DISABLE_SIMD` to always use the portable code paths.
+ *
+ * Function preconditions are checked with #SLICE99_ASSERT, which is `assert` by default. Define
+ * `SLICE99_DISABLE_ASSERTS` to strip these checks regardless of `NDEBUG`; the checked expressions
+ * are then not evaluated.
+ *
+ * Optional modules that depend on the operating system are enabled by defining the corresponding
+ * macro before including this header file:
+ *
+ *  - `SLICE99_ENABLE_MMAP` enables memory-mapped files (#Slice99_mmap_file) and requires POSIX;
+ * in the strict ISO C modes, `_POSIX_C_SOURCE` must be defined to at least `200112L` before any
+ * `#include`.
+ *  - `SLICE99_ENABLE_PARALLEL` enables parallel operations over large slices
+ * (#Slice99_par_for_each) and requires POSIX threads.
+ *  - `SLICE99_ENABLE_IOVEC` enables building `struct iovec` arrays for vectored I/O
+ * (#Slice99IoVec) and requires POSIX.
+ *  - `SLICE99_ENABLE_STATS` enables per-thread counters of calls and bytes processed by the
+ * copying, comparison, and formatting functions (#Slice99Stats) and requires thread-local storage.
  */
 
 /**
@@ -49,15 +76,20 @@ SOFTWARE.
 #ifndef SLICE99_H
 #define SLICE99_H
 
+#include <float.h>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #ifndef SLICE99_ASSERT
+#ifdef SLICE99_DISABLE_ASSERTS
+#define SLICE99_ASSERT(expr) ((void)sizeof((expr) ? 1 : 0))
+#else
 #include <assert.h>
-/// Like `assert`.
+/// Like `assert`. Evaluates to nothing if `SLICE99_DISABLE_ASSERTS` is defined.
 #define SLICE99_ASSERT assert
+#endif // SLICE99_DISABLE_ASSERTS
 #endif // SLICE99_ASSERT
 
 #ifndef SLICE99_MEMCMP
@@ -78,12 +110,54 @@ SOFTWARE.
 #define SLICE99_MEMMOVE memmove
 #endif
 
+#ifndef SLICE99_MEMCHR
+#include <string.h>
+/// Like `memchr`.
+#define SLICE99_MEMCHR memchr
+#endif
+
+#ifndef SLICE99_MEMSET
+#include <string.h>
+/// Like `memset`.
+#define SLICE99_MEMSET memset
+#endif
+
+#ifndef SLICE99_MEMRCHR
+/// Like the GNU `memrchr`. Defaults to a built-in implementation.
+#define SLICE99_MEMRCHR slice99_priv_memrchr
+#endif
+
 #ifndef SLICE99_STRLEN
 #include <string.h>
 /// Like `strlen`.
 #define SLICE99_STRLEN strlen
 #endif
 
+#ifndef SLICE99_DISABLE_STDLIB
+
+#ifndef SLICE99_REALLOC
+#include <stdlib.h>
+/// Like `realloc`. Defined only if it has not been defined previously **and**
+/// `SLICE99_DISABLE_STDLIB` is **not** defined.
+#define SLICE99_REALLOC realloc
+#endif
+
+#ifndef SLICE99_FREE
+#include <stdlib.h>
+/// Like `free`. Defined only if it has not been defined previously **and**
+/// `SLICE99_DISABLE_STDLIB` is **not** defined.
+#define SLICE99_FREE free
+#endif
+
+#ifndef SLICE99_STRTOD
+#include <stdlib.h>
+/// Like `strtod`. Defined only if it has not been defined previously **and**
+/// `SLICE99_DISABLE_STDLIB` is **not** defined.
+#define SLICE99_STRTOD strtod
+#endif
+
+#endif // SLICE99_DISABLE_STDLIB
+
 #ifndef DOXYGEN_IGNORE
 
 #ifdef __GNUC__
@@ -109,6 +183,32 @@ SOFTWARE.
 
 #endif
 
+#if defined(__GNUC__) && defined(__SSE2__) && !defined(SLICE99_DISABLE_SIMD)
+#include <emmintrin.h>
+#define SLICE99_PRIV_SSE2
+#endif
+
+#if defined(__GNUC__) && defined(__SSSE3__) && !defined(SLICE99_DISABLE_SIMD)
+#include <tmmintrin.h>
+#define SLICE99_PRIV_SSSE3
+#endif
+
+#if defined(__GNUC__) && defined(__SSE4_2__) && defined(__x86_64__) &&                             \
+    !defined(SLICE99_DISABLE_SIMD)
+#include <nmmintrin.h>
+#define SLICE99_PRIV_SSE42
+#endif
+
+#if defined(__GNUC__) && defined(__ARM_FEATURE_CRC32) && !defined(SLICE99_DISABLE_SIMD)
+#include <arm_acle.h>
+#define SLICE99_PRIV_ARM_CRC32
+#endif
+
+// The GNU `__atomic` built-ins, provided by GCC 4.7+ and Clang.
+#if defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+#define SLICE99_PRIV_ATOMICS
+#endif
+
 #endif // DOXYGEN_IGNORE
 
 /**
@@ -148,6 +248,19 @@ SOFTWARE.
  * #Slice99_from_ptrdiff).
  *  - All function preconditions, invariants, and postconditions remain the same.
  *
+ * The exception is `name_swap`, `name_swap_with_slice`, and `name_reverse`: they swap items by
+ * assigning `T` directly, so their `backup` parameters are ignored and can be `NULL`.
+ * Also, `name_align_to` writes its body as #Slice99, since the item size of the body is given at
+ * run time.
+ *
+ * The constant-time functions (`name_new`, `name_from_ptrdiff`, `name_update_len`, `name_is_empty`,
+ * `name_size`, `name_get`, `name_first`, `name_last`, `name_sub`, `name_advance`, and
+ * `name_split_at`) are implemented with `T *` arithmetic instead of converting to #Slice99, so
+ * `sizeof(T)` is a compile-time constant and no run-time multiplication by the item size remains.
+ *
+ * #Slice99SplitIter is specialised as `nameSplitIter` in the same manner. The functions of the
+ * optional modules (such as #Slice99_mmap_file and #Slice99_par_for_each) are not specialised.
+ *
  * #Slice99_from_str and #Slice99_c_str are derived only for `CharSlice99`.
  *
  * # Examples
@@ -179,14 +292,19 @@ SOFTWARE.
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT name name##_new(                \
         T *ptr, size_t len) {                                                                      \
-        const Slice99 result = Slice99_new((void *)ptr, sizeof(T), len);                           \
-        return (name)SLICE99_TO_TYPED(result);                                                     \
+        SLICE99_ASSERT(ptr);                                                                       \
+                                                                                                   \
+        const name result = {.ptr = ptr, .len = len};                                              \
+        return result;                                                                             \
     }                                                                                              \
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT name name##_from_ptrdiff(       \
         T *start, T *end) {                                                                        \
-        const Slice99 result = Slice99_from_ptrdiff((void *)start, (void *)end, sizeof(T));        \
-        return (name)SLICE99_TO_TYPED(result);                                                     \
+        SLICE99_ASSERT(start);                                                                     \
+        SLICE99_ASSERT(end);                                                                       \
+        SLICE99_ASSERT(end >= start);                                                              \
+                                                                                                   \
+        return name##_new(start, (size_t)(end - start));                                           \
     }                                                                                              \
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT name name##_empty(void) {       \
@@ -196,45 +314,44 @@ SOFTWARE.
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT name name##_update_len(         \
         name self, size_t new_len) {                                                               \
-        const Slice99 result = Slice99_update_len(SLICE99_TO_UNTYPED(self), new_len);              \
-        return (name)SLICE99_TO_TYPED(result);                                                     \
+        return name##_new(self.ptr, new_len);                                                      \
     }                                                                                              \
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT                                 \
         SLICE99_CONST bool name##_is_empty(name self) {                                            \
-        return Slice99_is_empty(SLICE99_TO_UNTYPED(self));                                         \
+        return self.len == 0;                                                                      \
     }                                                                                              \
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT SLICE99_CONST size_t            \
         name##_size(name self) {                                                                   \
-        return Slice99_size(SLICE99_TO_UNTYPED(self));                                             \
+        return sizeof(T) * self.len;                                                               \
     }                                                                                              \
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT SLICE99_CONST T *name##_get(    \
         name self, ptrdiff_t i) {                                                                  \
-        return (T *)Slice99_get(SLICE99_TO_UNTYPED(self), i);                                      \
+        return self.ptr + i;                                                                       \
     }                                                                                              \
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT SLICE99_CONST T *name##_first(  \
         name self) {                                                                               \
-        return (T *)Slice99_first(SLICE99_TO_UNTYPED(self));                                       \
+        return self.ptr;                                                                           \
     }                                                                                              \
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT SLICE99_CONST T *name##_last(   \
         name self) {                                                                               \
-        return (T *)Slice99_last(SLICE99_TO_UNTYPED(self));                                        \
+        return self.ptr + ((ptrdiff_t)self.len - 1);                                               \
     }                                                                                              \
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT name name##_sub(                \
         name self, ptrdiff_t start_idx, ptrdiff_t end_idx) {                                       \
-        const Slice99 result = Slice99_sub(SLICE99_TO_UNTYPED(self), start_idx, end_idx);          \
-        return (name)SLICE99_TO_TYPED(result);                                                     \
+        SLICE99_ASSERT(start_idx <= end_idx);                                                      \
+                                                                                                   \
+        return name##_new(self.ptr + start_idx, (size_t)(end_idx - start_idx));                    \
     }                                                                                              \
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT name name##_advance(            \
         name self, ptrdiff_t offset) {                                                             \
-        const Slice99 result = Slice99_advance(SLICE99_TO_UNTYPED(self), offset);                  \
-        return (name)SLICE99_TO_TYPED(result);                                                     \
+        return name##_sub(self, offset, (ptrdiff_t)self.len);                                      \
     }                                                                                              \
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT bool name##_primitive_eq(       \
@@ -274,6 +391,40 @@ SOFTWARE.
             (int (*)(const void *, const void *))cmp);                                             \
     }                                                                                              \
                                                                                                    \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT ptrdiff_t                       \
+        name##_primitive_find_item(name self, const T *item) {                                     \
+        return Slice99_primitive_find_item(SLICE99_TO_UNTYPED(self), (const void *)item);          \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT ptrdiff_t                       \
+        name##_primitive_rfind_item(name self, const T *item) {                                    \
+        return Slice99_primitive_rfind_item(SLICE99_TO_UNTYPED(self), (const void *)item);         \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT ptrdiff_t                       \
+        name##_primitive_find(name self, name needle) {                                            \
+        return Slice99_primitive_find(SLICE99_TO_UNTYPED(self), SLICE99_TO_UNTYPED(needle));       \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT ptrdiff_t                       \
+        name##_primitive_rfind(name self, name needle) {                                           \
+        return Slice99_primitive_rfind(SLICE99_TO_UNTYPED(self), SLICE99_TO_UNTYPED(needle));      \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT ptrdiff_t name##_find_item(     \
+        name self, const T *item, int (*cmp)(const T *, const T *)) {                              \
+        return Slice99_find_item(                                                                  \
+            SLICE99_TO_UNTYPED(self), (const void *)item,                                          \
+            (int (*)(const void *, const void *))cmp);                                             \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT ptrdiff_t name##_find(          \
+        name self, name needle, int (*cmp)(const T *, const T *)) {                                \
+        return Slice99_find(                                                                       \
+            SLICE99_TO_UNTYPED(self), SLICE99_TO_UNTYPED(needle),                                  \
+            (int (*)(const void *, const void *))cmp);                                             \
+    }                                                                                              \
+                                                                                                   \
     inline static SLICE99_ALWAYS_INLINE void name##_copy(name self, name other) {                  \
         Slice99_copy(SLICE99_TO_UNTYPED(self), SLICE99_TO_UNTYPED(other));                         \
     }                                                                                              \
@@ -282,692 +433,9755 @@ SOFTWARE.
         Slice99_copy_non_overlapping(SLICE99_TO_UNTYPED(self), SLICE99_TO_UNTYPED(other));         \
     }                                                                                              \
                                                                                                    \
+    inline static SLICE99_ALWAYS_INLINE void name##_fill(name self, const T *item) {               \
+        Slice99_fill(SLICE99_TO_UNTYPED(self), item);                                              \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE void name##_memset(name self, unsigned char byte) {        \
+        Slice99_memset(SLICE99_TO_UNTYPED(self), byte);                                            \
+    }                                                                                              \
+                                                                                                   \
     inline static SLICE99_ALWAYS_INLINE void name##_swap(                                          \
         name self, ptrdiff_t lhs, ptrdiff_t rhs, T *restrict backup) {                             \
-        Slice99_swap(SLICE99_TO_UNTYPED(self), lhs, rhs, (void *restrict)backup);                  \
+        (void)backup;                                                                              \
+        const T tmp = self.ptr[lhs];                                                               \
+        self.ptr[lhs] = self.ptr[rhs];                                                             \
+        self.ptr[rhs] = tmp;                                                                       \
     }                                                                                              \
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE void name##_swap_with_slice(                               \
         name self, name other, T *restrict backup) {                                               \
-        Slice99_swap_with_slice(                                                                   \
-            SLICE99_TO_UNTYPED(self), SLICE99_TO_UNTYPED(other), (void *restrict)backup);          \
+        SLICE99_ASSERT(self.len == other.len);                                                     \
+        (void)backup;                                                                              \
+                                                                                                   \
+        T *restrict lhs = self.ptr, *restrict rhs = other.ptr;                                     \
+        for (size_t i = 0; i < self.len; i++) {                                                    \
+            const T tmp = lhs[i];                                                                  \
+            lhs[i] = rhs[i];                                                                       \
+            rhs[i] = tmp;                                                                          \
+        }                                                                                          \
     }                                                                                              \
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE void name##_reverse(name self, T *restrict backup) {       \
-        Slice99_reverse(SLICE99_TO_UNTYPED(self), (void *restrict)backup);                         \
+        (void)backup;                                                                              \
+                                                                                                   \
+        if (sizeof(T) <= 2) {                                                                      \
+            unsigned char tmp[2];                                                                  \
+            Slice99_reverse(SLICE99_TO_UNTYPED(self), tmp);                                        \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        for (size_t i = 0, j = self.len - 1; i < self.len / 2; i++, j--) {                         \
+            const T tmp = self.ptr[i];                                                             \
+            self.ptr[i] = self.ptr[j];                                                             \
+            self.ptr[j] = tmp;                                                                     \
+        }                                                                                          \
     }                                                                                              \
                                                                                                    \
     inline static SLICE99_ALWAYS_INLINE void name##_split_at(                                      \
         name self, size_t i, name *restrict lhs, name *restrict rhs) {                             \
+        SLICE99_ASSERT(i <= self.len);                                                             \
         SLICE99_ASSERT(lhs);                                                                       \
         SLICE99_ASSERT(rhs);                                                                       \
                                                                                                    \
-        Slice99 lhs_untyped = SLICE99_TO_UNTYPED(*lhs), rhs_untyped = SLICE99_TO_UNTYPED(*rhs);    \
+        *lhs = name##_new(self.ptr, i);                                                            \
+        *rhs = name##_new(self.ptr + i, self.len - i);                                             \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE void name##_align_to(                                      \
+        name self, size_t align, size_t item_size, name *restrict head, Slice99 *restrict body,    \
+        name *restrict tail) {                                                                     \
+        Slice99 head_untyped, tail_untyped;                                                        \
+        Slice99_align_to(                                                                          \
+            SLICE99_TO_UNTYPED(self), align, item_size, &head_untyped, body, &tail_untyped);       \
+        *head = (name)SLICE99_TO_TYPED(head_untyped);                                              \
+        *tail = (name)SLICE99_TO_TYPED(tail_untyped);                                              \
+    }                                                                                              \
+                                                                                                   \
+    typedef struct {                                                                               \
+        Slice99SplitIter inner;                                                                    \
+    } name##SplitIter;                                                                             \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT name##SplitIter                 \
+        name##SplitIter_by_item(name self, const T *item) {                                        \
+        const name##SplitIter iter = {                                                             \
+            Slice99SplitIter_by_item(SLICE99_TO_UNTYPED(self), (const void *)item)};               \
+        return iter;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT name##SplitIter                 \
+        name##SplitIter_by_slice(name self, name delimiter) {                                      \
+        const name##SplitIter iter = {                                                             \
+            Slice99SplitIter_by_slice(SLICE99_TO_UNTYPED(self), SLICE99_TO_UNTYPED(delimiter))};   \
+        return iter;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT name##SplitIter                 \
+        name##SplitIter_by_any(name self, name set) {                                              \
+        const name##SplitIter iter = {                                                             \
+            Slice99SplitIter_by_any(SLICE99_TO_UNTYPED(self), SLICE99_TO_UNTYPED(set))};           \
+        return iter;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT bool name##SplitIter_next(      \
+        name##SplitIter *restrict self, name *restrict out) {                                      \
+        SLICE99_ASSERT(out);                                                                       \
+                                                                                                   \
+        Slice99 result;                                                                            \
+        if (!Slice99SplitIter_next(&self->inner, &result)) {                                       \
+            return false;                                                                          \
+        }                                                                                          \
+                                                                                                   \
+        *out = (name)SLICE99_TO_TYPED(result);                                                     \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE void name##_sort(                                          \
+        name self, int (*cmp)(const T *, const T *), T *restrict backup) {                         \
+        Slice99_sort(                                                                              \
+            SLICE99_TO_UNTYPED(self), (int (*)(const void *, const void *))cmp, (void *)backup);   \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT size_t name##_lower_bound(      \
+        name self, const T *key, int (*cmp)(const T *, const T *)) {                               \
+        return Slice99_lower_bound(                                                                \
+            SLICE99_TO_UNTYPED(self), (const void *)key,                                           \
+            (int (*)(const void *, const void *))cmp);                                             \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT size_t name##_upper_bound(      \
+        name self, const T *key, int (*cmp)(const T *, const T *)) {                               \
+        return Slice99_upper_bound(                                                                \
+            SLICE99_TO_UNTYPED(self), (const void *)key,                                           \
+            (int (*)(const void *, const void *))cmp);                                             \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT ptrdiff_t name##_bsearch(       \
+        name self, const T *key, int (*cmp)(const T *, const T *)) {                               \
+        return Slice99_bsearch(                                                                    \
+            SLICE99_TO_UNTYPED(self), (const void *)key,                                           \
+            (int (*)(const void *, const void *))cmp);                                             \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT uint64_t                        \
+        name##_primitive_hash(name self, uint64_t seed) {                                          \
+        return Slice99_primitive_hash(SLICE99_TO_UNTYPED(self), seed);                             \
+    }                                                                                              \
                                                                                                    \
-        Slice99_split_at(SLICE99_TO_UNTYPED(self), i, &lhs_untyped, &rhs_untyped);                 \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT uint32_t name##_crc32c(         \
+        name self, uint32_t crc) {                                                                 \
+        return Slice99_crc32c(SLICE99_TO_UNTYPED(self), crc);                                      \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT bool name##_arena_dup(          \
+        name self, Slice99Arena *restrict arena, name *restrict out) {                             \
+        SLICE99_ASSERT(out);                                                                       \
                                                                                                    \
-        *lhs = (name)SLICE99_TO_TYPED(lhs_untyped);                                                \
-        *rhs = (name)SLICE99_TO_TYPED(rhs_untyped);                                                \
+        Slice99 result;                                                                            \
+        if (!Slice99_arena_dup(SLICE99_TO_UNTYPED(self), arena, &result)) {                        \
+            return false;                                                                          \
+        }                                                                                          \
+                                                                                                   \
+        *out = (name)SLICE99_TO_TYPED(result);                                                     \
+        return true;                                                                               \
     }                                                                                              \
                                                                                                    \
     struct slice99_priv_trailing_comma
 
 /**
- * Converts #Slice99 to a typed representation.
+ * The number of bytes compared by #SLICE99_DEF_TYPED_EQ-generated functions before checking for a
+ * mismatch.
  *
- * @pre @p self must be an expression of type #Slice99.
+ * Defaults to 32 if not defined before including this header file.
+ */
+#ifndef SLICE99_EQ_CHUNK_SIZE
+#define SLICE99_EQ_CHUNK_SIZE 32
+#endif
+
+/**
+ * Defines equality functions for the typed slice @p name with the comparator @p cmp inlined.
+ *
+ * This macro defines `name_eq_inline`, `name_starts_with_inline`, and `name_ends_with_inline`,
+ * which are the same as `name_eq`, `name_starts_with`, and `name_ends_with` generated by
+ * #SLICE99_DEF_TYPED, except that they do not accept a comparator: @p cmp is invoked directly, so
+ * the compiler is free to inline, unroll, and vectorise it.
+ *
+ * Items are compared in chunks of #SLICE99_EQ_CHUNK_SIZE bytes: within a chunk, all the
+ * comparisons are performed unconditionally and their results are combined; the functions return
+ * as soon as a chunk with a mismatch is found.
+ *
+ * @param[in] name The name of a typed slice previously defined by #SLICE99_DEF_TYPED.
+ * @param[in] T The item type of @p name.
+ * @param[in] cmp A function or a function-like macro accepting two `const T *` and returning 0 if
+ * the items are equal, any other value otherwise.
  *
  * # Examples
  *
  * @code
  * #include <slice99.h>
  *
+ * typedef struct {
+ *     int x, y;
+ * } Point;
+ *
+ * SLICE99_DEF_TYPED(MyPoints, Point);
+ *
+ * #define POINT_CMP(lhs, rhs) ((lhs)->x != (rhs)->x || (lhs)->y != (rhs)->y)
+ *
+ * SLICE99_DEF_TYPED_EQ(MyPoints, Point, POINT_CMP);
+ *
  * int main(void) {
- *     Slice99 x = Slice99_from_str("abc");
- *     CharSlice99 y = (CharSlice99)SLICE99_TO_TYPED(x);
- *     (void)y;
+ *     MyPoints points = (MyPoints)Slice99_typed_from_array((Point[]){{1, 2}, {3, 4}});
+ *     bool eq = MyPoints_eq_inline(points, points);
  * }
  * @endcode
  */
-#define SLICE99_TO_TYPED(self)                                                                     \
-    { .ptr = (self).ptr, .len = (self).len }
+#define SLICE99_DEF_TYPED_EQ(name, T, cmp)                                                         \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT bool name##_eq_inline(          \
+        name lhs, name rhs) {                                                                      \
+        if (lhs.len != rhs.len) {                                                                  \
+            return false;                                                                          \
+        }                                                                                          \
+                                                                                                   \
+        const size_t chunk = sizeof(T) < SLICE99_EQ_CHUNK_SIZE ? SLICE99_EQ_CHUNK_SIZE / sizeof(T) \
+                                                               : 1;                                \
+        size_t i = 0;                                                                              \
+                                                                                                   \
+        for (; i + chunk <= lhs.len; i += chunk) {                                                 \
+            bool mismatch = false;                                                                 \
+            for (size_t j = i; j < i + chunk; j++) {                                               \
+                mismatch |= cmp((const T *)&lhs.ptr[j], (const T *)&rhs.ptr[j]) != 0;              \
+            }                                                                                      \
+            if (mismatch) {                                                                        \
+                return false;                                                                      \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        for (; i < lhs.len; i++) {                                                                 \
+            if (cmp((const T *)&lhs.ptr[i], (const T *)&rhs.ptr[i]) != 0) {                        \
+                return false;                                                                      \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT bool                            \
+        name##_starts_with_inline(name self, name prefix) {                                        \
+        return self.len < prefix.len                                                               \
+                   ? false                                                                         \
+                   : name##_eq_inline(name##_sub(self, 0, (ptrdiff_t)prefix.len), prefix);         \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT bool name##_ends_with_inline(   \
+        name self, name postfix) {                                                                 \
+        return self.len < postfix.len                                                              \
+                   ? false                                                                         \
+                   : name##_eq_inline(                                                             \
+                         name##_sub(                                                               \
+                             self, (ptrdiff_t)self.len - (ptrdiff_t)postfix.len,                   \
+                             (ptrdiff_t)self.len),                                                 \
+                         postfix);                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    struct slice99_priv_trailing_comma
+
+#ifndef SLICE99_DISABLE_STDLIB
 
 /**
- * Converts the typed slice @p self to #Slice99.
+ * Defines the growable array `nameVec` whose items can be viewed as the typed slice @p name.
  *
- * @pre @p self must be an expression of type defined by #SLICE99_DEF_TYPED.
+ * This macro defines
+ *
+ * @code
+ * typedef struct {
+ *     T *ptr;
+ *     size_t len;
+ *     size_t cap;
+ * } nameVec;
+ * @endcode
+ *
+ * where `ptr` points to `cap` allocated items, of which the first `len` are initialised. An empty
+ * vector obtained with `nameVec_new` does not allocate.
+ *
+ * Memory is managed with #SLICE99_REALLOC and #SLICE99_FREE. When a vector runs out of capacity,
+ * it grows geometrically (see #Slice99_grow_capacity), so that pushing items one by one takes
+ * amortised O(1) time. The functions that allocate return `false` on allocation failure, in which
+ * case the vector is left unchanged.
+ *
+ * The following functions are generated:
+ *
+ *  - `nameVec nameVec_new(void)` constructs an empty vector.
+ *  - `void nameVec_free(nameVec *self)` releases the memory of `self` and makes it empty.
+ *  - `void nameVec_clear(nameVec *self)` sets the length of `self` to 0, retaining its capacity.
+ *  - `bool nameVec_reserve(nameVec *self, size_t additional)` ensures that `self` can hold
+ * `additional` more items without reallocating.
+ *  - `bool nameVec_push(nameVec *self, T item)` appends `item` to `self`.
+ *  - `bool nameVec_extend_from_slice(nameVec *self, name other)` appends the items of `other` to
+ * `self`; `other` must not point into `self`.
+ *  - `bool nameVec_shrink_to_fit(nameVec *self)` reallocates `self` so that its capacity equals its
+ * length.
+ *  - `name nameVec_as_slice(nameVec self)` returns the initialised items of `self` as a slice.
+ *
+ * Defined only if `SLICE99_DISABLE_STDLIB` is **not** defined.
  *
  * # Examples
  *
  * @code
  * #include <slice99.h>
  *
+ * SLICE99_DEF_VEC(IntSlice99, int);
+ *
  * int main(void) {
- *     CharSlice99 x = CharSlice99_from_str("abc");
- *     Slice99 y = SLICE99_TO_UNTYPED(x);
- *     (void)y;
+ *     IntSlice99Vec vec = IntSlice99Vec_new();
+ *
+ *     for (int i = 0; i < 100; i++) {
+ *         if (!IntSlice99Vec_push(&vec, i)) {
+ *             // Handle the allocation failure...
+ *         }
+ *     }
+ *
+ *     IntSlice99 items = IntSlice99Vec_as_slice(vec);
+ *     (void)items;
+ *
+ *     IntSlice99Vec_free(&vec);
  * }
  * @endcode
  */
-#define SLICE99_TO_UNTYPED(self) Slice99_new((self).ptr, sizeof(*(self).ptr), (self).len)
-
-/**
- * Computes a number of items in an array expression.
- */
-#define SLICE99_ARRAY_LEN(...) (sizeof(__VA_ARGS__) / sizeof((__VA_ARGS__)[0]))
+#define SLICE99_DEF_VEC(name, T)                                                                   \
+    typedef struct {                                                                               \
+        T *ptr;                                                                                    \
+        size_t len;                                                                                \
+        size_t cap;                                                                                \
+    } name##Vec;                                                                                   \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT name##Vec name##Vec_new(void) { \
+        const name##Vec result = {.ptr = NULL, .len = 0, .cap = 0};                                \
+        return result;                                                                             \
+    }                                                                                              \
+                                                                                                   \
+    inline static void name##Vec_free(name##Vec *self) {                                           \
+        SLICE99_ASSERT(self);                                                                      \
+                                                                                                   \
+        SLICE99_FREE(self->ptr);                                                                   \
+        *self = name##Vec_new();                                                                   \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE void name##Vec_clear(name##Vec *self) {                    \
+        SLICE99_ASSERT(self);                                                                      \
+        self->len = 0;                                                                             \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_WARN_UNUSED_RESULT bool name##Vec_priv_realloc(                          \
+        name##Vec *self, size_t new_cap) {                                                         \
+        if (new_cap > SIZE_MAX / sizeof(T)) {                                                      \
+            return false;                                                                          \
+        }                                                                                          \
+                                                                                                   \
+        T *new_ptr = (T *)SLICE99_REALLOC(self->ptr, new_cap * sizeof(T));                         \
+        if (new_ptr == NULL) {                                                                     \
+            return false;                                                                          \
+        }                                                                                          \
+                                                                                                   \
+        self->ptr = new_ptr;                                                                       \
+        self->cap = new_cap;                                                                       \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT bool name##Vec_reserve(         \
+        name##Vec *self, size_t additional) {                                                      \
+        SLICE99_ASSERT(self);                                                                      \
+                                                                                                   \
+        if (additional <= self->cap - self->len) {                                                 \
+            return true;                                                                           \
+        }                                                                                          \
+        if (additional > SIZE_MAX - self->len) {                                                   \
+            return false;                                                                          \
+        }                                                                                          \
+                                                                                                   \
+        return name##Vec_priv_realloc(                                                             \
+            self, Slice99_grow_capacity(self->cap, self->len + additional, sizeof(T)));            \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT bool name##Vec_push(            \
+        name##Vec *self, T item) {                                                                 \
+        if (!name##Vec_reserve(self, 1)) {                                                         \
+            return false;                                                                          \
+        }                                                                                          \
+                                                                                                   \
+        self->ptr[self->len++] = item;                                                             \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT bool                            \
+        name##Vec_extend_from_slice(name##Vec *self, name other) {                                 \
+        if (!name##Vec_reserve(self, other.len)) {                                                 \
+            return false;                                                                          \
+        }                                                                                          \
+                                                                                                   \
+        SLICE99_MEMCPY(self->ptr + self->len, other.ptr, other.len * sizeof(T));                   \
+        self->len += other.len;                                                                    \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_WARN_UNUSED_RESULT bool name##Vec_shrink_to_fit(name##Vec *self) {       \
+        SLICE99_ASSERT(self);                                                                      \
+                                                                                                   \
+        if (self->len == self->cap) {                                                              \
+            return true;                                                                           \
+        }                                                                                          \
+        if (self->len == 0) {                                                                      \
+            name##Vec_free(self);                                                                  \
+            return true;                                                                           \
+        }                                                                                          \
+                                                                                                   \
+        return name##Vec_priv_realloc(self, self->len);                                            \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT name name##Vec_as_slice(        \
+        name##Vec self) {                                                                          \
+        return self.ptr == NULL ? name##_empty() : name##_new(self.ptr, self.len);                 \
+    }                                                                                              \
+                                                                                                   \
+    struct slice99_priv_trailing_comma
 
 /**
- * Copies @p obj to @p buffer, returning the next position of @p buffer to write to.
- *
- * This macro is no different from `memcpy` except for the return value. It is useful when you
- * want to write a sequence of objects to some memory buffer, e.g., to a packet header:
- *
- * @code
- * const uint16_t x = 123;
- * const uint32_t y = 456;
- *
- * header = SLICE99_APPEND(header, x);
- * header = SLICE99_APPEND(header, y);
- * // ...
- * @endcode
+ * Computes the capacity of a growable array that must hold at least @p required items.
  *
- * @param[out] buffer The memory area to write to.
- * @param[in] obj The object (lvalue) that will be copied to @p buffer, byte-by-byte.
+ * This is the growth policy of #SLICE99_DEF_VEC-generated vectors, exposed for custom containers.
+ * The capacity grows by a factor of 1.5, which allows a reallocated block to be reused after a few
+ * growth steps, and the first allocation holds at least 64 bytes.
  *
- * @return `(void *)((char *)buffer + sizeof(obj))`
+ * @param[in] cap The current capacity, in items.
+ * @param[in] required The minimum number of items the new capacity must hold.
+ * @param[in] item_size The size of each item.
  *
- * @pre @p buffer must be capable of holding at least `sizeof(obj)` bytes.
- * @pre @p buffer and @p obj must be non-overlapping.
+ * @return The new capacity, in items, which is at least @p required.
  *
- * @see #SLICE99_APPEND_ARRAY
+ * @pre `item_size > 0`
  */
-#define SLICE99_APPEND(buffer, obj)                                                                \
-    ((void *)((char *)SLICE99_MEMCPY((buffer), &(obj), sizeof(obj)) + sizeof(obj)))
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST size_t
+Slice99_grow_capacity(size_t cap, size_t required, size_t item_size) {
+    const size_t min_cap = 64 / item_size > 0 ? 64 / item_size : 1;
 
-/**
- * Copies the array of length @p len accessible through @p ptr into @p buffer, returning the next
- * position of @p buffer to write to.
- *
- * This function has the same requirements and a return value as of #SLICE99_APPEND.
- */
-#define SLICE99_APPEND_ARRAY(buffer, ptr, len)                                                     \
-    /* clang-format off */ \
-    ((void *)((char *)SLICE99_MEMCPY((buffer), (ptr), sizeof((ptr)[0]) * (len)) + \
-              sizeof((ptr)[0]) * (len))) /* clang-format on */
+    size_t new_cap = cap <= SIZE_MAX - cap / 2 ? cap + cap / 2 : SIZE_MAX;
+    if (new_cap < min_cap) {
+        new_cap = min_cap;
+    }
 
-#ifdef UINT8_MAX
+    return new_cap < required ? required : new_cap;
+}
+
+#endif // SLICE99_DISABLE_STDLIB
 
 /**
- * Constructs `U8Slice99` from @p obj.
+ * Defines sorting and binary search functions for the typed slice @p name with an inlined
+ * comparator.
  *
- * @param[in] obj The object (lvalue) to which the resulting slice will point to.
+ * This macro defines
  *
- * @return An octet slice pointing to @p obj of length `sizeof(obj)`.
- */
-#define SLICE99_TO_OCTETS(obj) U8Slice99_new((uint8_t *)&(obj), sizeof(obj))
-
-#endif
-
-/**
- * Constructs a slice from an array expression.
+ *  - `void name_sort_inline(name self)` (see #Slice99_sort),
+ *  - `size_t name_lower_bound_inline(name self, const T *key)` (see #Slice99_lower_bound),
+ *  - `size_t name_upper_bound_inline(name self, const T *key)` (see #Slice99_upper_bound),
+ *  - `ptrdiff_t name_bsearch_inline(name self, const T *key)` (see #Slice99_bsearch),
  *
- * The resulting slice will have #Slice99.len equal to the number of items in the array, and
- * #Slice99.item_size equal to the size of each item.
- */
-#define Slice99_from_array(...)                                                                    \
-    Slice99_new((void *)(__VA_ARGS__), sizeof((__VA_ARGS__)[0]), SLICE99_ARRAY_LEN(__VA_ARGS__))
-
-/**
- * The same as #Slice99_from_array but for typed slices.
+ * which behave like their untyped counterparts but invoke @p cmp directly instead of through a
+ * function pointer, and move items with `T` assignments, letting the compiler optimise the whole
+ * algorithm for `T`.
+ *
+ * @p cmp is a function or a function-like macro taking two `const T *` and returning a negative
+ * integer, zero, or a positive integer if the first item is less than, equal to, or greater than
+ * the second one, respectively.
  *
  * # Examples
  *
  * @code
  * #include <slice99.h>
  *
+ * #define INT_CMP(lhs, rhs) ((*(lhs) > *(rhs)) - (*(lhs) < *(rhs)))
+ *
+ * SLICE99_DEF_TYPED_SORT(IntSlice99, int, INT_CMP);
+ *
  * int main(void) {
- *     IntSlice99 x = (IntSlice99)Slice99_typed_from_array((int[]){1, 2, 3});
- *     (void)x;
+ *     IntSlice99 ints = (IntSlice99)Slice99_typed_from_array((int[]){3, 1, 2});
+ *
+ *     IntSlice99_sort_inline(ints);
+ *     assert(IntSlice99_bsearch_inline(ints, &(int){2}) == 1);
  * }
  * @endcode
  */
-#define Slice99_typed_from_array(...)                                                              \
-    { .ptr = (__VA_ARGS__), .len = SLICE99_ARRAY_LEN(__VA_ARGS__) }
-
-/**
- * Constructs a slice from a pointer of a non-`void` type and a length.
+#define SLICE99_DEF_TYPED_SORT(name, T, cmp)                                                       \
+    inline static SLICE99_ALWAYS_INLINE void name##_priv_sort_swap(T *lhs, T *rhs) {               \
+        const T tmp = *lhs;                                                                        \
+        *lhs = *rhs;                                                                               \
+        *rhs = tmp;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    inline static void name##_priv_insertion_sort(T *ptr, size_t len) {                            \
+        for (size_t i = 1; i < len; i++) {                                                         \
+            const T item = ptr[i];                                                                 \
+            size_t j = i;                                                                          \
+            for (; j > 0 && cmp(&item, &ptr[j - 1]) < 0; j--) {                                    \
+                ptr[j] = ptr[j - 1];                                                               \
+            }                                                                                      \
+            ptr[j] = item;                                                                         \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    inline static void name##_priv_sift_down(T *ptr, size_t root, size_t len) {                    \
+        for (size_t child; (child = 2 * root + 1) < len; root = child) {                           \
+            if (child + 1 < len && cmp(&ptr[child], &ptr[child + 1]) < 0) {                        \
+                child++;                                                                           \
+            }                                                                                      \
+            if (cmp(&ptr[root], &ptr[child]) >= 0) {                                               \
+                break;                                                                             \
+            }                                                                                      \
+            name##_priv_sort_swap(&ptr[root], &ptr[child]);                                        \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    inline static void name##_priv_heap_sort(T *ptr, size_t len) {                                 \
+        for (size_t i = len / 2; i > 0; i--) {                                                     \
+            name##_priv_sift_down(ptr, i - 1, len);                                                \
+        }                                                                                          \
+        for (size_t i = len; i > 1; i--) {                                                         \
+            name##_priv_sort_swap(&ptr[0], &ptr[i - 1]);                                           \
+            name##_priv_sift_down(ptr, 0, i - 1);                                                  \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_WARN_UNUSED_RESULT size_t name##_priv_partition(T *ptr, size_t len) {    \
+        const size_t mid = len / 2, last = len - 1;                                                \
+                                                                                                   \
+        if (cmp(&ptr[mid], &ptr[0]) < 0) {                                                         \
+            name##_priv_sort_swap(&ptr[mid], &ptr[0]);                                             \
+        }                                                                                          \
+        if (cmp(&ptr[last], &ptr[mid]) < 0) {                                                      \
+            name##_priv_sort_swap(&ptr[last], &ptr[mid]);                                          \
+            if (cmp(&ptr[mid], &ptr[0]) < 0) {                                                     \
+                name##_priv_sort_swap(&ptr[mid], &ptr[0]);                                         \
+            }                                                                                      \
+        }                                                                                          \
+        name##_priv_sort_swap(&ptr[0], &ptr[mid]);                                                 \
+                                                                                                   \
+        size_t i = 1, j = last;                                                                    \
+        for (;;) {                                                                                 \
+            while (i <= j && cmp(&ptr[i], &ptr[0]) < 0) {                                          \
+                i++;                                                                               \
+            }                                                                                      \
+            while (i <= j && cmp(&ptr[j], &ptr[0]) > 0) {                                          \
+                j--;                                                                               \
+            }                                                                                      \
+            if (i >= j) {                                                                          \
+                break;                                                                             \
+            }                                                                                      \
+            name##_priv_sort_swap(&ptr[i++], &ptr[j--]);                                           \
+        }                                                                                          \
+                                                                                                   \
+        name##_priv_sort_swap(&ptr[0], &ptr[j]);                                                   \
+        return j;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    inline static void name##_priv_sort(T *ptr, size_t len, size_t depth) {                        \
+        while (len > SLICE99_PRIV_INSERTION_SORT_THRESHOLD) {                                      \
+            if (depth == 0) {                                                                      \
+                name##_priv_heap_sort(ptr, len);                                                   \
+                return;                                                                            \
+            }                                                                                      \
+            depth--;                                                                               \
+                                                                                                   \
+            const size_t pivot = name##_priv_partition(ptr, len);                                  \
+            if (pivot < len - pivot - 1) {                                                         \
+                name##_priv_sort(ptr, pivot, depth);                                               \
+                ptr += pivot + 1;                                                                  \
+                len -= pivot + 1;                                                                  \
+            } else {                                                                               \
+                name##_priv_sort(ptr + pivot + 1, len - pivot - 1, depth);                         \
+                len = pivot;                                                                       \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        name##_priv_insertion_sort(ptr, len);                                                      \
+    }                                                                                              \
+                                                                                                   \
+    inline static void name##_sort_inline(name self) {                                             \
+        name##_priv_sort(self.ptr, self.len, slice99_priv_sort_depth(self.len));                   \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_WARN_UNUSED_RESULT size_t name##_lower_bound_inline(                     \
+        name self, const T *key) {                                                                 \
+        SLICE99_ASSERT(key);                                                                       \
+                                                                                                   \
+        if (self.len == 0) {                                                                       \
+            return 0;                                                                              \
+        }                                                                                          \
+                                                                                                   \
+        const T *base = self.ptr;                                                                  \
+        for (size_t len = self.len; len > 1;) {                                                    \
+            const size_t half = len / 2;                                                           \
+            base += cmp(&base[half], key) < 0 ? half : 0;                                          \
+            len -= half;                                                                           \
+        }                                                                                          \
+                                                                                                   \
+        return (size_t)(base - self.ptr) + (cmp(base, key) < 0);                                   \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_WARN_UNUSED_RESULT size_t name##_upper_bound_inline(                     \
+        name self, const T *key) {                                                                 \
+        SLICE99_ASSERT(key);                                                                       \
+                                                                                                   \
+        if (self.len == 0) {                                                                       \
+            return 0;                                                                              \
+        }                                                                                          \
+                                                                                                   \
+        const T *base = self.ptr;                                                                  \
+        for (size_t len = self.len; len > 1;) {                                                    \
+            const size_t half = len / 2;                                                           \
+            base += cmp(key, &base[half]) >= 0 ? half : 0;                                         \
+            len -= half;                                                                           \
+        }                                                                                          \
+                                                                                                   \
+        return (size_t)(base - self.ptr) + (cmp(key, base) >= 0);                                  \
+    }                                                                                              \
+                                                                                                   \
+    inline static SLICE99_WARN_UNUSED_RESULT ptrdiff_t name##_bsearch_inline(                      \
+        name self, const T *key) {                                                                 \
+        const size_t i = name##_lower_bound_inline(self, key);                                     \
+        return i < self.len && cmp(&self.ptr[i], key) == 0 ? (ptrdiff_t)i : -1;                    \
+    }                                                                                              \
+                                                                                                   \
+    struct slice99_priv_trailing_comma
+
+/**
+ * Defines LSD radix sort for the typed slice @p name of integers.
+ *
+ * This macro defines `void name_radix_sort(name self, name scratch)`, which sorts the items of
+ * @p self in ascending order, using @p scratch as temporary storage of at least `self.len` items.
+ * It makes one pass over @p self to build histograms of all bytes and then one pass per byte,
+ * skipping the bytes that are equal across all items. The sort is stable and takes O(n) time.
+ *
+ * @p T must be an integer type of at most 64 bits, signed or unsigned. Radix sorts are predefined
+ * for `U8Slice99`, `U16Slice99`, `U32Slice99`, `U64Slice99`, `I8Slice99`, `I16Slice99`,
+ * `I32Slice99`, and `I64Slice99`.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * int main(void) {
+ *     uint32_t keys[] = {30, 10, 20}, scratch[3];
+ *
+ *     U32Slice99_radix_sort(
+ *         (U32Slice99)Slice99_typed_from_array(keys),
+ *         (U32Slice99)Slice99_typed_from_array(scratch));
+ * }
+ * @endcode
+ */
+#define SLICE99_DEF_TYPED_RADIX_SORT(name, T)                                                      \
+    inline static void name##_radix_sort(name self, name scratch) {                                \
+        SLICE99_ASSERT(scratch.len >= self.len);                                                   \
+                                                                                                   \
+        /* Flipping the sign bit orders signed integers as unsigned ones. */                       \
+        const uint64_t flip = (T)-1 < (T)1 ? UINT64_C(1) << (8 * sizeof(T) - 1) : 0;               \
+                                                                                                   \
+        size_t counts[sizeof(T)][256] = {{0}};                                                     \
+        for (size_t i = 0; i < self.len; i++) {                                                    \
+            const uint64_t key = (uint64_t)self.ptr[i] ^ flip;                                     \
+            for (size_t byte = 0; byte < sizeof(T); byte++) {                                      \
+                counts[byte][(key >> (8 * byte)) & 0xFF]++;                                        \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        T *src = self.ptr, *dst = scratch.ptr;                                                     \
+        for (size_t byte = 0; byte < sizeof(T) && self.len > 0; byte++) {                          \
+            size_t *count = counts[byte];                                                          \
+                                                                                                   \
+            /* Skip the pass if all items have the same digit. */                                  \
+            if (count[(((uint64_t)src[0] ^ flip) >> (8 * byte)) & 0xFF] == self.len) {             \
+                continue;                                                                          \
+            }                                                                                      \
+                                                                                                   \
+            for (size_t digit = 0, offset = 0; digit < 256; digit++) {                             \
+                const size_t n = count[digit];                                                     \
+                count[digit] = offset;                                                             \
+                offset += n;                                                                       \
+            }                                                                                      \
+                                                                                                   \
+            for (size_t i = 0; i < self.len; i++) {                                                \
+                dst[count[(((uint64_t)src[i] ^ flip) >> (8 * byte)) & 0xFF]++] = src[i];           \
+            }                                                                                      \
+                                                                                                   \
+            T *const tmp = src;                                                                    \
+            src = dst;                                                                             \
+            dst = tmp;                                                                             \
+        }                                                                                          \
+                                                                                                   \
+        if (src != self.ptr) {                                                                     \
+            SLICE99_MEMCPY(self.ptr, src, self.len * sizeof(T));                                   \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    struct slice99_priv_trailing_comma
+
+/**
+ * Converts #Slice99 to a typed representation.
+ *
+ * @pre @p self must be an expression of type #Slice99.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * int main(void) {
+ *     Slice99 x = Slice99_from_str("abc");
+ *     CharSlice99 y = (CharSlice99)SLICE99_TO_TYPED(x);
+ *     (void)y;
+ * }
+ * @endcode
+ */
+#define SLICE99_TO_TYPED(self)                                                                     \
+    { .ptr = (self).ptr, .len = (self).len }
+
+/**
+ * Converts the typed slice @p self to #Slice99.
+ *
+ * @pre @p self must be an expression of type defined by #SLICE99_DEF_TYPED.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * int main(void) {
+ *     CharSlice99 x = CharSlice99_from_str("abc");
+ *     Slice99 y = SLICE99_TO_UNTYPED(x);
+ *     (void)y;
+ * }
+ * @endcode
+ */
+#define SLICE99_TO_UNTYPED(self) Slice99_new((self).ptr, sizeof(*(self).ptr), (self).len)
+
+/**
+ * Computes a number of items in an array expression.
+ */
+#define SLICE99_ARRAY_LEN(...) (sizeof(__VA_ARGS__) / sizeof((__VA_ARGS__)[0]))
+
+/**
+ * Copies @p obj to @p buffer, returning the next position of @p buffer to write to.
+ *
+ * This macro is no different from `memcpy` except for the return value. It is useful when you
+ * want to write a sequence of objects to some memory buffer, e.g., to a packet header:
+ *
+ * @code
+ * const uint16_t x = 123;
+ * const uint32_t y = 456;
+ *
+ * header = SLICE99_APPEND(header, x);
+ * header = SLICE99_APPEND(header, y);
+ * // ...
+ * @endcode
+ *
+ * @param[out] buffer The memory area to write to.
+ * @param[in] obj The object (lvalue) that will be copied to @p buffer, byte-by-byte.
+ *
+ * @return `(void *)((char *)buffer + sizeof(obj))`
+ *
+ * @pre @p buffer must be capable of holding at least `sizeof(obj)` bytes.
+ * @pre @p buffer and @p obj must be non-overlapping.
+ *
+ * @see #SLICE99_APPEND_ARRAY
+ */
+#define SLICE99_APPEND(buffer, obj)                                                                \
+    ((void *)((char *)SLICE99_MEMCPY((buffer), &(obj), sizeof(obj)) + sizeof(obj)))
+
+/**
+ * Copies the array of length @p len accessible through @p ptr into @p buffer, returning the next
+ * position of @p buffer to write to.
+ *
+ * This function has the same requirements and a return value as of #SLICE99_APPEND.
+ */
+#define SLICE99_APPEND_ARRAY(buffer, ptr, len)                                                     \
+    /* clang-format off */ \
+    ((void *)((char *)SLICE99_MEMCPY((buffer), (ptr), sizeof((ptr)[0]) * (len)) + \
+              sizeof((ptr)[0]) * (len))) /* clang-format on */
+
+#ifdef UINT8_MAX
+
+/**
+ * Constructs `U8Slice99` from @p obj.
+ *
+ * @param[in] obj The object (lvalue) to which the resulting slice will point to.
+ *
+ * @return An octet slice pointing to @p obj of length `sizeof(obj)`.
+ */
+#define SLICE99_TO_OCTETS(obj) U8Slice99_new((uint8_t *)&(obj), sizeof(obj))
+
+#endif
+
+/**
+ * Constructs a slice from an array expression.
+ *
+ * The resulting slice will have #Slice99.len equal to the number of items in the array, and
+ * #Slice99.item_size equal to the size of each item.
+ */
+#define Slice99_from_array(...)                                                                    \
+    Slice99_new((void *)(__VA_ARGS__), sizeof((__VA_ARGS__)[0]), SLICE99_ARRAY_LEN(__VA_ARGS__))
+
+/**
+ * The same as #Slice99_from_array but for typed slices.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * int main(void) {
+ *     IntSlice99 x = (IntSlice99)Slice99_typed_from_array((int[]){1, 2, 3});
+ *     (void)x;
+ * }
+ * @endcode
+ */
+#define Slice99_typed_from_array(...)                                                              \
+    { .ptr = (__VA_ARGS__), .len = SLICE99_ARRAY_LEN(__VA_ARGS__) }
+
+/**
+ * Constructs a slice from a pointer of a non-`void` type and a length.
+ *
+ * It is equivalent to #Slice99_new but it automatically computes an item size as `sizeof(*ptr)`.
+ *
+ * @param[in] ptr The pointer of the resulting slice. Must not point to `void`.
+ * @param[in] len The length of the resulting slice.
+ */
+#define Slice99_from_typed_ptr(ptr, len) Slice99_new(ptr, sizeof(*(ptr)), len)
+
+#ifdef SLICE99_ENABLE_STATS
+
+#if defined(__GNUC__)
+#define SLICE99_PRIV_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define SLICE99_PRIV_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define SLICE99_PRIV_THREAD_LOCAL _Thread_local
+#else
+#error "SLICE99_ENABLE_STATS requires thread-local storage"
+#endif
+
+#ifndef SLICE99_STATS_HOOK
+/**
+ * Called as `SLICE99_STATS_HOOK(op, bytes)` on every call to an instrumented function, after all
+ * its counters, including #Slice99StatsCounters::mismatches and
+ * #Slice99StatsCounters::truncations, have been updated; it may read them with
+ * #Slice99Stats_snapshot.
+ *
+ * @p op is the #Slice99StatsOp of the function and @p bytes is the number of bytes it has
+ * processed. Define it beforehand to trace or aggregate the calls yourself; it does nothing by
+ * default.
+ *
+ * Defined only if `SLICE99_ENABLE_STATS` is defined.
+ */
+#define SLICE99_STATS_HOOK(op, bytes) ((void)0)
+#endif
+
+/**
+ * The functions instrumented by #Slice99Stats.
+ *
+ * The typed counterparts generated by #SLICE99_DEF_TYPED are counted as their untyped functions.
+ *
+ * Defined only if `SLICE99_ENABLE_STATS` is defined.
+ */
+typedef enum {
+    /**
+     * #Slice99_copy. Counts the bytes copied.
+     */
+    SLICE99_STATS_COPY,
+
+    /**
+     * #Slice99_copy_non_overlapping. Counts the bytes copied.
+     */
+    SLICE99_STATS_COPY_NON_OVERLAPPING,
+
+    /**
+     * #Slice99_primitive_eq. Counts the bytes compared and the calls that have returned `false`.
+     */
+    SLICE99_STATS_PRIMITIVE_EQ,
+
+    /**
+     * #CharSlice99_vfmt, #CharSlice99_fmt, #CharSlice99_arena_vfmt, and #CharSlice99_arena_fmt.
+     * Counts the characters written, or 0 if formatting or allocation has failed.
+     */
+    SLICE99_STATS_FMT,
+
+    /**
+     * #CharSlice99_vnfmt, #CharSlice99_nfmt, #CharSlice99_try_vnfmt, #CharSlice99_try_nfmt,
+     * #Slice99Writer_vfmt, and #Slice99Writer_fmt. Counts the characters written and the calls
+     * whose output has been truncated. The writer functions count a string that does not fit as
+     * truncated and none of its characters as written, and count only the call when the writer
+     * is already overflowed.
+     */
+    SLICE99_STATS_NFMT,
+
+    /**
+     * The number of the instrumented functions.
+     */
+    SLICE99_STATS_OP_COUNT,
+} Slice99StatsOp;
+
+/**
+ * The counters of a single #Slice99StatsOp.
+ *
+ * Defined only if `SLICE99_ENABLE_STATS` is defined.
+ */
+typedef struct {
+    /**
+     * The number of calls.
+     */
+    uint64_t calls;
+
+    /**
+     * The number of bytes processed by all the calls.
+     */
+    uint64_t bytes;
+
+    /**
+     * The number of calls of #SLICE99_STATS_PRIMITIVE_EQ that have found the slices unequal.
+     */
+    uint64_t mismatches;
+
+    /**
+     * The number of calls of #SLICE99_STATS_NFMT that have truncated their output.
+     */
+    uint64_t truncations;
+} Slice99StatsCounters;
+
+/**
+ * Per-operation counters of the instrumented functions.
+ *
+ * The counters are kept in thread-local storage, one set per thread and per translation unit, so
+ * they are updated without synchronisation. To aggregate them across translation units or threads,
+ * define #SLICE99_STATS_HOOK.
+ *
+ * If `SLICE99_ENABLE_STATS` is not defined, the instrumentation compiles to nothing.
+ *
+ * Defined only if `SLICE99_ENABLE_STATS` is defined.
+ *
+ * # Examples
+ *
+ * @code
+ * #define SLICE99_ENABLE_STATS
+ * #include <slice99.h>
+ *
+ * #include <stdio.h>
+ *
+ * int main(void) {
+ *     char src[] = "abc", dst[] = "xyz";
+ *
+ *     Slice99_copy(Slice99_from_str(dst), Slice99_from_str(src));
+ *
+ *     const Slice99Stats stats = Slice99Stats_snapshot();
+ *     for (int op = 0; op < SLICE99_STATS_OP_COUNT; op++) {
+ *         printf(
+ *             "%s: %llu calls, %llu bytes\n", Slice99StatsOp_name((Slice99StatsOp)op),
+ *             (unsigned long long)stats.ops[op].calls, (unsigned long long)stats.ops[op].bytes);
+ *     }
+ * }
+ * @endcode
+ */
+typedef struct {
+    /**
+     * The counters indexed by #Slice99StatsOp.
+     */
+    Slice99StatsCounters ops[SLICE99_STATS_OP_COUNT];
+} Slice99Stats;
+
+#ifndef DOXYGEN_IGNORE
+
+inline static Slice99Stats *slice99_priv_stats(void) {
+    static SLICE99_PRIV_THREAD_LOCAL Slice99Stats stats;
+    return &stats;
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Returns the counters of the calling thread.
+ *
+ * Defined only if `SLICE99_ENABLE_STATS` is defined.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Stats Slice99Stats_snapshot(void) {
+    return *slice99_priv_stats();
+}
+
+/**
+ * Sets all the counters of the calling thread to zero.
+ *
+ * Defined only if `SLICE99_ENABLE_STATS` is defined.
+ */
+inline static void Slice99Stats_reset(void) {
+    const Slice99Stats zero = {.ops = {{0}}};
+    *slice99_priv_stats() = zero;
+}
+
+/**
+ * Returns the name of the function counted by @p op, such as `"copy"`.
+ *
+ * Defined only if `SLICE99_ENABLE_STATS` is defined.
+ *
+ * @pre `op < SLICE99_STATS_OP_COUNT`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST const char *
+Slice99StatsOp_name(Slice99StatsOp op) {
+    SLICE99_ASSERT(op < SLICE99_STATS_OP_COUNT);
+
+    static const char *const names[SLICE99_STATS_OP_COUNT] = {
+        [SLICE99_STATS_COPY] = "copy",
+        [SLICE99_STATS_COPY_NON_OVERLAPPING] = "copy_non_overlapping",
+        [SLICE99_STATS_PRIMITIVE_EQ] = "primitive_eq",
+        [SLICE99_STATS_FMT] = "fmt",
+        [SLICE99_STATS_NFMT] = "nfmt",
+    };
+
+    return names[op];
+}
+
+#ifndef DOXYGEN_IGNORE
+
+// Calls the hook last, so that it can observe the updated counters with `Slice99Stats_snapshot`.
+inline static void
+slice99_priv_stats_record(Slice99StatsOp op, size_t bytes, bool mismatch, bool truncation) {
+    Slice99StatsCounters *counters = &slice99_priv_stats()->ops[op];
+    counters->calls++;
+    counters->bytes += bytes;
+    counters->mismatches += mismatch;
+    counters->truncations += truncation;
+
+    SLICE99_STATS_HOOK(op, bytes);
+}
+
+#define SLICE99_PRIV_STATS_RECORD(op, bytes, mismatch, truncation)                                 \
+    slice99_priv_stats_record(op, bytes, mismatch, truncation)
+
+#endif // DOXYGEN_IGNORE
+
+#else
+
+#ifndef DOXYGEN_IGNORE
+
+#define SLICE99_PRIV_STATS_RECORD(op, bytes, mismatch, truncation) ((void)0)
+
+#endif // DOXYGEN_IGNORE
+
+#endif // SLICE99_ENABLE_STATS
+
+/**
+ * A slice of some array.
+ *
+ * This structure should not be constructed manually; use #Slice99_new instead.
+ *
+ * @invariant #ptr must not be `NULL`.
+ * @invariant #item_size must be strictly greater than 0.
+ */
+typedef struct {
+    /**
+     * The pointer to data.
+     */
+    void *ptr;
+
+    /**
+     * The size of each item in the array addressed by #ptr.
+     */
+    size_t item_size;
+
+    /**
+     * The count of items in the array addressed by #ptr.
+     */
+    size_t len;
+} Slice99;
+
+/**
+ * Constructs a slice.
+ *
+ * @param[in] ptr The value of Slice99#ptr.
+ * @param[in] item_size The value of Slice99#item_size.
+ * @param[in] len The value of Slice99#len.
+ *
+ * @pre `ptr != NULL`
+ * @pre `item_size > 0`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99
+Slice99_new(void *ptr, size_t item_size, size_t len) {
+    SLICE99_ASSERT(ptr);
+    SLICE99_ASSERT(item_size > 0);
+
+    return (Slice99){.ptr = ptr, .item_size = item_size, .len = len};
+}
+
+/**
+ * Constructs a slice from @p str.
+ *
+ * @param[in] str Any null-terminated string.
+ *
+ * @pre `str != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99 Slice99_from_str(char *str) {
+    SLICE99_ASSERT(str);
+
+    return Slice99_new(str, sizeof(char), SLICE99_STRLEN(str));
+}
+
+/**
+ * Constructs a slice residing between @p start (inclusively) and @p end (exclusively).
+ *
+ * @param[in] start The start position of a returned slice, inclusively.
+ * @param[in] end The end position of a returned slice, exlusively.
+ * @param[in] item_size The value of Slice99#item_size.
+ *
+ * @pre `start != NULL`
+ * @pre `end != NULL`
+ * @pre `((char *)end - (char *)start) >= 0`
+ * @pre `(((char *)end - (char *)start)) % item_size == 0`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99
+Slice99_from_ptrdiff(void *start, void *end, size_t item_size) {
+    SLICE99_ASSERT(start);
+    SLICE99_ASSERT(end);
+
+    const ptrdiff_t diff = (char *)end - (char *)start;
+
+    SLICE99_ASSERT(diff >= 0);
+    SLICE99_ASSERT((size_t)diff % item_size == 0);
+
+    return Slice99_new(start, item_size, (size_t)(diff / (ptrdiff_t)item_size));
+}
+
+/**
+ * Constructs an empty slice.
+ *
+ * @param[in] item_size The value of Slice99#item_size.
+ *
+ * @pre `item_size > 0`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99 Slice99_empty(size_t item_size) {
+    SLICE99_ASSERT(item_size > 0);
+    return Slice99_new("", item_size, 0);
+}
+
+/**
+ * Updates @p self with the new length @p new_len.
+ *
+ * @param[in] self The slice whose length will be updated.
+ * @param[in] new_len The new length.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99 Slice99_update_len(Slice99 self, size_t new_len) {
+    return Slice99_new(self.ptr, self.item_size, new_len);
+}
+
+/**
+ * Checks whether @p self is empty or not.
+ *
+ * @param[in] self The checked slice.
+ *
+ * @return `true` if @p self is empty, otherwise `false`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST bool Slice99_is_empty(Slice99 self) {
+    return self.len == 0;
+}
+
+/**
+ * Computes a total size in bytes.
+ *
+ * @param[in] self The slice whose size is to be computed.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST size_t Slice99_size(Slice99 self) {
+    return self.item_size * self.len;
+}
+
+/**
+ * Computes a pointer to the @p i -indexed item.
+ *
+ * @param[in] self The slice upon which the pointer will be computed.
+ * @param[in] i The index of a desired item. Can be negative.
+ *
+ * @pre `self.item_size` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST void *
+Slice99_get(Slice99 self, ptrdiff_t i) {
+    return (void *)((char *)self.ptr + i * (ptrdiff_t)self.item_size);
+}
+
+/**
+ * Computes a pointer to the first item.
+ *
+ * @param[in] self The slice upon which the pointer will be computed.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST void *Slice99_first(Slice99 self) {
+    return Slice99_get(self, 0);
+}
+
+/**
+ * Computes a pointer to the last item.
+ *
+ * @param[in] self The slice upon which the pointer will be computed.
+ *
+ * @pre `self.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST void *Slice99_last(Slice99 self) {
+    return Slice99_get(self, (ptrdiff_t)self.len - 1);
+}
+
+/**
+ * Subslicing @p self with [@p start_idx `..` @p end_idx].
+ *
+ * @param[in] self The original slice.
+ * @param[in] start_idx The index at which a new slice will reside, inclusively.
+ * @param[in] end_idx The index at which a new slice will end, exclusively.
+ *
+ * @return A slice with the aforementioned properties.
+ *
+ * @pre `start_idx <= end_idx`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99
+Slice99_sub(Slice99 self, ptrdiff_t start_idx, ptrdiff_t end_idx) {
+    SLICE99_ASSERT(start_idx <= end_idx);
+
+    return Slice99_from_ptrdiff(
+        Slice99_get(self, start_idx), Slice99_get(self, end_idx), self.item_size);
+}
+
+/**
+ * Advances @p self by @p offset items.
+ *
+ * @param[in] self The original slice.
+ * @param[in] offset The number of items to advance. Can be negative.
+ *
+ * @return A slice advanced by @p offset items.
+ *
+ * @pre `offset <= (self).len`
+ * @pre `self.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99 Slice99_advance(Slice99 self, ptrdiff_t offset) {
+    return Slice99_sub(self, offset, (ptrdiff_t)self.len);
+}
+
+/**
+ * Performs a byte-by-byte comparison of @p lhs with @p rhs.
+ *
+ * @param[in] lhs The first slice to be compared.
+ * @param[in] rhs The second slice to be compared.
+ *
+ * @return `true` if @p lhs and @p rhs are equal, `false` otherwise.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool Slice99_primitive_eq(Slice99 lhs, Slice99 rhs) {
+    const bool same_size = Slice99_size(lhs) == Slice99_size(rhs);
+    const bool result = same_size && SLICE99_MEMCMP(lhs.ptr, rhs.ptr, Slice99_size(lhs)) == 0;
+
+    SLICE99_PRIV_STATS_RECORD(
+        SLICE99_STATS_PRIMITIVE_EQ, same_size ? Slice99_size(lhs) : 0, !result, false);
+
+    return result;
+}
+
+/**
+ * Performs a comparison of @p lhs with @p rhs with a user-supplied comparator.
+ *
+ * @param[in] lhs The first slice to be compared.
+ * @param[in] rhs The second slice to be compared.
+ * @param[in] cmp The function deciding whether two items are equal ot not (0 if equal, any other
+ * value otherwise).
+ *
+ * @return `true` if @p lhs and @p rhs are equal, `false` otherwise.
+ *
+ * @pre `lhs.item_size == rhs.item_size`
+ * @pre `cmp != NULL`
+ * @pre `lhs.len` and `rhs.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99_eq(Slice99 lhs, Slice99 rhs, int (*cmp)(const void *, const void *)) {
+    SLICE99_ASSERT(lhs.item_size == rhs.item_size);
+    SLICE99_ASSERT(cmp);
+
+    if (lhs.len != rhs.len) {
+        return false;
+    }
+
+    for (ptrdiff_t i = 0; i < (ptrdiff_t)lhs.len; i++) {
+        if (cmp(Slice99_get(lhs, i), Slice99_get(rhs, i)) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Checks whether @p prefix is a prefix of @p self, byte-by-byte.
+ *
+ * @param[in] self The slice to be checked for @p prefix.
+ * @param[in] prefix The slice to be checked whether it is a prefix of @p self.
+ *
+ * @return `true` if @p prefix is a prefix of @p self, otherwise `false`.
+ *
+ * @pre `prefix.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99_primitive_starts_with(Slice99 self, Slice99 prefix) {
+    return Slice99_size(self) < Slice99_size(prefix)
+               ? false
+               : Slice99_primitive_eq(Slice99_sub(self, 0, (ptrdiff_t)prefix.len), prefix);
+}
+
+/**
+ * Checks whether @p prefix is a prefix of @p self with a user-supplied comparator.
+ *
+ * @param[in] self The slice to be checked for @p prefix.
+ * @param[in] prefix The slice to be checked whether it is a prefix of @p self.
+ * @param[in] cmp The function deciding whether two items are equal ot not (0 if equal, any other
+ * value otherwise).
+ *
+ * @return `true` if @p prefix is a prefix of @p self, otherwise `false`.
+ *
+ * @pre `self.item_size == prefix.item_size`
+ * @pre `cmp != NULL`
+ * @pre `prefix.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99_starts_with(Slice99 self, Slice99 prefix, int (*cmp)(const void *, const void *)) {
+    SLICE99_ASSERT(self.item_size == prefix.item_size);
+    SLICE99_ASSERT(cmp);
+
+    return self.len < prefix.len
+               ? false
+               : Slice99_eq(Slice99_sub(self, 0, (ptrdiff_t)prefix.len), prefix, cmp);
+}
+
+/**
+ * Checks whether @p postfix is a postfix of @p self, byte-by-byte.
+ *
+ * @param[in] self The slice to be checked for @p postfix.
+ * @param[in] postfix The slice to be checked whether it is a postfix of @p self.
+ *
+ * @return `true` if @p postfix is a postfix of @p self, otherwise `false`.
+ *
+ * @pre `self.len` and `postfix.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99_primitive_ends_with(Slice99 self, Slice99 postfix) {
+    return Slice99_size(self) < Slice99_size(postfix)
+               ? false
+               : Slice99_primitive_eq(
+                     Slice99_sub(
+                         self, (ptrdiff_t)self.len - (ptrdiff_t)postfix.len, (ptrdiff_t)self.len),
+                     postfix);
+}
+
+/**
+ * Checks whether @p postfix is a postfix of @p self with a user-supplied comparator.
+ *
+ * @param[in] self The slice to be checked for @p postfix.
+ * @param[in] postfix The slice to be checked whether it is a postfix of @p self.
+ * @param[in] cmp The function deciding whether two items are equal ot not (0 if equal, any other
+ * value otherwise).
+ *
+ * @return `true` if @p postfix is a postfix of @p self, otherwise `false`.
+ *
+ * @pre `self.item_size == postfix.item_size`
+ * @pre `cmp != NULL`
+ * @pre `self.len` and `postfix.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99_ends_with(Slice99 self, Slice99 postfix, int (*cmp)(const void *, const void *)) {
+    SLICE99_ASSERT(self.item_size == postfix.item_size);
+    SLICE99_ASSERT(cmp);
+
+    return self.len < postfix.len
+               ? false
+               : Slice99_eq(
+                     Slice99_sub(
+                         self, (ptrdiff_t)self.len - (ptrdiff_t)postfix.len, (ptrdiff_t)self.len),
+                     postfix, cmp);
+}
+
+#ifndef DOXYGEN_IGNORE
+
+// Returns the count of bytes from `ptr` to the next multiple of `align`, a power of two.
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST size_t
+slice99_priv_align_offset(const void *ptr, size_t align) {
+    return (size_t)(-(uintptr_t)ptr & (align - 1));
+}
+
+inline static SLICE99_WARN_UNUSED_RESULT const void *
+slice99_priv_memrchr(const void *ptr, int c, size_t n) {
+    const unsigned char *p = (const unsigned char *)ptr + n;
+    const unsigned char byte = (unsigned char)c;
+
+#ifdef SLICE99_PRIV_SSE2
+    // Check the bytes past the last 16-byte boundary first, so that the blocks are loaded aligned.
+    for (size_t tail = (size_t)((uintptr_t)p & 15); tail > 0 && n > 0; tail--, n--) {
+        if (*--p == byte) {
+            return p;
+        }
+    }
+
+    const __m128i needle = _mm_set1_epi8((char)byte);
+    for (; n >= 16; n -= 16) {
+        p -= 16;
+        const __m128i block = _mm_load_si128((const __m128i *)(const void *)p);
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask != 0) {
+            return p + (31 - __builtin_clz((unsigned)mask));
+        }
+    }
+#else
+    // Skip 8-byte words that do not contain the byte.
+    const uint64_t ones = UINT64_C(0x0101010101010101), highs = UINT64_C(0x8080808080808080);
+    for (; n >= 8; n -= 8) {
+        uint64_t word;
+        SLICE99_MEMCPY(&word, p - 8, 8);
+        word ^= ones * byte;
+        if (((word - ones) & ~word & highs) != 0) {
+            break;
+        }
+        p -= 8;
+    }
+#endif
+
+    while (n-- > 0) {
+        if (*--p == byte) {
+            return p;
+        }
+    }
+
+    return NULL;
+}
+
+inline static SLICE99_WARN_UNUSED_RESULT const unsigned char *slice99_priv_memmem(
+    const unsigned char *haystack, size_t haystack_size, const unsigned char *needle,
+    size_t needle_size) {
+    SLICE99_ASSERT(needle_size > 0);
+
+    if (haystack_size < needle_size) {
+        return NULL;
+    }
+    if (needle_size == 1) {
+        return (const unsigned char *)SLICE99_MEMCHR(haystack, needle[0], haystack_size);
+    }
+
+    const size_t last = needle_size - 1, candidates = haystack_size - last;
+    size_t i = 0;
+
+#ifdef SLICE99_PRIV_SSE2
+    // Compare the first and the last bytes of the needle at 16 positions at once; only the
+    // positions where both match are verified with a full comparison.
+    const __m128i first_byte = _mm_set1_epi8((char)needle[0]),
+                  last_byte = _mm_set1_epi8((char)needle[last]);
+    for (; i + 16 <= candidates; i += 16) {
+        const __m128i block_first = _mm_loadu_si128((const __m128i *)(const void *)(haystack + i)),
+                      block_last =
+                          _mm_loadu_si128((const __m128i *)(const void *)(haystack + i + last));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(block_first, first_byte), _mm_cmpeq_epi8(block_last, last_byte)));
+
+        while (mask != 0) {
+            const size_t pos = i + (size_t)__builtin_ctz(mask);
+            if (SLICE99_MEMCMP(haystack + pos + 1, needle + 1, last - 1) == 0) {
+                return haystack + pos;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    while (i < candidates) {
+        const unsigned char *hit =
+            (const unsigned char *)SLICE99_MEMCHR(haystack + i, needle[0], candidates - i);
+        if (hit == NULL) {
+            return NULL;
+        }
+        if (hit[last] == needle[last] && SLICE99_MEMCMP(hit + 1, needle + 1, last - 1) == 0) {
+            return hit;
+        }
+        i = (size_t)(hit - haystack) + 1;
+    }
+
+    return NULL;
+}
+
+inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT ptrdiff_t
+slice99_priv_find_item(const char *ptr, size_t len, const void *item, size_t item_size) {
+    for (size_t i = 0; i < len; i++, ptr += item_size) {
+        if (SLICE99_MEMCMP(ptr, item, item_size) == 0) {
+            return (ptrdiff_t)i;
+        }
+    }
+
+    return -1;
+}
+
+inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT ptrdiff_t
+slice99_priv_rfind_item(const char *ptr, size_t len, const void *item, size_t item_size) {
+    for (size_t i = len; i > 0; i--) {
+        if (SLICE99_MEMCMP(ptr + (i - 1) * item_size, item, item_size) == 0) {
+            return (ptrdiff_t)(i - 1);
+        }
+    }
+
+    return -1;
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Finds the first item of @p self equal to @p item, byte-by-byte.
+ *
+ * If `self.item_size == 1`, the search is performed by #SLICE99_MEMCHR.
+ *
+ * @param[in] self The slice to be searched.
+ * @param[in] item The memory area of `self.item_size` bytes to be found.
+ *
+ * @return The index of the found item or -1 if there is no such item.
+ *
+ * @pre `item != NULL`
+ * @pre `self.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT ptrdiff_t
+Slice99_primitive_find_item(Slice99 self, const void *item) {
+    SLICE99_ASSERT(item);
+
+    switch (self.item_size) {
+    case 1: {
+        const char *hit =
+            (const char *)SLICE99_MEMCHR(self.ptr, *(const unsigned char *)item, self.len);
+        return hit == NULL ? -1 : hit - (const char *)self.ptr;
+    }
+    case 2:
+        return slice99_priv_find_item((const char *)self.ptr, self.len, item, 2);
+    case 4:
+        return slice99_priv_find_item((const char *)self.ptr, self.len, item, 4);
+    case 8:
+        return slice99_priv_find_item((const char *)self.ptr, self.len, item, 8);
+    default:
+        return slice99_priv_find_item((const char *)self.ptr, self.len, item, self.item_size);
+    }
+}
+
+/**
+ * Finds the last item of @p self equal to @p item, byte-by-byte.
+ *
+ * If `self.item_size == 1`, the search is performed by #SLICE99_MEMRCHR.
+ *
+ * @param[in] self The slice to be searched.
+ * @param[in] item The memory area of `self.item_size` bytes to be found.
+ *
+ * @return The index of the found item or -1 if there is no such item.
+ *
+ * @pre `item != NULL`
+ * @pre `self.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT ptrdiff_t
+Slice99_primitive_rfind_item(Slice99 self, const void *item) {
+    SLICE99_ASSERT(item);
+
+    switch (self.item_size) {
+    case 1: {
+        const char *hit =
+            (const char *)SLICE99_MEMRCHR(self.ptr, *(const unsigned char *)item, self.len);
+        return hit == NULL ? -1 : hit - (const char *)self.ptr;
+    }
+    case 2:
+        return slice99_priv_rfind_item((const char *)self.ptr, self.len, item, 2);
+    case 4:
+        return slice99_priv_rfind_item((const char *)self.ptr, self.len, item, 4);
+    case 8:
+        return slice99_priv_rfind_item((const char *)self.ptr, self.len, item, 8);
+    default:
+        return slice99_priv_rfind_item((const char *)self.ptr, self.len, item, self.item_size);
+    }
+}
+
+/**
+ * Finds the first occurrence of @p needle in @p self, byte-by-byte.
+ *
+ * Only occurrences starting at item boundaries of @p self are taken into account.
+ *
+ * @param[in] self The slice to be searched.
+ * @param[in] needle The slice to be found.
+ *
+ * @return The index of the first item of the found occurrence or -1 if there is no such
+ * occurrence. If @p needle is empty, 0 is returned.
+ *
+ * @pre `self.item_size == needle.item_size`
+ * @pre `self.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT ptrdiff_t
+Slice99_primitive_find(Slice99 self, Slice99 needle) {
+    SLICE99_ASSERT(self.item_size == needle.item_size);
+
+    if (Slice99_is_empty(needle)) {
+        return 0;
+    }
+
+    const unsigned char *haystack = (const unsigned char *)self.ptr;
+    size_t offset = 0;
+
+    while (offset < Slice99_size(self)) {
+        const unsigned char *hit = slice99_priv_memmem(
+            haystack + offset, Slice99_size(self) - offset, (const unsigned char *)needle.ptr,
+            Slice99_size(needle));
+        if (hit == NULL) {
+            return -1;
+        }
+
+        const size_t hit_offset = (size_t)(hit - haystack);
+        if (hit_offset % self.item_size == 0) {
+            return (ptrdiff_t)(hit_offset / self.item_size);
+        }
+        offset = hit_offset + 1;
+    }
+
+    return -1;
+}
+
+/**
+ * Finds the last occurrence of @p needle in @p self, byte-by-byte.
+ *
+ * Only occurrences starting at item boundaries of @p self are taken into account.
+ *
+ * @param[in] self The slice to be searched.
+ * @param[in] needle The slice to be found.
+ *
+ * @return The index of the first item of the found occurrence or -1 if there is no such
+ * occurrence. If @p needle is empty, `self.len` is returned.
+ *
+ * @pre `self.item_size == needle.item_size`
+ * @pre `self.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT ptrdiff_t
+Slice99_primitive_rfind(Slice99 self, Slice99 needle) {
+    SLICE99_ASSERT(self.item_size == needle.item_size);
+
+    if (Slice99_is_empty(needle)) {
+        return (ptrdiff_t)self.len;
+    }
+    if (self.len < needle.len) {
+        return -1;
+    }
+
+    const unsigned char *haystack = (const unsigned char *)self.ptr,
+                        *first = (const unsigned char *)needle.ptr;
+    size_t end = Slice99_size(self) - Slice99_size(needle) + 1;
+
+    while (end > 0) {
+        const unsigned char *hit = (const unsigned char *)SLICE99_MEMRCHR(haystack, first[0], end);
+        if (hit == NULL) {
+            return -1;
+        }
+
+        const size_t hit_offset = (size_t)(hit - haystack);
+        if (hit_offset % self.item_size == 0 &&
+            SLICE99_MEMCMP(hit, first, Slice99_size(needle)) == 0) {
+            return (ptrdiff_t)(hit_offset / self.item_size);
+        }
+        end = hit_offset;
+    }
+
+    return -1;
+}
+
+/**
+ * Finds the first item of @p self equal to @p item with a user-supplied comparator.
+ *
+ * @param[in] self The slice to be searched.
+ * @param[in] item The item to be found.
+ * @param[in] cmp The function deciding whether two items are equal ot not (0 if equal, any other
+ * value otherwise).
+ *
+ * @return The index of the found item or -1 if there is no such item.
+ *
+ * @pre `item != NULL`
+ * @pre `cmp != NULL`
+ * @pre `self.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT ptrdiff_t
+Slice99_find_item(Slice99 self, const void *item, int (*cmp)(const void *, const void *)) {
+    SLICE99_ASSERT(item);
+    SLICE99_ASSERT(cmp);
+
+    for (ptrdiff_t i = 0; i < (ptrdiff_t)self.len; i++) {
+        if (cmp(Slice99_get(self, i), item) == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Finds the first occurrence of @p needle in @p self with a user-supplied comparator.
+ *
+ * @param[in] self The slice to be searched.
+ * @param[in] needle The slice to be found.
+ * @param[in] cmp The function deciding whether two items are equal ot not (0 if equal, any other
+ * value otherwise).
+ *
+ * @return The index of the first item of the found occurrence or -1 if there is no such
+ * occurrence. If @p needle is empty, 0 is returned.
+ *
+ * @pre `self.item_size == needle.item_size`
+ * @pre `cmp != NULL`
+ * @pre `self.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT ptrdiff_t
+Slice99_find(Slice99 self, Slice99 needle, int (*cmp)(const void *, const void *)) {
+    SLICE99_ASSERT(self.item_size == needle.item_size);
+    SLICE99_ASSERT(cmp);
+
+    if (self.len < needle.len) {
+        return -1;
+    }
+
+    for (ptrdiff_t i = 0; i <= (ptrdiff_t)(self.len - needle.len); i++) {
+        if (Slice99_eq(Slice99_sub(self, i, i + (ptrdiff_t)needle.len), needle, cmp)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Copies @p other to the beginning of @p self, byte-by-byte.
+ *
+ * @param[out] self The location to which the whole @p other will be copied.
+ * @param[in] other The slice to be copied to @p self.
+ */
+inline static void Slice99_copy(Slice99 self, Slice99 other) {
+    SLICE99_PRIV_STATS_RECORD(SLICE99_STATS_COPY, Slice99_size(other), false, false);
+
+    SLICE99_MEMMOVE(self.ptr, other.ptr, Slice99_size(other));
+}
+
+/**
+ * The same as #Slice99_copy except that @p self and @p other must be non-overlapping.
+ *
+ * @pre @p self and @p other must be non-overlapping.
+ */
+inline static void Slice99_copy_non_overlapping(Slice99 self, Slice99 other) {
+    SLICE99_PRIV_STATS_RECORD(
+        SLICE99_STATS_COPY_NON_OVERLAPPING, Slice99_size(other), false, false);
+
+    SLICE99_MEMCPY(self.ptr, other.ptr, Slice99_size(other));
+}
+
+#ifndef SLICE99_STREAM_THRESHOLD
+/// The size in bytes from which #Slice99_fill and #Slice99_memset bypass the cache with
+/// non-temporal stores. It should exceed the last-level cache, so that the filled memory would
+/// not fit into it anyway.
+#define SLICE99_STREAM_THRESHOLD (32 * 1024 * 1024)
+#endif
+
+#ifndef DOXYGEN_IGNORE
+
+// Once the replicated prefix reaches this size, it is copied as is instead of doubling further, so
+// that the source of every copy stays in L1.
+#define SLICE99_PRIV_FILL_CHUNK_SIZE 4096
+
+// Fills `size` bytes at `p` (a multiple of `item_size`) with the item at `item`, which may point
+// into the filled bytes.
+inline static void slice99_priv_fill(char *p, size_t size, const void *item, size_t item_size) {
+    const char *bytes = item;
+    if (item_size == 1 || SLICE99_MEMCMP(bytes, bytes + 1, item_size - 1) == 0) {
+        SLICE99_MEMSET(p, (unsigned char)bytes[0], size);
+        return;
+    }
+
+    SLICE99_MEMMOVE(p, item, item_size);
+
+    size_t filled = item_size, chunk = item_size;
+    while (filled < size) {
+        const size_t n = chunk < size - filled ? chunk : size - filled;
+        SLICE99_MEMCPY(p + filled, p, n);
+        filled += n;
+
+        if (chunk < SLICE99_PRIV_FILL_CHUNK_SIZE) {
+            chunk = filled;
+        }
+    }
+}
+
+#ifdef SLICE99_PRIV_SSE2
+
+// The same as `slice99_priv_fill` but writes the bulk of the bytes with non-temporal stores.
+//
+// The bytes up to the first 16-byte boundary, followed by one period of `item_size * 16` bytes,
+// are filled through the cache; this period begins and ends at a 16-byte boundary and contains a
+// whole number of items, so it is then streamed over the rest of the bytes.
+//
+// `item_size <= size / 64` must hold.
+inline static void
+slice99_priv_fill_stream(char *p, size_t size, const void *item, size_t item_size) {
+    char *const end = p + size;
+    char *const base = p + slice99_priv_align_offset(p, 16);
+    const size_t period = item_size * 16;
+
+    slice99_priv_fill(p, (size_t)(base - p) + period, item, item_size);
+
+    char *q = base + period;
+    while ((size_t)(end - q) >= period) {
+        for (size_t j = 0; j < period; j += 16) {
+            const __m128i block = _mm_load_si128((const __m128i *)(const void *)(base + j));
+            _mm_stream_si128((__m128i *)(void *)(q + j), block);
+        }
+        q += period;
+    }
+    _mm_sfence();
+
+    SLICE99_MEMCPY(q, base, (size_t)(end - q));
+}
+
+#endif // SLICE99_PRIV_SSE2
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Fills @p self with copies of the item pointed to by @p item.
+ *
+ * The item is replicated by doubling copies of the already filled prefix. Items consisting of the
+ * same byte (e.g., zeros) are filled with #SLICE99_MEMSET. When SSE2 is available, slices of at
+ * least #SLICE99_STREAM_THRESHOLD bytes are filled with non-temporal stores, so that filling them
+ * does not evict the rest of the cache.
+ *
+ * @param[out] self The slice to be filled.
+ * @param[in] item The item of `self.item_size` bytes to be copied to every item of @p self. May
+ * point to an item of @p self.
+ *
+ * @pre `item != NULL`
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * typedef struct {
+ *     short x, y;
+ * } Point;
+ *
+ * int main(void) {
+ *     Point points[100];
+ *
+ *     Slice99_fill(Slice99_from_array(points), &(Point){.x = 1, .y = 2});
+ *     assert(points[99].x == 1 && points[99].y == 2);
+ * }
+ * @endcode
+ */
+inline static void Slice99_fill(Slice99 self, const void *item) {
+    SLICE99_ASSERT(item);
+
+    const size_t size = Slice99_size(self);
+    if (size == 0) {
+        return;
+    }
+
+#ifdef SLICE99_PRIV_SSE2
+    if (size >= SLICE99_STREAM_THRESHOLD && self.item_size <= size / 64) {
+        slice99_priv_fill_stream(self.ptr, size, item, self.item_size);
+        return;
+    }
+#endif
+
+    slice99_priv_fill(self.ptr, size, item, self.item_size);
+}
+
+/**
+ * Sets every byte of @p self to @p byte.
+ *
+ * It is the same as #SLICE99_MEMSET over the bytes of @p self, except that slices of at least
+ * #SLICE99_STREAM_THRESHOLD bytes are filled with non-temporal stores as in #Slice99_fill.
+ *
+ * @param[out] self The slice to be filled.
+ * @param[in] byte The value of every byte of @p self.
+ */
+inline static void Slice99_memset(Slice99 self, unsigned char byte) {
+    Slice99_fill(Slice99_new(self.ptr, 1, Slice99_size(self)), &byte);
+}
+
+#ifndef DOXYGEN_IGNORE
+
+// When `item_size` is a compile-time constant (see the `switch`es below), these reduce to plain
+// loads and stores of the corresponding width.
+
+// `lhs` and `rhs` are not `restrict`, so that swapping an item with itself is well-defined.
+inline static SLICE99_ALWAYS_INLINE void
+slice99_priv_swap_items(void *lhs, void *rhs, size_t item_size, void *restrict backup) {
+    SLICE99_MEMCPY(backup, lhs, item_size);
+    SLICE99_MEMCPY(lhs, rhs, item_size);
+    SLICE99_MEMCPY(rhs, backup, item_size);
+}
+
+inline static SLICE99_ALWAYS_INLINE void slice99_priv_swap_ranges(
+    char *restrict lhs, char *restrict rhs, size_t len, size_t item_size, void *restrict backup) {
+    for (size_t i = 0; i < len; i++, lhs += item_size, rhs += item_size) {
+        slice99_priv_swap_items(lhs, rhs, item_size, backup);
+    }
+}
+
+// Reverses the order of 1- or 2-byte items packed in a word.
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST uint64_t
+slice99_priv_reverse_word(uint64_t x, size_t item_size) {
+    x = (x >> 32) | (x << 32);
+    x = ((x & UINT64_C(0xFFFF0000FFFF0000)) >> 16) | ((x & UINT64_C(0x0000FFFF0000FFFF)) << 16);
+    if (item_size == 1) {
+        x = ((x & UINT64_C(0xFF00FF00FF00FF00)) >> 8) | ((x & UINT64_C(0x00FF00FF00FF00FF)) << 8);
+    }
+    return x;
+}
+
+inline static SLICE99_ALWAYS_INLINE void
+slice99_priv_reverse(char *ptr, size_t len, size_t item_size, void *restrict backup) {
+    if (len < 2) {
+        return;
+    }
+
+    char *lhs = ptr, *rhs = ptr + len * item_size;
+
+    // Compilers do not vectorise reversal of narrow items, so reverse 8-byte words from both ends
+    // instead, permuting the items inside each word with shifts.
+    if (item_size <= 2) {
+        while (rhs - lhs >= 16) {
+            uint64_t lhs_word, rhs_word;
+            SLICE99_MEMCPY(&lhs_word, lhs, 8);
+            SLICE99_MEMCPY(&rhs_word, rhs - 8, 8);
+
+            lhs_word = slice99_priv_reverse_word(lhs_word, item_size);
+            rhs_word = slice99_priv_reverse_word(rhs_word, item_size);
+
+            SLICE99_MEMCPY(lhs, &rhs_word, 8);
+            SLICE99_MEMCPY(rhs - 8, &lhs_word, 8);
+            lhs += 8;
+            rhs -= 8;
+        }
+    }
+
+    for (rhs -= item_size; lhs < rhs; lhs += item_size, rhs -= item_size) {
+        slice99_priv_swap_items(lhs, rhs, item_size, backup);
+    }
+}
+
+#define SLICE99_PRIV_DISPATCH_ITEM_SIZE(item_size, backup, f, ...)                                 \
+    do {                                                                                           \
+        unsigned char slice99_priv_tmp[16];                                                        \
+        switch (item_size) {                                                                       \
+        case 1:                                                                                    \
+            f(__VA_ARGS__, 1, slice99_priv_tmp);                                                   \
+            break;                                                                                 \
+        case 2:                                                                                    \
+            f(__VA_ARGS__, 2, slice99_priv_tmp);                                                   \
+            break;                                                                                 \
+        case 4:                                                                                    \
+            f(__VA_ARGS__, 4, slice99_priv_tmp);                                                   \
+            break;                                                                                 \
+        case 8:                                                                                    \
+            f(__VA_ARGS__, 8, slice99_priv_tmp);                                                   \
+            break;                                                                                 \
+        case 16:                                                                                   \
+            f(__VA_ARGS__, 16, slice99_priv_tmp);                                                  \
+            break;                                                                                 \
+        default:                                                                                   \
+            SLICE99_ASSERT(backup);                                                                \
+            f(__VA_ARGS__, (item_size), (backup));                                                 \
+            break;                                                                                 \
+        }                                                                                          \
+    } while (0)
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Swaps the @p lhs -indexed and @p rhs -indexed items.
+ *
+ * If `self.item_size` is 1, 2, 4, 8, or 16, @p backup is not touched.
+ *
+ * @param[out] self The slice in which @p lhs and @p rhs will be swapped.
+ * @param[in] lhs The index of the first item.
+ * @param[in] rhs The index of the second item.
+ * @param[out] backup The memory area of `self.item_size` bytes accessible for reading and writing.
+ *
+ * @pre `backup != NULL` unless `self.item_size` is 1, 2, 4, 8, or 16.
+ * @pre @p backup must not overlap with `Slice99_get(self, lhs)` and `Slice99_get(self, rhs)`.
+ * @pre `Slice99_get(self, lhs)` and `Slice99_get(self, rhs)` must not overlap unless `lhs == rhs`.
+ */
+inline static void Slice99_swap(Slice99 self, ptrdiff_t lhs, ptrdiff_t rhs, void *restrict backup) {
+    if (lhs == rhs) {
+        return;
+    }
+
+    SLICE99_PRIV_DISPATCH_ITEM_SIZE(
+        self.item_size, backup, slice99_priv_swap_items, Slice99_get(self, lhs),
+        Slice99_get(self, rhs));
+}
+
+/**
+ * Swaps all the items in @p self with those in @p other.
+ *
+ * If `self.item_size` is 1, 2, 4, 8, or 16, @p backup is not touched.
+ *
+ * @param[out] self The first slice to be swapped.
+ * @param[out] other The second slice to be swapped.
+ * @param[out] backup The memory area of `self.item_size` bytes accessible for reading and writing.
+ *
+ * @pre `self.len == other.len`
+ * @pre `self.item_size == other.item_size`
+ * @pre @p backup must not overlap with @p self and @p other.
+ * @pre @p self and @p other must not overlap.
+ * @pre `self.len` must be representable as `ptrdiff_t`.
+ */
+inline static void Slice99_swap_with_slice(Slice99 self, Slice99 other, void *restrict backup) {
+    SLICE99_ASSERT(self.len == other.len);
+    SLICE99_ASSERT(self.item_size == other.item_size);
+
+    SLICE99_PRIV_DISPATCH_ITEM_SIZE(
+        self.item_size, backup, slice99_priv_swap_ranges, (char *)self.ptr, (char *)other.ptr,
+        self.len);
+}
+
+/**
+ * Reverses the order of items in @p self.
+ *
+ * If `self.item_size` is 1, 2, 4, 8, or 16, @p backup is not touched.
+ *
+ * @param[out] self The slice to be reversed.
+ * @param[out] backup The memory area of `self.item_size` bytes accessible for reading and writing.
+ *
+ * @pre `backup != NULL` unless `self.item_size` is 1, 2, 4, 8, or 16.
+ * @pre `self.len` must be representable as `ptrdiff_t`.
+ */
+inline static void Slice99_reverse(Slice99 self, void *restrict backup) {
+    SLICE99_PRIV_DISPATCH_ITEM_SIZE(
+        self.item_size, backup, slice99_priv_reverse, (char *)self.ptr, self.len);
+}
+
+/**
+ * Splits @p self into two parts.
+ *
+ * @param[in] self The slice to be splitted into @p lhs and @p rhs.
+ * @param[in] i The index at which @p self will be splitted.
+ * @param[out] lhs The first part of @p self indexed as [0; @p i).
+ * @param[out] rhs The second part of @p self indexed as [@p i; `self.len`).
+ *
+ * @pre `i <= self.len`
+ * @pre `lhs != NULL`
+ * @pre `rhs != NULL`
+ * @pre `self.len` and @p i must be representable as `ptrdiff_t`.
+ */
+inline static void
+Slice99_split_at(Slice99 self, size_t i, Slice99 *restrict lhs, Slice99 *restrict rhs) {
+    SLICE99_ASSERT(i <= self.len);
+    SLICE99_ASSERT(lhs);
+    SLICE99_ASSERT(rhs);
+
+    *lhs = Slice99_sub(self, 0, (ptrdiff_t)i);
+    *rhs = Slice99_sub(self, (ptrdiff_t)i, (ptrdiff_t)self.len);
+}
+
+/**
+ * Splits @p self into the unaligned head, the aligned body reinterpreted as items of @p item_size
+ * bytes, and the tail.
+ *
+ * `body->ptr` is the address of the first item of @p self that is a multiple of @p align, and
+ * `body->len` is the maximum count of items of @p item_size bytes that end at an item boundary of
+ * @p self. @p head and @p tail consist of the remaining items of @p self before and after the body.
+ * If no item of @p self is aligned, @p head is the whole @p self.
+ *
+ * @param[in] self The slice to be split.
+ * @param[in] align The required alignment of the body in bytes.
+ * @param[in] item_size The item size of the body.
+ * @param[out] head The items of @p self before the body.
+ * @param[out] body The aligned part of @p self with the item size @p item_size.
+ * @param[out] tail The items of @p self after the body.
+ *
+ * @pre @p align must be a power of two.
+ * @pre `item_size > 0`
+ * @pre `head != NULL`
+ * @pre `body != NULL`
+ * @pre `tail != NULL`
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ * #include <stdint.h>
+ *
+ * int main(void) {
+ *     uint64_t storage[4] = {0};
+ *     // An unaligned payload of 27 bytes.
+ *     const U8Slice99 payload = U8Slice99_new((uint8_t *)storage + 3, 27);
+ *
+ *     U8Slice99 head, tail;
+ *     Slice99 body;
+ *     U8Slice99_align_to(payload, sizeof(uint64_t), sizeof(uint64_t), &head, &body, &tail);
+ *
+ *     const U64Slice99 words = (U64Slice99)SLICE99_TO_TYPED(body);
+ *     assert(head.len == 5 && words.len == 2 && tail.len == 6);
+ * }
+ * @endcode
+ */
+inline static void Slice99_align_to(
+    Slice99 self, size_t align, size_t item_size, Slice99 *restrict head, Slice99 *restrict body,
+    Slice99 *restrict tail) {
+    SLICE99_ASSERT(align > 0 && (align & (align - 1)) == 0);
+    SLICE99_ASSERT(item_size > 0);
+    SLICE99_ASSERT(head);
+    SLICE99_ASSERT(body);
+    SLICE99_ASSERT(tail);
+
+    // The offset of an item from the next aligned address changes by `self.item_size` modulo
+    // `align` with every item, so it can become 0 only if it is a multiple of the largest power of
+    // two dividing both, and then it does so within `align` items.
+    size_t offset = slice99_priv_align_offset(self.ptr, align), head_len = self.len;
+    const size_t step = self.item_size & (0 - self.item_size), period = step < align ? step : align;
+
+    if (offset % period == 0) {
+        for (size_t i = 0; i < self.len; i++) {
+            if (offset == 0) {
+                head_len = i;
+                break;
+            }
+            offset = (offset - self.item_size) & (align - 1);
+        }
+    }
+
+    // The body must consist of a multiple of `multiple` items to end at an item boundary of `self`.
+    size_t a = self.item_size, b = item_size;
+    while (b != 0) {
+        const size_t r = a % b;
+        a = b;
+        b = r;
+    }
+    const size_t multiple = self.item_size / a;
+
+    const size_t rest_size = (self.len - head_len) * self.item_size;
+    const size_t body_len = rest_size / item_size / multiple * multiple,
+                 body_self_len = body_len * item_size / self.item_size;
+
+    *head = Slice99_update_len(self, head_len);
+    *body = Slice99_new(Slice99_get(self, (ptrdiff_t)head_len), item_size, body_len);
+    *tail = Slice99_advance(self, (ptrdiff_t)(head_len + body_self_len));
+}
+
+#ifndef DOXYGEN_IGNORE
+
+// Below this length, sorting falls back to insertion sort.
+#define SLICE99_PRIV_INSERTION_SORT_THRESHOLD 16
+
+struct slice99_priv_sort_ctx {
+    size_t item_size;
+    int (*cmp)(const void *, const void *);
+    void *backup;
+};
+
+inline static SLICE99_WARN_UNUSED_RESULT size_t slice99_priv_sort_depth(size_t len) {
+    size_t depth = 0;
+    for (; len > 1; len >>= 1) {
+        depth += 2;
+    }
+    return depth;
+}
+
+inline static void
+slice99_priv_sort_swap(const struct slice99_priv_sort_ctx *ctx, char *ptr, size_t i, size_t j) {
+    SLICE99_PRIV_DISPATCH_ITEM_SIZE(
+        ctx->item_size, ctx->backup, slice99_priv_swap_items, ptr + i * ctx->item_size,
+        ptr + j * ctx->item_size);
+}
+
+inline static SLICE99_WARN_UNUSED_RESULT int slice99_priv_sort_cmp(
+    const struct slice99_priv_sort_ctx *ctx, const char *ptr, size_t i, size_t j) {
+    return ctx->cmp(ptr + i * ctx->item_size, ptr + j * ctx->item_size);
+}
+
+inline static void
+slice99_priv_insertion_sort(const struct slice99_priv_sort_ctx *ctx, char *ptr, size_t len) {
+    for (size_t i = 1; i < len; i++) {
+        for (size_t j = i; j > 0 && slice99_priv_sort_cmp(ctx, ptr, j, j - 1) < 0; j--) {
+            slice99_priv_sort_swap(ctx, ptr, j, j - 1);
+        }
+    }
+}
+
+inline static void slice99_priv_sift_down(
+    const struct slice99_priv_sort_ctx *ctx, char *ptr, size_t root, size_t len) {
+    for (size_t child; (child = 2 * root + 1) < len; root = child) {
+        if (child + 1 < len && slice99_priv_sort_cmp(ctx, ptr, child, child + 1) < 0) {
+            child++;
+        }
+        if (slice99_priv_sort_cmp(ctx, ptr, root, child) >= 0) {
+            break;
+        }
+        slice99_priv_sort_swap(ctx, ptr, root, child);
+    }
+}
+
+inline static void
+slice99_priv_heap_sort(const struct slice99_priv_sort_ctx *ctx, char *ptr, size_t len) {
+    for (size_t i = len / 2; i > 0; i--) {
+        slice99_priv_sift_down(ctx, ptr, i - 1, len);
+    }
+    for (size_t i = len; i > 1; i--) {
+        slice99_priv_sort_swap(ctx, ptr, 0, i - 1);
+        slice99_priv_sift_down(ctx, ptr, 0, i - 1);
+    }
+}
+
+// Moves the median of three items to `ptr[0]` and partitions the rest around it, returning the
+// final index of the pivot.
+inline static SLICE99_WARN_UNUSED_RESULT size_t
+slice99_priv_partition(const struct slice99_priv_sort_ctx *ctx, char *ptr, size_t len) {
+    const size_t mid = len / 2, last = len - 1;
+
+    if (slice99_priv_sort_cmp(ctx, ptr, mid, 0) < 0) {
+        slice99_priv_sort_swap(ctx, ptr, mid, 0);
+    }
+    if (slice99_priv_sort_cmp(ctx, ptr, last, mid) < 0) {
+        slice99_priv_sort_swap(ctx, ptr, last, mid);
+        if (slice99_priv_sort_cmp(ctx, ptr, mid, 0) < 0) {
+            slice99_priv_sort_swap(ctx, ptr, mid, 0);
+        }
+    }
+    slice99_priv_sort_swap(ctx, ptr, 0, mid);
+
+    // Stopping at items equal to the pivot keeps partitions balanced on repeated items.
+    size_t i = 1, j = last;
+    for (;;) {
+        while (i <= j && slice99_priv_sort_cmp(ctx, ptr, i, 0) < 0) {
+            i++;
+        }
+        while (i <= j && slice99_priv_sort_cmp(ctx, ptr, j, 0) > 0) {
+            j--;
+        }
+        if (i >= j) {
+            break;
+        }
+        slice99_priv_sort_swap(ctx, ptr, i++, j--);
+    }
+
+    slice99_priv_sort_swap(ctx, ptr, 0, j);
+    return j;
+}
+
+inline static void
+slice99_priv_sort(const struct slice99_priv_sort_ctx *ctx, char *ptr, size_t len, size_t depth) {
+    while (len > SLICE99_PRIV_INSERTION_SORT_THRESHOLD) {
+        if (depth == 0) {
+            slice99_priv_heap_sort(ctx, ptr, len);
+            return;
+        }
+        depth--;
+
+        // Recurse into the smaller part and loop over the bigger one to bound the stack depth.
+        const size_t pivot = slice99_priv_partition(ctx, ptr, len);
+        if (pivot < len - pivot - 1) {
+            slice99_priv_sort(ctx, ptr, pivot, depth);
+            ptr += (pivot + 1) * ctx->item_size;
+            len -= pivot + 1;
+        } else {
+            slice99_priv_sort(ctx, ptr + (pivot + 1) * ctx->item_size, len - pivot - 1, depth);
+            len = pivot;
+        }
+    }
+
+    slice99_priv_insertion_sort(ctx, ptr, len);
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Sorts the items of @p self in ascending order.
+ *
+ * The algorithm is introsort: quicksort with the median-of-three pivot, falling back to heapsort
+ * when the recursion gets too deep, and to insertion sort for short subslices. It takes O(n log n)
+ * comparisons in the worst case and is not stable.
+ *
+ * For better performance, consider #SLICE99_DEF_TYPED_SORT, which inlines the comparator, or
+ * #SLICE99_DEF_TYPED_RADIX_SORT for integers.
+ *
+ * @param[out] self The slice to sort.
+ * @param[in] cmp The function that returns a negative integer, zero, or a positive integer if the
+ * first item is less than, equal to, or greater than the second one, respectively.
+ * @param[out] backup The memory area of `self.item_size` bytes accessible for reading and writing.
+ *
+ * @pre `cmp != NULL`
+ * @pre `backup != NULL`
+ */
+inline static void
+Slice99_sort(Slice99 self, int (*cmp)(const void *, const void *), void *restrict backup) {
+    SLICE99_ASSERT(cmp);
+    SLICE99_ASSERT(backup);
+
+    const struct slice99_priv_sort_ctx ctx = {
+        .item_size = self.item_size, .cmp = cmp, .backup = backup};
+    slice99_priv_sort(&ctx, (char *)self.ptr, self.len, slice99_priv_sort_depth(self.len));
+}
+
+/**
+ * Finds the first item of the sorted @p self that is not less than @p key.
+ *
+ * @param[in] self The slice sorted in ascending order according to @p cmp.
+ * @param[in] key The memory area of `self.item_size` bytes to be compared with.
+ * @param[in] cmp The function that compares two items, as in #Slice99_sort.
+ *
+ * @return The index of the found item, or `self.len` if all items are less than @p key.
+ *
+ * @pre `key != NULL`
+ * @pre `cmp != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT size_t
+Slice99_lower_bound(Slice99 self, const void *key, int (*cmp)(const void *, const void *)) {
+    SLICE99_ASSERT(key);
+    SLICE99_ASSERT(cmp);
+
+    if (self.len == 0) {
+        return 0;
+    }
+
+    // Halve the search range without branching on the comparison result.
+    const char *base = (const char *)self.ptr;
+    for (size_t len = self.len; len > 1;) {
+        const size_t half = len / 2;
+        base += cmp(base + half * self.item_size, key) < 0 ? half * self.item_size : 0;
+        len -= half;
+    }
+
+    return (size_t)(base - (const char *)self.ptr) / self.item_size + (cmp(base, key) < 0);
+}
+
+/**
+ * Finds the first item of the sorted @p self that is greater than @p key.
+ *
+ * @param[in] self The slice sorted in ascending order according to @p cmp.
+ * @param[in] key The memory area of `self.item_size` bytes to be compared with.
+ * @param[in] cmp The function that compares two items, as in #Slice99_sort.
+ *
+ * @return The index of the found item, or `self.len` if no item is greater than @p key.
+ *
+ * @pre `key != NULL`
+ * @pre `cmp != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT size_t
+Slice99_upper_bound(Slice99 self, const void *key, int (*cmp)(const void *, const void *)) {
+    SLICE99_ASSERT(key);
+    SLICE99_ASSERT(cmp);
+
+    if (self.len == 0) {
+        return 0;
+    }
+
+    const char *base = (const char *)self.ptr;
+    for (size_t len = self.len; len > 1;) {
+        const size_t half = len / 2;
+        base += cmp(key, base + half * self.item_size) >= 0 ? half * self.item_size : 0;
+        len -= half;
+    }
+
+    return (size_t)(base - (const char *)self.ptr) / self.item_size + (cmp(key, base) >= 0);
+}
+
+/**
+ * Finds an item of the sorted @p self equal to @p key.
+ *
+ * @param[in] self The slice sorted in ascending order according to @p cmp.
+ * @param[in] key The memory area of `self.item_size` bytes to be found.
+ * @param[in] cmp The function that compares two items, as in #Slice99_sort.
+ *
+ * @return The index of the first item equal to @p key or -1 if there is no such item.
+ *
+ * @pre `key != NULL`
+ * @pre `cmp != NULL`
+ * @pre `self.len` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT ptrdiff_t
+Slice99_bsearch(Slice99 self, const void *key, int (*cmp)(const void *, const void *)) {
+    const size_t i = Slice99_lower_bound(self, key, cmp);
+    return i < self.len && cmp(Slice99_get(self, (ptrdiff_t)i), key) == 0 ? (ptrdiff_t)i : -1;
+}
+
+#ifndef DOXYGEN_IGNORE
+
+// Reads little-endian integers, so that hashes do not depend on the byte order of the platform.
+// Compilers recognise these patterns as single loads on little-endian targets.
+
+inline static SLICE99_ALWAYS_INLINE uint64_t slice99_priv_hash_read4(const unsigned char *p) {
+    return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24;
+}
+
+inline static SLICE99_ALWAYS_INLINE uint64_t slice99_priv_hash_read8(const unsigned char *p) {
+    return slice99_priv_hash_read4(p) | slice99_priv_hash_read4(p + 4) << 32;
+}
+
+// Multiplies `*a` and `*b` into a 128-bit product, storing its low half to `*a` and its high half
+// to `*b`.
+inline static SLICE99_ALWAYS_INLINE void slice99_priv_mum(uint64_t *a, uint64_t *b) {
+#ifdef __SIZEOF_INT128__
+    __extension__ const unsigned __int128 r = (unsigned __int128)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    const uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+    uint64_t lo = t + (rm1 << 32), hi = rh + (rm0 >> 32) + (rm1 >> 32);
+    hi += (t < rl) + (lo < t);
+    *a = lo;
+    *b = hi;
+#endif
+}
+
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST uint64_t
+slice99_priv_mix(uint64_t a, uint64_t b) {
+    slice99_priv_mum(&a, &b);
+    return a ^ b;
+}
+
+// Takes the bytes as separate arguments, which are passed in registers, unlike a `Slice99`.
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE uint64_t
+slice99_priv_hash(const void *ptr, size_t len, uint64_t seed) {
+    static const uint64_t secret[4] = {
+        UINT64_C(0x2d358dccaa6c78a5), UINT64_C(0x8bb84b93962eacc9), UINT64_C(0x4b33a62ed433d4a3),
+        UINT64_C(0x4d5a2da51de1aa47)};
+
+    const unsigned char *p = (const unsigned char *)ptr;
+    uint64_t a, b;
+
+    seed ^= slice99_priv_mix(seed ^ secret[0], secret[1]);
+
+    if (len <= 16) {
+        if (len >= 4) {
+            const size_t mid = (len >> 3) << 2;
+            a = (slice99_priv_hash_read4(p) << 32) | slice99_priv_hash_read4(p + mid);
+            b = (slice99_priv_hash_read4(p + len - 4) << 32) |
+                slice99_priv_hash_read4(p + len - 4 - mid);
+        } else if (len > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t seed1 = seed, seed2 = seed;
+            do {
+                seed = slice99_priv_mix(
+                    slice99_priv_hash_read8(p) ^ secret[1], slice99_priv_hash_read8(p + 8) ^ seed);
+                seed1 = slice99_priv_mix(
+                    slice99_priv_hash_read8(p + 16) ^ secret[2],
+                    slice99_priv_hash_read8(p + 24) ^ seed1);
+                seed2 = slice99_priv_mix(
+                    slice99_priv_hash_read8(p + 32) ^ secret[3],
+                    slice99_priv_hash_read8(p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (i > 16) {
+            seed = slice99_priv_mix(
+                slice99_priv_hash_read8(p) ^ secret[1], slice99_priv_hash_read8(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+
+        a = slice99_priv_hash_read8(p + i - 16);
+        b = slice99_priv_hash_read8(p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    slice99_priv_mum(&a, &b);
+    return slice99_priv_mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Computes a 64-bit non-cryptographic hash of the bytes of @p self.
+ *
+ * The algorithm is wyhash (final version 4), which processes 48 bytes per iteration with 64x64-bit
+ * multiplications and handles short inputs without loops. Only the bytes of @p self are hashed, so
+ * slices of different item sizes but with the same bytes have the same hash.
+ *
+ * The result depends only on the bytes and @p seed: it is the same on all platforms and will not
+ * change in future versions of Slice99, so it can be persisted and exchanged between processes. It
+ * must not be used where collisions can be forced by an adversary, unless @p seed is secret.
+ *
+ * @param[in] self The slice to hash.
+ * @param[in] seed The seed value.
+ *
+ * @return The hash value.
+ */
+inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT SLICE99_PURE uint64_t
+Slice99_primitive_hash(Slice99 self, uint64_t seed) {
+    return slice99_priv_hash(self.ptr, Slice99_size(self), seed);
+}
+
+/**
+ * Computes the CRC-32C (Castagnoli) checksum of the bytes of @p self.
+ *
+ * The checksum is computed with the SSE4.2 `crc32` instruction when compiling for x86-64 with
+ * `-msse4.2` (or a `-march` implying it), with the ARMv8 CRC32 instructions when compiling with
+ * `__ARM_FEATURE_CRC32`, and with a lookup table otherwise. Define `SLICE99_DISABLE_SIMD` to
+ * always use the lookup table. All implementations return the same values.
+ *
+ * @param[in] self The slice to checksum.
+ * @param[in] crc The checksum of the preceding data, or 0 to start a new checksum. This allows to
+ * compute the checksum of data split into several slices.
+ *
+ * @return The checksum of the data preceding @p self (described by @p crc) followed by @p self.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * int main(void) {
+ *     uint32_t crc = Slice99_crc32c(Slice99_from_str("1234"), 0);
+ *     crc = Slice99_crc32c(Slice99_from_str("56789"), crc);
+ *     assert(crc == 0xE3069283);
+ * }
+ * @endcode
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE uint32_t
+Slice99_crc32c(Slice99 self, uint32_t crc) {
+    const unsigned char *p = (const unsigned char *)self.ptr;
+    size_t len = Slice99_size(self);
+
+    crc = ~crc;
+
+#if defined(SLICE99_PRIV_SSE42)
+    uint64_t crc64 = crc;
+    for (; len >= 8; len -= 8, p += 8) {
+        crc64 = _mm_crc32_u64(crc64, slice99_priv_hash_read8(p));
+    }
+    crc = (uint32_t)crc64;
+    for (; len > 0; len--, p++) {
+        crc = _mm_crc32_u8(crc, *p);
+    }
+#elif defined(SLICE99_PRIV_ARM_CRC32)
+    for (; len >= 8; len -= 8, p += 8) {
+        crc = __crc32cd(crc, slice99_priv_hash_read8(p));
+    }
+    for (; len > 0; len--, p++) {
+        crc = __crc32cb(crc, *p);
+    }
+#else
+    // The reflected polynomial 0x82F63B78.
+    static const uint32_t table[256] = {
+        0x00000000, 0xF26B8303, 0xE13B70F7, 0x1350F3F4, 0xC79A971F, 0x35F1141C, 0x26A1E7E8,
+        0xD4CA64EB, 0x8AD958CF, 0x78B2DBCC, 0x6BE22838, 0x9989AB3B, 0x4D43CFD0, 0xBF284CD3,
+        0xAC78BF27, 0x5E133C24, 0x105EC76F, 0xE235446C, 0xF165B798, 0x030E349B, 0xD7C45070,
+        0x25AFD373, 0x36FF2087, 0xC494A384, 0x9A879FA0, 0x68EC1CA3, 0x7BBCEF57, 0x89D76C54,
+        0x5D1D08BF, 0xAF768BBC, 0xBC267848, 0x4E4DFB4B, 0x20BD8EDE, 0xD2D60DDD, 0xC186FE29,
+        0x33ED7D2A, 0xE72719C1, 0x154C9AC2, 0x061C6936, 0xF477EA35, 0xAA64D611, 0x580F5512,
+        0x4B5FA6E6, 0xB93425E5, 0x6DFE410E, 0x9F95C20D, 0x8CC531F9, 0x7EAEB2FA, 0x30E349B1,
+        0xC288CAB2, 0xD1D83946, 0x23B3BA45, 0xF779DEAE, 0x05125DAD, 0x1642AE59, 0xE4292D5A,
+        0xBA3A117E, 0x4851927D, 0x5B016189, 0xA96AE28A, 0x7DA08661, 0x8FCB0562, 0x9C9BF696,
+        0x6EF07595, 0x417B1DBC, 0xB3109EBF, 0xA0406D4B, 0x522BEE48, 0x86E18AA3, 0x748A09A0,
+        0x67DAFA54, 0x95B17957, 0xCBA24573, 0x39C9C670, 0x2A993584, 0xD8F2B687, 0x0C38D26C,
+        0xFE53516F, 0xED03A29B, 0x1F682198, 0x5125DAD3, 0xA34E59D0, 0xB01EAA24, 0x42752927,
+        0x96BF4DCC, 0x64D4CECF, 0x77843D3B, 0x85EFBE38, 0xDBFC821C, 0x2997011F, 0x3AC7F2EB,
+        0xC8AC71E8, 0x1C661503, 0xEE0D9600, 0xFD5D65F4, 0x0F36E6F7, 0x61C69362, 0x93AD1061,
+        0x80FDE395, 0x72966096, 0xA65C047D, 0x5437877E, 0x4767748A, 0xB50CF789, 0xEB1FCBAD,
+        0x197448AE, 0x0A24BB5A, 0xF84F3859, 0x2C855CB2, 0xDEEEDFB1, 0xCDBE2C45, 0x3FD5AF46,
+        0x7198540D, 0x83F3D70E, 0x90A324FA, 0x62C8A7F9, 0xB602C312, 0x44694011, 0x5739B3E5,
+        0xA55230E6, 0xFB410CC2, 0x092A8FC1, 0x1A7A7C35, 0xE811FF36, 0x3CDB9BDD, 0xCEB018DE,
+        0xDDE0EB2A, 0x2F8B6829, 0x82F63B78, 0x709DB87B, 0x63CD4B8F, 0x91A6C88C, 0x456CAC67,
+        0xB7072F64, 0xA457DC90, 0x563C5F93, 0x082F63B7, 0xFA44E0B4, 0xE9141340, 0x1B7F9043,
+        0xCFB5F4A8, 0x3DDE77AB, 0x2E8E845F, 0xDCE5075C, 0x92A8FC17, 0x60C37F14, 0x73938CE0,
+        0x81F80FE3, 0x55326B08, 0xA759E80B, 0xB4091BFF, 0x466298FC, 0x1871A4D8, 0xEA1A27DB,
+        0xF94AD42F, 0x0B21572C, 0xDFEB33C7, 0x2D80B0C4, 0x3ED04330, 0xCCBBC033, 0xA24BB5A6,
+        0x502036A5, 0x4370C551, 0xB11B4652, 0x65D122B9, 0x97BAA1BA, 0x84EA524E, 0x7681D14D,
+        0x2892ED69, 0xDAF96E6A, 0xC9A99D9E, 0x3BC21E9D, 0xEF087A76, 0x1D63F975, 0x0E330A81,
+        0xFC588982, 0xB21572C9, 0x407EF1CA, 0x532E023E, 0xA145813D, 0x758FE5D6, 0x87E466D5,
+        0x94B49521, 0x66DF1622, 0x38CC2A06, 0xCAA7A905, 0xD9F75AF1, 0x2B9CD9F2, 0xFF56BD19,
+        0x0D3D3E1A, 0x1E6DCDEE, 0xEC064EED, 0xC38D26C4, 0x31E6A5C7, 0x22B65633, 0xD0DDD530,
+        0x0417B1DB, 0xF67C32D8, 0xE52CC12C, 0x1747422F, 0x49547E0B, 0xBB3FFD08, 0xA86F0EFC,
+        0x5A048DFF, 0x8ECEE914, 0x7CA56A17, 0x6FF599E3, 0x9D9E1AE0, 0xD3D3E1AB, 0x21B862A8,
+        0x32E8915C, 0xC083125F, 0x144976B4, 0xE622F5B7, 0xF5720643, 0x07198540, 0x590AB964,
+        0xAB613A67, 0xB831C993, 0x4A5A4A90, 0x9E902E7B, 0x6CFBAD78, 0x7FAB5E8C, 0x8DC0DD8F,
+        0xE330A81A, 0x115B2B19, 0x020BD8ED, 0xF0605BEE, 0x24AA3F05, 0xD6C1BC06, 0xC5914FF2,
+        0x37FACCF1, 0x69E9F0D5, 0x9B8273D6, 0x88D28022, 0x7AB90321, 0xAE7367CA, 0x5C18E4C9,
+        0x4F48173D, 0xBD23943E, 0xF36E6F75, 0x0105EC76, 0x12551F82, 0xE03E9C81, 0x34F4F86A,
+        0xC69F7B69, 0xD5CF889D, 0x27A40B9E, 0x79B737BA, 0x8BDCB4B9, 0x988C474D, 0x6AE7C44E,
+        0xBE2DA0A5, 0x4C4623A6, 0x5F16D052, 0xAD7D5351
+    };
+
+    for (; len > 0; len--, p++) {
+        crc = table[(crc ^ *p) & 0xFF] ^ (crc >> 8);
+    }
+#endif
+
+    return ~crc;
+}
+
+#ifndef DOXYGEN_IGNORE
+
+enum {
+    SLICE99_PRIV_SPLIT_BY_ITEM,
+    SLICE99_PRIV_SPLIT_BY_SLICE,
+    SLICE99_PRIV_SPLIT_BY_ANY,
+};
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * An iterator over subslices separated by a delimiter.
+ *
+ * This structure should not be constructed manually and its fields should not be accessed
+ * directly; use #Slice99SplitIter_by_item, #Slice99SplitIter_by_slice, #Slice99SplitIter_by_any,
+ * and #Slice99SplitIter_next instead. The iterator does not allocate: every yielded subslice points
+ * into the original slice.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * int main(void) {
+ *     Slice99SplitIter iter = Slice99SplitIter_by_item(Slice99_from_str("a,b,,c"), ",");
+ *     Slice99 field;
+ *
+ *     while (Slice99SplitIter_next(&iter, &field)) {
+ *         // "a", "b", "", "c"
+ *     }
+ * }
+ * @endcode
+ */
+typedef struct {
+    /**
+     * The part of the original slice that has not been yielded yet.
+     */
+    Slice99 rest;
+
+    /**
+     * The item, the delimiter, or the set of items, depending on the constructor.
+     */
+    Slice99 delimiter;
+
+    /**
+     * The membership bitmap of #delimiter if it is a set of bytes: byte `b` is in the set if bit
+     * `(b >> 4) & 7` of `byte_set[(b >> 7) * 16 + (b & 15)]` is set. Thus, each half is a table
+     * indexed by the low nibble, which SSSE3 looks up 16 bytes at a time.
+     */
+    unsigned char byte_set[32];
+
+    /**
+     * The kind of the delimiter.
+     */
+    int kind;
+
+    /**
+     * Whether the last subslice has been yielded.
+     */
+    bool finished;
+} Slice99SplitIter;
+
+/**
+ * Constructs an iterator over subslices of @p self separated by @p item.
+ *
+ * Two consecutive delimiters yield an empty subslice in between, as well as delimiters at the
+ * beginning and at the end of @p self.
+ *
+ * @param[in] self The slice to be splitted.
+ * @param[in] item The memory area of `self.item_size` bytes separating subslices (compared
+ * byte-by-byte). It must outlive the iterator.
+ *
+ * @pre `item != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99SplitIter
+Slice99SplitIter_by_item(Slice99 self, const void *item) {
+    SLICE99_ASSERT(item);
+
+    Slice99SplitIter iter = {
+        .rest = self,
+        .delimiter = Slice99_new((void *)(uintptr_t)item, self.item_size, 1),
+        .kind = SLICE99_PRIV_SPLIT_BY_ITEM,
+        .finished = false,
+    };
+    return iter;
+}
+
+/**
+ * Constructs an iterator over subslices of @p self separated by @p delimiter.
+ *
+ * The same as #Slice99SplitIter_by_item but the delimiter is a whole slice (compared
+ * byte-by-byte), which must outlive the iterator.
+ *
+ * @pre `self.item_size == delimiter.item_size`
+ * @pre `delimiter.len > 0`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99SplitIter
+Slice99SplitIter_by_slice(Slice99 self, Slice99 delimiter) {
+    SLICE99_ASSERT(self.item_size == delimiter.item_size);
+    SLICE99_ASSERT(delimiter.len > 0);
+
+    Slice99SplitIter iter = {
+        .rest = self,
+        .delimiter = delimiter,
+        .kind = delimiter.len == 1 ? SLICE99_PRIV_SPLIT_BY_ITEM : SLICE99_PRIV_SPLIT_BY_SLICE,
+        .finished = false,
+    };
+    return iter;
+}
+
+/**
+ * Constructs an iterator over subslices of @p self separated by any item of @p set.
+ *
+ * The same as #Slice99SplitIter_by_item but any item of @p set (compared byte-by-byte) is a
+ * delimiter. If the items are bytes, membership is tested with a precomputed bitmap, 16 bytes at a
+ * time with SSSE3. @p set must outlive the iterator.
+ *
+ * @pre `self.item_size == set.item_size`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99SplitIter
+Slice99SplitIter_by_any(Slice99 self, Slice99 set) {
+    SLICE99_ASSERT(self.item_size == set.item_size);
+
+    Slice99SplitIter iter = {
+        .rest = self,
+        .delimiter = set,
+        .kind = set.len == 1 ? SLICE99_PRIV_SPLIT_BY_ITEM : SLICE99_PRIV_SPLIT_BY_ANY,
+        .finished = false,
+    };
+
+    if (set.item_size == 1) {
+        for (size_t i = 0; i < set.len; i++) {
+            const unsigned char byte = ((const unsigned char *)set.ptr)[i];
+            iter.byte_set[(byte >> 7) * 16 + (byte & 15)] |=
+                (unsigned char)(1u << ((byte >> 4) & 7));
+        }
+    }
+
+    return iter;
+}
+
+#ifndef DOXYGEN_IGNORE
+
+// Returns the index of the first byte of `p[0..n)` in `byte_set` (see `Slice99SplitIter`), or -1.
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE ptrdiff_t
+slice99_priv_find_byte_set(const unsigned char *p, size_t n, const unsigned char byte_set[32]) {
+    size_t i = 0;
+
+#ifdef SLICE99_PRIV_SSSE3
+    // The row of the low nibble is selected by the top bit, and its bit by the other three bits of
+    // the high nibble.
+    const __m128i rows_lo = _mm_loadu_si128((const __m128i *)(const void *)byte_set),
+                  rows_hi = _mm_loadu_si128((const __m128i *)(const void *)(byte_set + 16));
+    const __m128i bits = _mm_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, (char)128, 1, 2, 4, 8, 16, 32, 64, (char)128);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+
+    for (; n - i >= 16; i += 16) {
+        const __m128i block = _mm_loadu_si128((const __m128i *)(const void *)(p + i));
+        const __m128i lo = _mm_and_si128(block, nibble),
+                      hi = _mm_and_si128(_mm_srli_epi16(block, 4), nibble);
+
+        const __m128i is_hi = _mm_cmpgt_epi8(hi, _mm_set1_epi8(7));
+        const __m128i row = _mm_or_si128(
+            _mm_and_si128(is_hi, _mm_shuffle_epi8(rows_hi, lo)),
+            _mm_andnot_si128(is_hi, _mm_shuffle_epi8(rows_lo, lo)));
+        const __m128i bit = _mm_shuffle_epi8(bits, hi);
+
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(row, bit), bit));
+        if (mask != 0) {
+            return (ptrdiff_t)(i + (size_t)__builtin_ctz((unsigned)mask));
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        if (byte_set[(p[i] >> 7) * 16 + (p[i] & 15)] & (1u << ((p[i] >> 4) & 7))) {
+            return (ptrdiff_t)i;
+        }
+    }
+
+    return -1;
+}
+
+inline static SLICE99_WARN_UNUSED_RESULT ptrdiff_t
+slice99_priv_split_find_any(const Slice99SplitIter *self) {
+    if (self->rest.item_size == 1) {
+        return slice99_priv_find_byte_set(
+            (const unsigned char *)self->rest.ptr, self->rest.len, self->byte_set);
+    }
+
+    for (ptrdiff_t i = 0; i < (ptrdiff_t)self->rest.len; i++) {
+        if (Slice99_primitive_find_item(self->delimiter, Slice99_get(self->rest, i)) != -1) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Yields the next subslice.
+ *
+ * @param[in,out] self The iterator.
+ * @param[out] out The location to which the next subslice will be written.
+ *
+ * @return `true` if a subslice has been written to @p out, `false` if the iterator is exhausted.
+ *
+ * @pre `self != NULL`
+ * @pre `out != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99SplitIter_next(Slice99SplitIter *restrict self, Slice99 *restrict out) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(out);
+
+    if (self->finished) {
+        return false;
+    }
+
+    ptrdiff_t idx;
+    switch (self->kind) {
+    case SLICE99_PRIV_SPLIT_BY_ITEM:
+        idx = Slice99_primitive_find_item(self->rest, self->delimiter.ptr);
+        break;
+    case SLICE99_PRIV_SPLIT_BY_SLICE:
+        idx = Slice99_primitive_find(self->rest, self->delimiter);
+        break;
+    default:
+        idx = slice99_priv_split_find_any(self);
+        break;
+    }
+
+    if (idx == -1) {
+        *out = self->rest;
+        self->rest = Slice99_advance(self->rest, (ptrdiff_t)self->rest.len);
+        self->finished = true;
+        return true;
+    }
+
+    const size_t delimiter_len =
+        self->kind == SLICE99_PRIV_SPLIT_BY_SLICE ? self->delimiter.len : 1;
+
+    *out = Slice99_sub(self->rest, 0, idx);
+    self->rest = Slice99_advance(self->rest, idx + (ptrdiff_t)delimiter_len);
+    return true;
+}
+
+/**
+ * Copies @p self to @p out and appends '\0' to the end.
+ *
+ * @param[in] self The slice that will be copied.
+ * @param[in] out The memory area to which @p self and the null character will be copied.
+ *
+ * @return The pointer @p out.
+ *
+ * @pre @p out must be capable of writing `Slice99_size(self) + 1` bytes.
+ * @pre @p out must not overlap with @p self.
+ */
+inline static char *Slice99_c_str(Slice99 self, char out[restrict]) {
+    SLICE99_ASSERT(out);
+
+    SLICE99_MEMCPY(out, self.ptr, Slice99_size(self));
+    out[Slice99_size(self)] = '\0';
+    return out;
+}
+
+/**
+ * A view of items spaced at a constant distance, which may differ from the item size.
+ *
+ * A column of a row-major matrix, a field of an array of structures, or every n-th item of a
+ * slice can be viewed without copying it into a packed temporary. Use #SLICE99_FIELD to view a
+ * structure field.
+ *
+ * This structure should not be constructed manually; use #Slice99Strided_new instead.
+ *
+ * @invariant #ptr must not be `NULL`.
+ * @invariant #item_size must be strictly greater than 0.
+ */
+typedef struct {
+    /**
+     * The pointer to the first item.
+     */
+    void *ptr;
+
+    /**
+     * The size of each item.
+     */
+    size_t item_size;
+
+    /**
+     * The distance between consecutive items, in bytes. Can be negative.
+     */
+    ptrdiff_t stride;
+
+    /**
+     * The count of items.
+     */
+    size_t len;
+} Slice99Strided;
+
+/**
+ * Constructs a strided view.
+ *
+ * @param[in] ptr The value of Slice99Strided#ptr.
+ * @param[in] item_size The value of Slice99Strided#item_size.
+ * @param[in] stride The value of Slice99Strided#stride.
+ * @param[in] len The value of Slice99Strided#len.
+ *
+ * @pre `ptr != NULL`
+ * @pre `item_size > 0`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Strided
+Slice99Strided_new(void *ptr, size_t item_size, ptrdiff_t stride, size_t len) {
+    SLICE99_ASSERT(ptr);
+    SLICE99_ASSERT(item_size > 0);
+
+    const Slice99Strided result = {
+        .ptr = ptr,
+        .item_size = item_size,
+        .stride = stride,
+        .len = len,
+    };
+    return result;
+}
+
+/**
+ * Constructs a strided view of the contiguous @p self.
+ *
+ * @param[in] self The viewed slice.
+ *
+ * @pre `self.item_size` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Strided Slice99Strided_from_slice(Slice99 self) {
+    return Slice99Strided_new(self.ptr, self.item_size, (ptrdiff_t)self.item_size, self.len);
+}
+
+/**
+ * Constructs a strided view of the @p size -byte fields at @p offset of the items of @p self.
+ *
+ * @param[in] self The slice of structures.
+ * @param[in] offset The offset of the field within an item.
+ * @param[in] size The size of the field.
+ *
+ * @pre `size > 0`
+ * @pre `offset + size <= self.item_size`
+ * @pre `self.item_size` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Strided
+Slice99_field(Slice99 self, size_t offset, size_t size) {
+    SLICE99_ASSERT(size <= self.item_size && offset <= self.item_size - size);
+
+    return Slice99Strided_new(
+        (char *)self.ptr + offset, size, (ptrdiff_t)self.item_size, self.len);
+}
+
+/**
+ * Constructs a strided view of the @p field fields of the slice of @p type structures @p self.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * typedef struct {
+ *     int id;
+ *     double price;
+ * } Item;
+ *
+ * int main(void) {
+ *     Item items[] = {{1, 2.5}, {2, 10.0}, {3, 0.5}};
+ *     const Slice99Strided prices = SLICE99_FIELD(Slice99_from_array(items), Item, price);
+ *
+ *     assert(prices.len == 3);
+ *     assert(*(double *)Slice99Strided_get(prices, 1) == 10.0);
+ * }
+ * @endcode
+ */
+#define SLICE99_FIELD(self, type, field)                                                           \
+    Slice99_field((self), offsetof(type, field), sizeof(((type *)0)->field))
+
+/**
+ * Checks whether the items of @p self are packed contiguously.
+ *
+ * @param[in] self The checked view.
+ *
+ * @return `true` if `self.stride` is equal to `self.item_size` or @p self has at most one item,
+ * `false` otherwise.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST bool
+Slice99Strided_is_contiguous(Slice99Strided self) {
+    return self.len <= 1 || (self.stride > 0 && (size_t)self.stride == self.item_size);
+}
+
+/**
+ * Converts the contiguous @p self to #Slice99.
+ *
+ * @param[in] self The converted view.
+ *
+ * @pre `Slice99Strided_is_contiguous(self)`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99 Slice99Strided_to_slice(Slice99Strided self) {
+    SLICE99_ASSERT(Slice99Strided_is_contiguous(self));
+
+    return Slice99_new(self.ptr, self.item_size, self.len);
+}
+
+/**
+ * Computes a pointer to the @p i -indexed item.
+ *
+ * @param[in] self The view upon which the pointer will be computed.
+ * @param[in] i The index of a desired item. Can be negative.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST void *
+Slice99Strided_get(Slice99Strided self, ptrdiff_t i) {
+    return (void *)((char *)self.ptr + i * self.stride);
+}
+
+/**
+ * Subviewing @p self with [@p start_idx `..` @p end_idx].
+ *
+ * @param[in] self The original view.
+ * @param[in] start_idx The index at which a new view will reside, inclusively.
+ * @param[in] end_idx The index at which a new view will end, exclusively.
+ *
+ * @return A view with the aforementioned properties.
+ *
+ * @pre `start_idx <= end_idx`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Strided
+Slice99Strided_sub(Slice99Strided self, ptrdiff_t start_idx, ptrdiff_t end_idx) {
+    SLICE99_ASSERT(start_idx <= end_idx);
+
+    return Slice99Strided_new(
+        Slice99Strided_get(self, start_idx), self.item_size, self.stride,
+        (size_t)(end_idx - start_idx));
+}
+
+/**
+ * Constructs a view of every @p step -th item of @p self, starting with the first one.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     int data[] = {1, 2, 3, 4, 5};
+ *     const Slice99Strided odd = Slice99Strided_step_by(
+ *         Slice99Strided_from_slice(Slice99_from_array(data)), 2);
+ *
+ *     assert(odd.len == 3);
+ *     assert(*(int *)Slice99Strided_get(odd, 2) == 5);
+ * }
+ * @endcode
+ *
+ * @param[in] self The original view.
+ * @param[in] step The distance between the viewed items, in items.
+ *
+ * @pre `step > 0`
+ * @pre `self.stride * step` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Strided
+Slice99Strided_step_by(Slice99Strided self, size_t step) {
+    SLICE99_ASSERT(step > 0);
+
+    return Slice99Strided_new(
+        self.ptr, self.item_size, self.stride * (ptrdiff_t)step, (self.len + step - 1) / step);
+}
+
+#ifndef DOXYGEN_IGNORE
+
+// When `item_size` is a compile-time constant (see `SLICE99_PRIV_STRIDED_DISPATCH`), the item
+// accesses reduce to plain loads and stores of the corresponding width.
+
+inline static SLICE99_ALWAYS_INLINE void slice99_priv_strided_copy(
+    char *dst, ptrdiff_t dst_stride, const char *src, ptrdiff_t src_stride, size_t len,
+    size_t item_size) {
+    for (size_t i = 0; i < len; i++, dst += dst_stride, src += src_stride) {
+        SLICE99_MEMCPY(dst, src, item_size);
+    }
+}
+
+inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT bool slice99_priv_strided_eq(
+    const char *lhs, ptrdiff_t lhs_stride, const char *rhs, ptrdiff_t rhs_stride, size_t len,
+    size_t item_size) {
+    for (size_t i = 0; i < len; i++, lhs += lhs_stride, rhs += rhs_stride) {
+        if (SLICE99_MEMCMP(lhs, rhs, item_size) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#define SLICE99_PRIV_STRIDED_DISPATCH(item_size, f, ...)                                           \
+    ((item_size) == 1   ? f(__VA_ARGS__, 1)                                                        \
+     : (item_size) == 2 ? f(__VA_ARGS__, 2)                                                        \
+     : (item_size) == 4 ? f(__VA_ARGS__, 4)                                                        \
+     : (item_size) == 8 ? f(__VA_ARGS__, 8)                                                        \
+                        : f(__VA_ARGS__, (item_size)))
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Copies the items of @p other to the first `other.len` items of @p self.
+ *
+ * If both views are contiguous, this is #Slice99_copy.
+ *
+ * @param[out] self The view to which the items of @p other will be copied.
+ * @param[in] other The view to be copied to @p self.
+ *
+ * @pre `self.item_size == other.item_size`
+ * @pre `self.len >= other.len`
+ * @pre Unless both views are contiguous, the items of @p self and @p other must not overlap.
+ */
+inline static void Slice99Strided_copy(Slice99Strided self, Slice99Strided other) {
+    SLICE99_ASSERT(self.item_size == other.item_size);
+    SLICE99_ASSERT(self.len >= other.len);
+
+    if (Slice99Strided_is_contiguous(self) && Slice99Strided_is_contiguous(other)) {
+        Slice99_copy(
+            Slice99_new(self.ptr, self.item_size, self.len),
+            Slice99_new(other.ptr, other.item_size, other.len));
+        return;
+    }
+
+    SLICE99_PRIV_STRIDED_DISPATCH(
+        other.item_size, slice99_priv_strided_copy, (char *)self.ptr, self.stride,
+        (const char *)other.ptr, other.stride, other.len);
+}
+
+/**
+ * Performs a byte-by-byte comparison of the items of @p lhs with the items of @p rhs.
+ *
+ * If both views are contiguous, this is #Slice99_primitive_eq.
+ *
+ * @param[in] lhs The first view to be compared.
+ * @param[in] rhs The second view to be compared.
+ *
+ * @return `true` if @p lhs and @p rhs have the same item size, length, and items, `false`
+ * otherwise.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99Strided_primitive_eq(Slice99Strided lhs, Slice99Strided rhs) {
+    if (lhs.item_size != rhs.item_size || lhs.len != rhs.len) {
+        return false;
+    }
+
+    if (Slice99Strided_is_contiguous(lhs) && Slice99Strided_is_contiguous(rhs)) {
+        return Slice99_primitive_eq(
+            Slice99_new(lhs.ptr, lhs.item_size, lhs.len),
+            Slice99_new(rhs.ptr, rhs.item_size, rhs.len));
+    }
+
+    return SLICE99_PRIV_STRIDED_DISPATCH(
+        lhs.item_size, slice99_priv_strided_eq, (const char *)lhs.ptr, lhs.stride,
+        (const char *)rhs.ptr, rhs.stride, lhs.len);
+}
+
+/**
+ * Copies the items of @p self to the contiguous @p out.
+ *
+ * Together with #SLICE99_FIELD, this converts a field of an array of structures into a packed
+ * array. Items of 1, 2, 4, and 8 bytes are copied as plain loads and stores.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * typedef struct {
+ *     int id;
+ *     double price;
+ * } Item;
+ *
+ * int main(void) {
+ *     Item items[] = {{1, 2.5}, {2, 10.0}, {3, 0.5}};
+ *     double prices[3];
+ *
+ *     Slice99Strided_gather(
+ *         SLICE99_FIELD(Slice99_from_array(items), Item, price), Slice99_from_array(prices));
+ *     assert(prices[0] == 2.5 && prices[1] == 10.0 && prices[2] == 0.5);
+ *
+ *     prices[1] = 9.0;
+ *     Slice99Strided_scatter(
+ *         SLICE99_FIELD(Slice99_from_array(items), Item, price), Slice99_from_array(prices));
+ *     assert(items[1].price == 9.0);
+ * }
+ * @endcode
+ *
+ * @param[in] self The view to be copied.
+ * @param[out] out The slice to the beginning of which the items will be copied.
+ *
+ * @pre `self.item_size == out.item_size`
+ * @pre `self.len <= out.len`
+ * @pre The items of @p self and @p out must not overlap.
+ */
+inline static void Slice99Strided_gather(Slice99Strided self, Slice99 out) {
+    Slice99Strided_copy(Slice99Strided_from_slice(out), self);
+}
+
+/**
+ * Copies the first `self.len` items of the contiguous @p in to @p self.
+ *
+ * This is the inverse of #Slice99Strided_gather.
+ *
+ * @param[out] self The view to which the items will be copied.
+ * @param[in] in The slice to be copied.
+ *
+ * @pre `self.item_size == in.item_size`
+ * @pre `self.len <= in.len`
+ * @pre The items of @p self and @p in must not overlap.
+ */
+inline static void Slice99Strided_scatter(Slice99Strided self, Slice99 in) {
+    SLICE99_ASSERT(self.len <= in.len);
+
+    Slice99Strided_copy(self, Slice99Strided_from_slice(Slice99_update_len(in, self.len)));
+}
+
+/**
+ * A two-dimensional view of `rows` x `cols` items in row-major order.
+ *
+ * The rows are contiguous slices, which may be followed by padding; the columns are strided
+ * views. A column-major matrix is viewed with its rows and columns swapped, so that its columns
+ * are the contiguous slices.
+ *
+ * This structure should not be constructed manually; use #Slice99Matrix_new or
+ * #Slice99Matrix_with_stride instead.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     int data[] = {
+ *         1, 2, 3,
+ *         4, 5, 6,
+ *     };
+ *     const Slice99Matrix m = Slice99Matrix_from_slice(Slice99_from_array(data), 3);
+ *
+ *     assert(m.rows == 2 && m.cols == 3);
+ *     assert(*(int *)Slice99Matrix_get(m, 1, 2) == 6);
+ *
+ *     const Slice99Strided col = Slice99Matrix_col(m, 1);
+ *     assert(col.len == 2);
+ *     assert(*(int *)Slice99Strided_get(col, 0) == 2);
+ *     assert(*(int *)Slice99Strided_get(col, 1) == 5);
+ * }
+ * @endcode
+ *
+ * @invariant #ptr must not be `NULL`.
+ * @invariant #item_size must be strictly greater than 0.
+ * @invariant `row_stride >= cols * item_size`
+ */
+typedef struct {
+    /**
+     * The pointer to the first item of the first row.
+     */
+    void *ptr;
+
+    /**
+     * The size of each item.
+     */
+    size_t item_size;
+
+    /**
+     * The count of rows.
+     */
+    size_t rows;
+
+    /**
+     * The count of items in each row.
+     */
+    size_t cols;
+
+    /**
+     * The distance between the first items of consecutive rows, in bytes.
+     */
+    size_t row_stride;
+} Slice99Matrix;
+
+/**
+ * Constructs a matrix view of @p rows rows of @p cols items, which are separated by @p row_stride
+ * bytes.
+ *
+ * @param[in] ptr The value of Slice99Matrix#ptr.
+ * @param[in] item_size The value of Slice99Matrix#item_size.
+ * @param[in] rows The value of Slice99Matrix#rows.
+ * @param[in] cols The value of Slice99Matrix#cols.
+ * @param[in] row_stride The value of Slice99Matrix#row_stride.
+ *
+ * @pre `ptr != NULL`
+ * @pre `item_size > 0`
+ * @pre `row_stride >= cols * item_size`
+ * @pre `row_stride` must be representable as `ptrdiff_t`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Matrix Slice99Matrix_with_stride(
+    void *ptr, size_t item_size, size_t rows, size_t cols, size_t row_stride) {
+    SLICE99_ASSERT(ptr);
+    SLICE99_ASSERT(item_size > 0);
+    SLICE99_ASSERT(row_stride >= cols * item_size);
+
+    const Slice99Matrix result = {
+        .ptr = ptr,
+        .item_size = item_size,
+        .rows = rows,
+        .cols = cols,
+        .row_stride = row_stride,
+    };
+    return result;
+}
+
+/**
+ * Constructs a matrix view of @p rows packed rows of @p cols items.
+ *
+ * @param[in] ptr The value of Slice99Matrix#ptr.
+ * @param[in] item_size The value of Slice99Matrix#item_size.
+ * @param[in] rows The value of Slice99Matrix#rows.
+ * @param[in] cols The value of Slice99Matrix#cols.
+ *
+ * @pre `ptr != NULL`
+ * @pre `item_size > 0`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Matrix
+Slice99Matrix_new(void *ptr, size_t item_size, size_t rows, size_t cols) {
+    return Slice99Matrix_with_stride(ptr, item_size, rows, cols, cols * item_size);
+}
+
+/**
+ * Constructs a matrix view of @p self split into rows of @p cols items.
+ *
+ * @param[in] self The viewed slice.
+ * @param[in] cols The value of Slice99Matrix#cols.
+ *
+ * @pre `cols > 0`
+ * @pre `self.len % cols == 0`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Matrix
+Slice99Matrix_from_slice(Slice99 self, size_t cols) {
+    SLICE99_ASSERT(cols > 0);
+    SLICE99_ASSERT(self.len % cols == 0);
+
+    return Slice99Matrix_new(self.ptr, self.item_size, self.len / cols, cols);
+}
+
+/**
+ * Checks whether the rows of @p self are packed without padding.
+ *
+ * @param[in] self The checked view.
+ *
+ * @return `true` if all the items of @p self are contiguous, `false` otherwise.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST bool
+Slice99Matrix_is_contiguous(Slice99Matrix self) {
+    return self.rows <= 1 || self.row_stride == self.cols * self.item_size;
+}
+
+/**
+ * Computes a pointer to the item at @p row and @p col.
+ *
+ * @param[in] self The view upon which the pointer will be computed.
+ * @param[in] row The index of the row.
+ * @param[in] col The index of the column.
+ *
+ * @pre `row < self.rows`
+ * @pre `col < self.cols`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT void *
+Slice99Matrix_get(Slice99Matrix self, size_t row, size_t col) {
+    SLICE99_ASSERT(row < self.rows);
+    SLICE99_ASSERT(col < self.cols);
+
+    return (char *)self.ptr + row * self.row_stride + col * self.item_size;
+}
+
+/**
+ * Constructs a slice of the @p row -indexed row.
+ *
+ * @param[in] self The original view.
+ * @param[in] row The index of the row.
+ *
+ * @pre `row < self.rows`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99 Slice99Matrix_row(Slice99Matrix self, size_t row) {
+    SLICE99_ASSERT(row < self.rows);
+
+    return Slice99_new((char *)self.ptr + row * self.row_stride, self.item_size, self.cols);
+}
+
+/**
+ * Constructs a strided view of the @p col -indexed column.
+ *
+ * @param[in] self The original view.
+ * @param[in] col The index of the column.
+ *
+ * @pre `col < self.cols`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Strided
+Slice99Matrix_col(Slice99Matrix self, size_t col) {
+    SLICE99_ASSERT(col < self.cols);
+
+    return Slice99Strided_new(
+        (char *)self.ptr + col * self.item_size, self.item_size, (ptrdiff_t)self.row_stride,
+        self.rows);
+}
+
+/**
+ * Subviewing @p self with the rows [@p row_start `..` @p row_end] and the columns [@p col_start
+ * `..` @p col_end].
+ *
+ * @param[in] self The original view.
+ * @param[in] row_start The index of the first row, inclusively.
+ * @param[in] row_end The index of the last row, exclusively.
+ * @param[in] col_start The index of the first column, inclusively.
+ * @param[in] col_end The index of the last column, exclusively.
+ *
+ * @return A view with the aforementioned properties.
+ *
+ * @pre `row_start <= row_end && row_end <= self.rows`
+ * @pre `col_start <= col_end && col_end <= self.cols`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Matrix Slice99Matrix_sub(
+    Slice99Matrix self, size_t row_start, size_t row_end, size_t col_start, size_t col_end) {
+    SLICE99_ASSERT(row_start <= row_end && row_end <= self.rows);
+    SLICE99_ASSERT(col_start <= col_end && col_end <= self.cols);
+
+    return Slice99Matrix_with_stride(
+        (char *)self.ptr + row_start * self.row_stride + col_start * self.item_size,
+        self.item_size, row_end - row_start, col_end - col_start, self.row_stride);
+}
+
+/**
+ * Copies the items of @p other to the top-left corner of @p self.
+ *
+ * If both views are contiguous, this is a single #Slice99_copy; otherwise, the rows are copied
+ * one by one.
+ *
+ * @param[out] self The view to which the items of @p other will be copied.
+ * @param[in] other The view to be copied to @p self.
+ *
+ * @pre `self.item_size == other.item_size`
+ * @pre `self.rows >= other.rows && self.cols >= other.cols`
+ * @pre Unless both views are contiguous, the rows of @p self and @p other must not overlap.
+ */
+inline static void Slice99Matrix_copy(Slice99Matrix self, Slice99Matrix other) {
+    SLICE99_ASSERT(self.item_size == other.item_size);
+    SLICE99_ASSERT(self.rows >= other.rows && self.cols >= other.cols);
+
+    const size_t row_size = other.cols * other.item_size;
+
+    if (self.cols == other.cols && Slice99Matrix_is_contiguous(self) &&
+        Slice99Matrix_is_contiguous(other)) {
+        SLICE99_MEMMOVE(self.ptr, other.ptr, other.rows * row_size);
+        return;
+    }
+
+    char *dst = (char *)self.ptr;
+    const char *src = (const char *)other.ptr;
+    for (size_t i = 0; i < other.rows; i++, dst += self.row_stride, src += other.row_stride) {
+        SLICE99_MEMMOVE(dst, src, row_size);
+    }
+}
+
+/**
+ * Performs a byte-by-byte comparison of the items of @p lhs with the items of @p rhs.
+ *
+ * If both views are contiguous, this is a single #Slice99_primitive_eq; otherwise, the rows are
+ * compared one by one.
+ *
+ * @param[in] lhs The first view to be compared.
+ * @param[in] rhs The second view to be compared.
+ *
+ * @return `true` if @p lhs and @p rhs have the same item size, dimensions, and items, `false`
+ * otherwise.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99Matrix_primitive_eq(Slice99Matrix lhs, Slice99Matrix rhs) {
+    if (lhs.item_size != rhs.item_size || lhs.rows != rhs.rows || lhs.cols != rhs.cols) {
+        return false;
+    }
+
+    const size_t row_size = lhs.cols * lhs.item_size;
+
+    if (Slice99Matrix_is_contiguous(lhs) && Slice99Matrix_is_contiguous(rhs)) {
+        return SLICE99_MEMCMP(lhs.ptr, rhs.ptr, lhs.rows * row_size) == 0;
+    }
+
+    const char *l = (const char *)lhs.ptr, *r = (const char *)rhs.ptr;
+    for (size_t i = 0; i < lhs.rows; i++, l += lhs.row_stride, r += rhs.row_stride) {
+        if (SLICE99_MEMCMP(l, r, row_size) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * A chunk of #Slice99Chain.
+ */
+typedef struct {
+    /**
+     * The items of the chunk.
+     */
+    Slice99 slice;
+
+    /**
+     * The count of items in this chunk and all the chunks pushed before it.
+     */
+    size_t end;
+} Slice99ChainChunk;
+
+/**
+ * A sequence of items stored in several slices, which are neither copied nor concatenated.
+ *
+ * The chunks are stored in a caller-provided array along with their cumulative lengths, so an item
+ * is found by binary search over the chunks, in `O(log count)`. #Slice99Chain_sub returns a view
+ * of the same array, which can start and end in the middle of a chunk. The items are copied only
+ * by #Slice99Chain_flatten_into, once the whole sequence is known.
+ *
+ * This structure should not be constructed manually; use #Slice99Chain_new instead.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ * #include <stdio.h>
+ *
+ * int main(void) {
+ *     Slice99ChainChunk buffer[3];
+ *     Slice99Chain chain = Slice99Chain_new(buffer, 3, sizeof(char));
+ *
+ *     char *pieces[] = {"Hello", ", ", "world!"};
+ *     for (size_t i = 0; i < 3; i++) {
+ *         if (!Slice99Chain_push(&chain, Slice99_from_str(pieces[i]))) {
+ *             return 1;
+ *         }
+ *     }
+ *
+ *     assert(*(char *)Slice99Chain_get(chain, 7) == 'w');
+ *
+ *     // ", wor"
+ *     const Slice99Chain sub = Slice99Chain_sub(chain, 5, 10);
+ *     assert(Slice99Chain_primitive_eq(sub, Slice99_from_str(", wor")));
+ *
+ *     size_t cursor = 0;
+ *     Slice99 chunk;
+ *     while (Slice99Chain_next(sub, &cursor, &chunk)) {
+ *         printf("%.*s|", (int)chunk.len, (const char *)chunk.ptr);
+ *     }
+ *     puts("");
+ *
+ *     char flat[16];
+ *     const Slice99 result = Slice99Chain_flatten_into(chain, Slice99_from_array(flat));
+ *     printf("%.*s\n", (int)result.len, (const char *)result.ptr);
+ * }
+ * @endcode
+ */
+typedef struct {
+    /**
+     * The chunks containing the items of the chain.
+     */
+    Slice99ChainChunk *chunks;
+
+    /**
+     * The count of #chunks.
+     */
+    size_t count;
+
+    /**
+     * The count of chunks that #chunks can hold.
+     */
+    size_t cap;
+
+    /**
+     * The size of each item in the chain.
+     */
+    size_t item_size;
+
+    /**
+     * The position of the first item of the chain in the numbering of Slice99ChainChunk#end.
+     */
+    size_t start;
+
+    /**
+     * The count of items in the chain.
+     */
+    size_t len;
+} Slice99Chain;
+
+#ifndef DOXYGEN_IGNORE
+
+// Returns the index of the chunk containing the item at the position `pos`, i.e., the first chunk
+// whose `end` is greater than `pos`.
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE size_t
+slice99_priv_chain_find(const Slice99ChainChunk *chunks, size_t count, size_t pos) {
+    size_t lo = 0;
+    while (count > 0) {
+        const size_t half = count / 2;
+        if (chunks[lo + half].end <= pos) {
+            lo += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+
+    return lo;
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Constructs an empty chain that will store its chunks in @p buffer.
+ *
+ * @param[out] buffer The memory area for the chunks. Can be `NULL` if @p cap is 0.
+ * @param[in] cap The count of chunks that @p buffer can hold.
+ * @param[in] item_size The size of each item in the chain.
+ *
+ * @pre `buffer != NULL || cap == 0`
+ * @pre `item_size > 0`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Chain
+Slice99Chain_new(Slice99ChainChunk buffer[], size_t cap, size_t item_size) {
+    SLICE99_ASSERT(buffer || cap == 0);
+    SLICE99_ASSERT(item_size > 0);
+
+    const Slice99Chain result = {
+        .chunks = buffer,
+        .count = 0,
+        .cap = cap,
+        .item_size = item_size,
+        .start = 0,
+        .len = 0,
+    };
+    return result;
+}
+
+/**
+ * Appends @p slice to the end of @p self without copying its items.
+ *
+ * Empty slices are skipped.
+ *
+ * @param[in,out] self The chain to append to. Must not be a view returned by #Slice99Chain_sub.
+ * @param[in] slice The slice to append. It must outlive @p self.
+ *
+ * @return `true` on success, `false` if @p self is full. In the latter case, @p self is left
+ * unchanged.
+ *
+ * @pre `self != NULL`
+ * @pre `slice.item_size == self->item_size`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool Slice99Chain_push(Slice99Chain *self, Slice99 slice) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(slice.item_size == self->item_size);
+
+    if (slice.len == 0) {
+        return true;
+    }
+    if (self->count == self->cap) {
+        return false;
+    }
+
+    self->len += slice.len;
+    const Slice99ChainChunk chunk = {.slice = slice, .end = self->start + self->len};
+    self->chunks[self->count++] = chunk;
+    return true;
+}
+
+/**
+ * Computes the total size of the items of @p self in bytes.
+ *
+ * @param[in] self The chain whose size is to be computed.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST size_t Slice99Chain_size(Slice99Chain self) {
+    return self.item_size * self.len;
+}
+
+/**
+ * Computes a pointer to the @p i -indexed item, in `O(log self.count)`.
+ *
+ * @param[in] self The chain upon which the pointer will be computed.
+ * @param[in] i The index of a desired item.
+ *
+ * @pre `i < self.len`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE void *
+Slice99Chain_get(Slice99Chain self, size_t i) {
+    SLICE99_ASSERT(i < self.len);
+
+    const size_t pos = self.start + i;
+    const Slice99ChainChunk *chunk =
+        &self.chunks[slice99_priv_chain_find(self.chunks, self.count, pos)];
+
+    return Slice99_get(chunk->slice, (ptrdiff_t)(pos - (chunk->end - chunk->slice.len)));
+}
+
+/**
+ * Subslicing @p self with [@p start_idx `..` @p end_idx], in `O(log self.count)`.
+ *
+ * The result is a view of the chunks of @p self, which must not be pushed to.
+ *
+ * @param[in] self The original chain.
+ * @param[in] start_idx The index at which a new chain will reside, inclusively.
+ * @param[in] end_idx The index at which a new chain will end, exclusively.
+ *
+ * @return A chain with the aforementioned properties.
+ *
+ * @pre `start_idx <= end_idx && end_idx <= self.len`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Chain
+Slice99Chain_sub(Slice99Chain self, size_t start_idx, size_t end_idx) {
+    SLICE99_ASSERT(start_idx <= end_idx && end_idx <= self.len);
+
+    Slice99Chain result = self;
+    result.start = self.start + start_idx;
+    result.len = end_idx - start_idx;
+
+    if (result.len == 0) {
+        result.count = 0;
+    } else {
+        const size_t first = slice99_priv_chain_find(self.chunks, self.count, result.start);
+        const size_t last =
+            slice99_priv_chain_find(self.chunks, self.count, result.start + result.len - 1);
+
+        result.chunks = self.chunks + first;
+        result.count = last - first + 1;
+    }
+
+    // Views cannot be pushed to.
+    result.cap = result.count;
+    return result;
+}
+
+/**
+ * Iterates over the contiguous pieces of @p self in order.
+ *
+ * The first and the last pieces are the parts of the corresponding chunks that belong to @p self.
+ *
+ * @param[in] self The chain to iterate over.
+ * @param[in,out] cursor The iteration state, initially 0.
+ * @param[out] out The location to which the next piece is written.
+ *
+ * @return `true` if a piece has been written to @p out, `false` if the iteration is over.
+ *
+ * @pre `cursor != NULL`
+ * @pre `out != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99Chain_next(Slice99Chain self, size_t *restrict cursor, Slice99 *restrict out) {
+    SLICE99_ASSERT(cursor);
+    SLICE99_ASSERT(out);
+
+    if (*cursor >= self.count) {
+        return false;
+    }
+
+    const Slice99ChainChunk *chunk = &self.chunks[(*cursor)++];
+    const size_t chunk_start = chunk->end - chunk->slice.len, end = self.start + self.len;
+
+    const size_t from = self.start > chunk_start ? self.start - chunk_start : 0,
+                 to = end < chunk->end ? end - chunk_start : chunk->slice.len;
+
+    *out = Slice99_sub(chunk->slice, (ptrdiff_t)from, (ptrdiff_t)to);
+    return true;
+}
+
+/**
+ * Performs a byte-by-byte comparison of @p self with the contiguous @p other.
+ *
+ * @param[in] self The chain to be compared.
+ * @param[in] other The slice to be compared.
+ *
+ * @return `true` if @p self and @p other are equal, `false` otherwise.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99Chain_primitive_eq(Slice99Chain self, Slice99 other) {
+    if (Slice99Chain_size(self) != Slice99_size(other)) {
+        return false;
+    }
+
+    const char *p = (const char *)other.ptr;
+    size_t cursor = 0;
+    Slice99 piece;
+    while (Slice99Chain_next(self, &cursor, &piece)) {
+        if (SLICE99_MEMCMP(piece.ptr, p, Slice99_size(piece)) != 0) {
+            return false;
+        }
+        p += Slice99_size(piece);
+    }
+
+    return true;
+}
+
+/**
+ * Copies the items of @p self to the beginning of @p out.
+ *
+ * @param[in] self The chain to be copied.
+ * @param[out] out The location to which the items of @p self will be copied.
+ *
+ * @return The first `self.len` items of @p out.
+ *
+ * @pre `Slice99_size(out) >= Slice99Chain_size(self)`
+ * @pre The items of @p self and @p out must not overlap.
+ */
+inline static Slice99 Slice99Chain_flatten_into(Slice99Chain self, Slice99 out) {
+    SLICE99_ASSERT(Slice99_size(out) >= Slice99Chain_size(self));
+
+    char *p = (char *)out.ptr;
+    size_t cursor = 0;
+    Slice99 piece;
+    while (Slice99Chain_next(self, &cursor, &piece)) {
+        SLICE99_MEMCPY(p, piece.ptr, Slice99_size(piece));
+        p += Slice99_size(piece);
+    }
+
+    return Slice99_new(out.ptr, self.item_size, self.len);
+}
+
+#ifndef DOXYGEN_IGNORE
+
+struct slice99_priv_arena_chunk {
+    struct slice99_priv_arena_chunk *prev;
+    size_t cap;
+};
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * The minimum size of a chunk allocated by #Slice99Arena, in bytes.
+ *
+ * Defaults to 4096 if not defined before including this header file.
+ */
+#ifndef SLICE99_ARENA_CHUNK_SIZE
+#define SLICE99_ARENA_CHUNK_SIZE 4096
+#endif
+
+/**
+ * A bump allocator.
+ *
+ * An arena first allocates from a caller-provided buffer. When the buffer is exhausted, it
+ * allocates chunks with #SLICE99_REALLOC, each at least twice as big as the previous one and at
+ * least #SLICE99_ARENA_CHUNK_SIZE bytes. Individual allocations cannot be freed; instead, the whole
+ * arena is reset with #Slice99Arena_reset and released with #Slice99Arena_free.
+ *
+ * This structure should not be constructed manually; use #Slice99Arena_new instead.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * int main(void) {
+ *     char buffer[1024];
+ *     Slice99Arena arena = Slice99Arena_new(buffer, sizeof buffer);
+ *
+ *     for (int i = 0; i < 100; i++) {
+ *         // Handle a request...
+ *         char *name = CharSlice99_arena_c_str(CharSlice99_from_str("hello"), &arena);
+ *         (void)name;
+ *
+ *         Slice99Arena_reset(&arena);
+ *     }
+ *
+ *     Slice99Arena_free(&arena);
+ * }
+ * @endcode
+ */
+typedef struct {
+    /**
+     * The region from which the next allocation will be made.
+     */
+    char *ptr;
+
+    /**
+     * The size of #ptr in bytes.
+     */
+    size_t cap;
+
+    /**
+     * The number of bytes already allocated from #ptr.
+     */
+    size_t used;
+
+    /**
+     * The caller-provided buffer.
+     */
+    char *buffer;
+
+    /**
+     * The size of #buffer in bytes.
+     */
+    size_t buffer_size;
+
+    /**
+     * The most recently allocated chunk, which links to the previous ones.
+     */
+    struct slice99_priv_arena_chunk *chunks;
+} Slice99Arena;
+
+/**
+ * Constructs an arena allocating from @p buffer first.
+ *
+ * @param[in] buffer The memory area to allocate from. Can be `NULL` if @p size is 0.
+ * @param[in] size The size of @p buffer in bytes.
+ *
+ * @pre `buffer != NULL || size == 0`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Arena Slice99Arena_new(void *buffer, size_t size) {
+    SLICE99_ASSERT(buffer || size == 0);
+
+    const Slice99Arena arena = {
+        .ptr = (char *)buffer,
+        .cap = size,
+        .used = 0,
+        .buffer = (char *)buffer,
+        .buffer_size = size,
+        .chunks = NULL,
+    };
+    return arena;
+}
+
+#ifndef DOXYGEN_IGNORE
+
+inline static SLICE99_WARN_UNUSED_RESULT void *
+slice99_priv_arena_bump(Slice99Arena *self, size_t size, size_t align) {
+    if (self->ptr == NULL) {
+        return NULL;
+    }
+
+    const size_t padding = (size_t)(-(uintptr_t)(self->ptr + self->used)) & (align - 1);
+    if (padding > self->cap - self->used || size > self->cap - self->used - padding) {
+        return NULL;
+    }
+
+    char *result = self->ptr + self->used + padding;
+    self->used += padding + size;
+    return result;
+}
+
+inline static SLICE99_WARN_UNUSED_RESULT void *
+slice99_priv_arena_grow(Slice99Arena *self, size_t size, size_t align) {
+#ifdef SLICE99_DISABLE_STDLIB
+    (void)self;
+    (void)size;
+    (void)align;
+    return NULL;
+#else
+    const size_t overhead = sizeof(struct slice99_priv_arena_chunk) + align;
+    if (size > SIZE_MAX - overhead) {
+        return NULL;
+    }
+
+    size_t cap = SLICE99_ARENA_CHUNK_SIZE;
+    if (self->chunks != NULL && self->chunks->cap <= SIZE_MAX / 2 - overhead) {
+        cap = self->chunks->cap * 2;
+    }
+    if (cap < size + align) {
+        cap = size + align;
+    }
+
+    struct slice99_priv_arena_chunk *chunk =
+        (struct slice99_priv_arena_chunk *)SLICE99_REALLOC(NULL, sizeof(*chunk) + cap);
+    if (chunk == NULL) {
+        return NULL;
+    }
+
+    chunk->prev = self->chunks;
+    chunk->cap = cap;
+    self->chunks = chunk;
+
+    self->ptr = (char *)(chunk + 1);
+    self->cap = cap;
+    self->used = 0;
+
+    return slice99_priv_arena_bump(self, size, align);
+#endif
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Allocates @p size bytes aligned to @p align from @p self.
+ *
+ * @param[in,out] self The arena to allocate from.
+ * @param[in] size The number of bytes to allocate.
+ * @param[in] align The alignment of the returned pointer.
+ *
+ * @return A pointer to the allocated memory, or `NULL` if the current region is exhausted and a
+ * new chunk could not be allocated.
+ *
+ * @pre `self != NULL`
+ * @pre @p align must be a power of two.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT void *
+Slice99Arena_alloc(Slice99Arena *self, size_t size, size_t align) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(align > 0 && (align & (align - 1)) == 0);
+
+    void *result = slice99_priv_arena_bump(self, size, align);
+    return result != NULL ? result : slice99_priv_arena_grow(self, size, align);
+}
+
+/**
+ * Makes all the memory allocated from @p self available again.
+ *
+ * If @p self has allocated chunks, only the biggest one is retained and becomes the region to
+ * allocate from; otherwise, @p self allocates from the caller-provided buffer again. Thus, once an
+ * arena has grown to fit a typical workload, resetting it is O(1) and subsequent allocations do
+ * not call #SLICE99_REALLOC.
+ *
+ * @param[in,out] self The arena to reset.
+ *
+ * @pre `self != NULL`
+ */
+inline static void Slice99Arena_reset(Slice99Arena *self) {
+    SLICE99_ASSERT(self);
+
+    self->used = 0;
+
+    if (self->chunks == NULL) {
+        self->ptr = self->buffer;
+        self->cap = self->buffer_size;
+        return;
+    }
+
+#ifndef SLICE99_DISABLE_STDLIB
+    struct slice99_priv_arena_chunk *chunk = self->chunks->prev;
+    while (chunk != NULL) {
+        struct slice99_priv_arena_chunk *prev = chunk->prev;
+        SLICE99_FREE(chunk);
+        chunk = prev;
+    }
+#endif
+
+    self->chunks->prev = NULL;
+    self->ptr = (char *)(self->chunks + 1);
+    self->cap = self->chunks->cap;
+}
+
+/**
+ * Releases all the chunks allocated by @p self.
+ *
+ * After this call, @p self is equivalent to `Slice99Arena_new(buffer, size)`, where `buffer` and
+ * `size` are the arguments @p self was constructed with.
+ *
+ * @param[in,out] self The arena to release.
+ *
+ * @pre `self != NULL`
+ */
+inline static void Slice99Arena_free(Slice99Arena *self) {
+    SLICE99_ASSERT(self);
+
+#ifndef SLICE99_DISABLE_STDLIB
+    struct slice99_priv_arena_chunk *chunk = self->chunks;
+    while (chunk != NULL) {
+        struct slice99_priv_arena_chunk *prev = chunk->prev;
+        SLICE99_FREE(chunk);
+        chunk = prev;
+    }
+#endif
+
+    *self = Slice99Arena_new(self->buffer, self->buffer_size);
+}
+
+/**
+ * Copies @p self to memory allocated from @p arena.
+ *
+ * The copy is aligned to the largest power of two dividing `self.item_size`, but at most 16.
+ *
+ * @param[in] self The slice to be copied.
+ * @param[in,out] arena The arena to allocate from.
+ * @param[out] out The location to which the copy will be written.
+ *
+ * @return `true` on success, `false` if the allocation has failed. In the latter case, @p out is
+ * left unchanged.
+ *
+ * @pre `arena != NULL`
+ * @pre `out != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99_arena_dup(Slice99 self, Slice99Arena *restrict arena, Slice99 *restrict out) {
+    SLICE99_ASSERT(out);
+
+    size_t align = self.item_size & (~self.item_size + 1);
+    if (align > 16) {
+        align = 16;
+    }
+
+    void *ptr = Slice99Arena_alloc(arena, Slice99_size(self), align);
+    if (ptr == NULL) {
+        return false;
+    }
+
+    SLICE99_MEMCPY(ptr, self.ptr, Slice99_size(self));
+    *out = Slice99_new(ptr, self.item_size, self.len);
+    return true;
+}
+
+SLICE99_DEF_TYPED(CharSlice99, char);
+SLICE99_DEF_TYPED(SCharSlice99, signed char);
+SLICE99_DEF_TYPED(UCharSlice99, unsigned char);
+
+SLICE99_DEF_TYPED(ShortSlice99, short);
+SLICE99_DEF_TYPED(UShortSlice99, unsigned short);
+
+SLICE99_DEF_TYPED(IntSlice99, int);
+SLICE99_DEF_TYPED(UIntSlice99, unsigned int);
+
+SLICE99_DEF_TYPED(LongSlice99, long);
+SLICE99_DEF_TYPED(ULongSlice99, unsigned long);
+SLICE99_DEF_TYPED(LongLongSlice99, long long);
+SLICE99_DEF_TYPED(ULongLongSlice99, unsigned long long);
+
+SLICE99_DEF_TYPED(FloatSlice99, float);
+SLICE99_DEF_TYPED(DoubleSlice99, double);
+SLICE99_DEF_TYPED(LongDoubleSlice99, long double);
+
+SLICE99_DEF_TYPED(BoolSlice99, _Bool);
+
+// Unsigned integers {
+#ifdef UINT8_MAX
+SLICE99_DEF_TYPED(U8Slice99, uint8_t);
+SLICE99_DEF_TYPED_RADIX_SORT(U8Slice99, uint8_t);
+#endif
+
+#ifdef UINT16_MAX
+SLICE99_DEF_TYPED(U16Slice99, uint16_t);
+SLICE99_DEF_TYPED_RADIX_SORT(U16Slice99, uint16_t);
+#endif
+
+#ifdef UINT32_MAX
+SLICE99_DEF_TYPED(U32Slice99, uint32_t);
+SLICE99_DEF_TYPED_RADIX_SORT(U32Slice99, uint32_t);
+#endif
+
+#ifdef UINT64_MAX
+SLICE99_DEF_TYPED(U64Slice99, uint64_t);
+SLICE99_DEF_TYPED_RADIX_SORT(U64Slice99, uint64_t);
+#endif
+// } (Unsigned integers)
+
+// Signed integers {
+#ifdef INT8_MAX
+SLICE99_DEF_TYPED(I8Slice99, int8_t);
+SLICE99_DEF_TYPED_RADIX_SORT(I8Slice99, int8_t);
+#endif
+
+#ifdef INT16_MAX
+SLICE99_DEF_TYPED(I16Slice99, int16_t);
+SLICE99_DEF_TYPED_RADIX_SORT(I16Slice99, int16_t);
+#endif
+
+#ifdef INT32_MAX
+SLICE99_DEF_TYPED(I32Slice99, int32_t);
+SLICE99_DEF_TYPED_RADIX_SORT(I32Slice99, int32_t);
+#endif
+
+#ifdef INT64_MAX
+SLICE99_DEF_TYPED(I64Slice99, int64_t);
+SLICE99_DEF_TYPED_RADIX_SORT(I64Slice99, int64_t);
+#endif
+// } (Signed integers)
+
+/**
+ * The same as #Slice99_from_str.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT CharSlice99 CharSlice99_from_str(char *str) {
+    return (CharSlice99)SLICE99_TO_TYPED(Slice99_from_str(str));
+}
+
+/**
+ * The same as #Slice99_c_str.
+ */
+inline static char *CharSlice99_c_str(CharSlice99 self, char out[restrict]) {
+    return Slice99_c_str(SLICE99_TO_UNTYPED(self), out);
+}
+
+/**
+ * Makes a null-terminated string out of `CharSlice99` using `alloca`.
+ *
+ * The same as #CharSlice99_c_str, except that the second parameter is allocated using `alloca`. Do
+ * not use this macro for big strings to avoid stack overflow.
+ */
+#define CharSlice99_alloca_c_str(self) CharSlice99_c_str((self), alloca((self).len + 1))
+
+/**
+ * Makes a null-terminated string out of `CharSlice99` in memory allocated from @p arena.
+ *
+ * The same as #CharSlice99_c_str, except that the second parameter is allocated from @p arena.
+ *
+ * @return The null-terminated string, or `NULL` if the allocation has failed.
+ *
+ * @pre `arena != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT char *
+CharSlice99_arena_c_str(CharSlice99 self, Slice99Arena *arena) {
+    char *out = (char *)Slice99Arena_alloc(arena, self.len + 1, 1);
+    return out == NULL ? NULL : CharSlice99_c_str(self, out);
+}
+
+#ifdef UINT32_MAX
+
+#ifndef DOXYGEN_IGNORE
+
+// Unrolled by four, so that the independent loads and stores of consecutive items overlap; for
+// the constant item sizes of `SLICE99_PRIV_STRIDED_DISPATCH`, each copy is a single access.
+
+inline static SLICE99_ALWAYS_INLINE void slice99_priv_gather(
+    char *restrict out, const char *restrict base, const uint32_t *restrict indices, size_t len,
+    size_t item_size) {
+    size_t i = 0;
+    for (; len - i >= 4; i += 4, out += 4 * item_size) {
+        SLICE99_MEMCPY(out, base + (size_t)indices[i] * item_size, item_size);
+        SLICE99_MEMCPY(out + item_size, base + (size_t)indices[i + 1] * item_size, item_size);
+        SLICE99_MEMCPY(out + 2 * item_size, base + (size_t)indices[i + 2] * item_size, item_size);
+        SLICE99_MEMCPY(out + 3 * item_size, base + (size_t)indices[i + 3] * item_size, item_size);
+    }
+    for (; i < len; i++, out += item_size) {
+        SLICE99_MEMCPY(out, base + (size_t)indices[i] * item_size, item_size);
+    }
+}
+
+inline static SLICE99_ALWAYS_INLINE void slice99_priv_scatter(
+    char *restrict base, const char *restrict in, const uint32_t *restrict indices, size_t len,
+    size_t item_size) {
+    size_t i = 0;
+    for (; len - i >= 4; i += 4, in += 4 * item_size) {
+        SLICE99_MEMCPY(base + (size_t)indices[i] * item_size, in, item_size);
+        SLICE99_MEMCPY(base + (size_t)indices[i + 1] * item_size, in + item_size, item_size);
+        SLICE99_MEMCPY(base + (size_t)indices[i + 2] * item_size, in + 2 * item_size, item_size);
+        SLICE99_MEMCPY(base + (size_t)indices[i + 3] * item_size, in + 3 * item_size, item_size);
+    }
+    for (; i < len; i++, in += item_size) {
+        SLICE99_MEMCPY(base + (size_t)indices[i] * item_size, in, item_size);
+    }
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Copies the items of @p self at @p indices to @p out, in the order of @p indices.
+ *
+ * Items of 1, 2, 4, and 8 bytes are copied as plain loads and stores. Typed slices can be passed
+ * through #SLICE99_TO_UNTYPED.
+ *
+ * Defined only if `uint32_t` is available.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     int data[] = {10, 20, 30, 40};
+ *     uint32_t indices[] = {3, 0, 2};
+ *     int out[3];
+ *
+ *     Slice99_gather(
+ *         Slice99_from_array(data), (U32Slice99)Slice99_typed_from_array(indices),
+ *         Slice99_from_array(out));
+ *     assert(out[0] == 40 && out[1] == 10 && out[2] == 30);
+ * }
+ * @endcode
+ *
+ * @param[in] self The slice from which the items will be copied.
+ * @param[in] indices The indices of the items to copy.
+ * @param[out] out The slice to the beginning of which the items will be copied.
+ *
+ * @pre `self.item_size == out.item_size`
+ * @pre `indices.len <= out.len`
+ * @pre Every index must be less than `self.len`.
+ * @pre @p out must not overlap with @p self and @p indices.
+ */
+inline static void Slice99_gather(Slice99 self, U32Slice99 indices, Slice99 out) {
+    SLICE99_ASSERT(self.item_size == out.item_size);
+    SLICE99_ASSERT(indices.len <= out.len);
+    for (size_t i = 0; i < indices.len; i++) {
+        SLICE99_ASSERT(indices.ptr[i] < self.len);
+    }
+
+    SLICE99_PRIV_STRIDED_DISPATCH(
+        self.item_size, slice99_priv_gather, (char *)out.ptr, (const char *)self.ptr, indices.ptr,
+        indices.len);
+}
+
+/**
+ * Copies the items of @p in to the items of @p self at @p indices.
+ *
+ * This is the inverse of #Slice99_gather. If an index occurs more than once, the item of @p in
+ * corresponding to its last occurrence is stored.
+ *
+ * Defined only if `uint32_t` is available.
+ *
+ * @param[out] self The slice to which the items will be copied.
+ * @param[in] indices The indices of the items to overwrite.
+ * @param[in] in The slice whose first `indices.len` items will be copied.
+ *
+ * @pre `self.item_size == in.item_size`
+ * @pre `indices.len <= in.len`
+ * @pre Every index must be less than `self.len`.
+ * @pre @p self must not overlap with @p in and @p indices.
+ */
+inline static void Slice99_scatter(Slice99 self, U32Slice99 indices, Slice99 in) {
+    SLICE99_ASSERT(self.item_size == in.item_size);
+    SLICE99_ASSERT(indices.len <= in.len);
+    for (size_t i = 0; i < indices.len; i++) {
+        SLICE99_ASSERT(indices.ptr[i] < self.len);
+    }
+
+    SLICE99_PRIV_STRIDED_DISPATCH(
+        self.item_size, slice99_priv_scatter, (char *)self.ptr, (const char *)in.ptr, indices.ptr,
+        indices.len);
+}
+
+#endif // UINT32_MAX
+
+#if defined(UINT8_MAX) && defined(UINT16_MAX) && defined(UINT32_MAX) && defined(UINT64_MAX)
+
+#ifndef DOXYGEN_IGNORE
+
+// `size` is a compile-time constant of 1, 2, 4, or 8 at every call site. On little-endian GNU
+// targets, the fixed-size copies below become single (byte-swapped if needed) unaligned loads and
+// stores; the portable loops are not always unrolled by compilers.
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SLICE99_PRIV_LITTLE_ENDIAN
+#endif
+
+inline static SLICE99_ALWAYS_INLINE void
+slice99_priv_store_le(uint8_t *restrict dst, uint64_t x, size_t size) {
+#ifdef SLICE99_PRIV_LITTLE_ENDIAN
+    __builtin_memcpy(dst, &x, size);
+#else
+    for (size_t i = 0; i < size; i++) {
+        dst[i] = (uint8_t)(x >> (8 * i));
+    }
+#endif
+}
+
+inline static SLICE99_ALWAYS_INLINE void
+slice99_priv_store_be(uint8_t *restrict dst, uint64_t x, size_t size) {
+#ifdef SLICE99_PRIV_LITTLE_ENDIAN
+    x = __builtin_bswap64(x << (64 - 8 * size));
+    __builtin_memcpy(dst, &x, size);
+#else
+    for (size_t i = 0; i < size; i++) {
+        dst[size - 1 - i] = (uint8_t)(x >> (8 * i));
+    }
+#endif
+}
+
+inline static SLICE99_ALWAYS_INLINE uint64_t
+slice99_priv_load_le(const uint8_t *restrict src, size_t size) {
+    uint64_t x = 0;
+#ifdef SLICE99_PRIV_LITTLE_ENDIAN
+    __builtin_memcpy(&x, src, size);
+#else
+    for (size_t i = 0; i < size; i++) {
+        x |= (uint64_t)src[i] << (8 * i);
+    }
+#endif
+    return x;
+}
+
+inline static SLICE99_ALWAYS_INLINE uint64_t
+slice99_priv_load_be(const uint8_t *restrict src, size_t size) {
+    uint64_t x = 0;
+#ifdef SLICE99_PRIV_LITTLE_ENDIAN
+    __builtin_memcpy(&x, src, size);
+    x = __builtin_bswap64(x) >> (64 - 8 * size);
+#else
+    for (size_t i = 0; i < size; i++) {
+        x |= (uint64_t)src[size - 1 - i] << (8 * i);
+    }
+#endif
+    return x;
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * The maximum number of bytes #Slice99Writer_write_varint can write.
+ */
+#define SLICE99_VARINT_MAX_SIZE 10
+
+/**
+ * A bounded writer over an octet buffer.
+ *
+ * There are two families of functions writing to `Slice99Writer`:
+ *
+ *  - `Slice99Writer_write_*` check that the value fits into the remaining space.
+ *  - `Slice99Writer_put_*` do not check anything and compile down to plain stores, just like
+ * #SLICE99_APPEND. They are meant to be used after a single #Slice99Writer_reserve covering a whole
+ * batch of fields.
+ *
+ * Errors are latched: once a write or a reservation does not fit, the `overflowed` flag is set and
+ * all subsequent writes do nothing, so that a whole message can be serialised before checking for
+ * overflow once.
+ *
+ * Integers are written without regard to alignment. Defined only if `uint8_t`, `uint16_t`,
+ * `uint32_t`, and `uint64_t` are available.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * int main(void) {
+ *     uint8_t buffer[64];
+ *     Slice99Writer w = Slice99Writer_new((U8Slice99)Slice99_typed_from_array(buffer));
+ *
+ *     // Check the capacity once for the fixed-size header.
+ *     if (Slice99Writer_reserve(&w, 2 + 4)) {
+ *         Slice99Writer_put_u16be(&w, 0xCAFE);
+ *         Slice99Writer_put_u32le(&w, 123);
+ *     }
+ *
+ *     // Or check every field, and then check for overflow once.
+ *     Slice99Writer_write_varint(&w, 300);
+ *     Slice99Writer_write_slice(&w, SLICE99_TO_UNTYPED(CharSlice99_from_str("hello")));
+ *
+ *     if (w.overflowed) {
+ *         // Handle the error...
+ *     }
+ *
+ *     U8Slice99 message = Slice99Writer_written(w);
+ *     (void)message;
+ * }
+ * @endcode
+ */
+typedef struct {
+    /**
+     * The beginning of the buffer.
+     */
+    uint8_t *start;
+
+    /**
+     * The position to write to next.
+     */
+    uint8_t *cursor;
+
+    /**
+     * The end of the buffer.
+     */
+    uint8_t *end;
+
+    /**
+     * Whether a write has not fitted into the buffer.
+     */
+    bool overflowed;
+} Slice99Writer;
+
+/**
+ * Constructs a writer over @p buffer.
+ *
+ * @param[in] buffer The buffer to write to.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Writer Slice99Writer_new(U8Slice99 buffer) {
+    const Slice99Writer result = {
+        .start = buffer.ptr,
+        .cursor = buffer.ptr,
+        .end = buffer.ptr + buffer.len,
+        .overflowed = false,
+    };
+    return result;
+}
+
+/**
+ * Returns the bytes written so far.
+ *
+ * @param[in] self The writer.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST U8Slice99
+Slice99Writer_written(Slice99Writer self) {
+    return U8Slice99_new(self.start, (size_t)(self.cursor - self.start));
+}
+
+/**
+ * Returns the number of bytes that can still be written.
+ *
+ * @param[in] self The writer.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST size_t
+Slice99Writer_remaining(Slice99Writer self) {
+    return (size_t)(self.end - self.cursor);
+}
+
+/**
+ * Checks that @p size more bytes fit into the writer.
+ *
+ * If they do not, the writer becomes overflowed.
+ *
+ * @param[in,out] self The writer.
+ * @param[in] size The number of bytes to be written.
+ *
+ * @return `true` if the writer is not overflowed and @p size bytes can be written with the
+ * `Slice99Writer_put_*` functions, `false` otherwise.
+ *
+ * @pre `self != NULL`
+ */
+inline static SLICE99_ALWAYS_INLINE bool Slice99Writer_reserve(Slice99Writer *self, size_t size) {
+    SLICE99_ASSERT(self);
+
+    if (size > Slice99Writer_remaining(*self)) {
+        self->overflowed = true;
+    }
+
+    return !self->overflowed;
+}
+
+/**
+ * Writes @p size bytes from @p ptr without checking the capacity.
+ *
+ * @param[in,out] self The writer.
+ * @param[in] ptr The bytes to write.
+ * @param[in] size The number of bytes to write.
+ *
+ * @pre `self != NULL`
+ * @pre `ptr != NULL`
+ * @pre `Slice99Writer_remaining(*self) >= size`
+ */
+inline static SLICE99_ALWAYS_INLINE void
+Slice99Writer_put(Slice99Writer *restrict self, const void *restrict ptr, size_t size) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(ptr);
+    SLICE99_ASSERT(Slice99Writer_remaining(*self) >= size);
+
+    self->cursor = (uint8_t *)SLICE99_APPEND_ARRAY(self->cursor, (const uint8_t *)ptr, size);
+}
+
+/**
+ * Writes @p x without checking the capacity.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Writer_remaining(*self) >= 1`
+ */
+inline static SLICE99_ALWAYS_INLINE void Slice99Writer_put_u8(Slice99Writer *self, uint8_t x) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Writer_remaining(*self) >= 1);
+
+    *self->cursor++ = x;
+}
+
+/**
+ * Writes @p x in little-endian without checking the capacity.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Writer_remaining(*self) >= 2`
+ */
+inline static SLICE99_ALWAYS_INLINE void Slice99Writer_put_u16le(Slice99Writer *self, uint16_t x) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Writer_remaining(*self) >= 2);
+
+    slice99_priv_store_le(self->cursor, x, 2);
+    self->cursor += 2;
+}
+
+/**
+ * Writes @p x in big-endian without checking the capacity.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Writer_remaining(*self) >= 2`
+ */
+inline static SLICE99_ALWAYS_INLINE void Slice99Writer_put_u16be(Slice99Writer *self, uint16_t x) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Writer_remaining(*self) >= 2);
+
+    slice99_priv_store_be(self->cursor, x, 2);
+    self->cursor += 2;
+}
+
+/**
+ * Writes @p x in little-endian without checking the capacity.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Writer_remaining(*self) >= 4`
+ */
+inline static SLICE99_ALWAYS_INLINE void Slice99Writer_put_u32le(Slice99Writer *self, uint32_t x) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Writer_remaining(*self) >= 4);
+
+    slice99_priv_store_le(self->cursor, x, 4);
+    self->cursor += 4;
+}
+
+/**
+ * Writes @p x in big-endian without checking the capacity.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Writer_remaining(*self) >= 4`
+ */
+inline static SLICE99_ALWAYS_INLINE void Slice99Writer_put_u32be(Slice99Writer *self, uint32_t x) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Writer_remaining(*self) >= 4);
+
+    slice99_priv_store_be(self->cursor, x, 4);
+    self->cursor += 4;
+}
+
+/**
+ * Writes @p x in little-endian without checking the capacity.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Writer_remaining(*self) >= 8`
+ */
+inline static SLICE99_ALWAYS_INLINE void Slice99Writer_put_u64le(Slice99Writer *self, uint64_t x) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Writer_remaining(*self) >= 8);
+
+    slice99_priv_store_le(self->cursor, x, 8);
+    self->cursor += 8;
+}
+
+/**
+ * Writes @p x in big-endian without checking the capacity.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Writer_remaining(*self) >= 8`
+ */
+inline static SLICE99_ALWAYS_INLINE void Slice99Writer_put_u64be(Slice99Writer *self, uint64_t x) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Writer_remaining(*self) >= 8);
+
+    slice99_priv_store_be(self->cursor, x, 8);
+    self->cursor += 8;
+}
+
+/**
+ * Computes the number of bytes #Slice99Writer_write_varint takes to write @p x.
+ *
+ * @return A number from 1 to #SLICE99_VARINT_MAX_SIZE.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST size_t
+Slice99Writer_varint_size(uint64_t x) {
+#ifdef __GNUC__
+    const size_t bits = 64 - (size_t)__builtin_clzll((unsigned long long)(x | 1));
+    return (bits + 6) / 7;
+#else
+    size_t size = 1;
+    for (; x >= 0x80; x >>= 7) {
+        size++;
+    }
+    return size;
+#endif
+}
+
+/**
+ * Writes @p x in the unsigned LEB128 encoding without checking the capacity.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Writer_remaining(*self) >= Slice99Writer_varint_size(x)`
+ */
+inline static SLICE99_ALWAYS_INLINE void Slice99Writer_put_varint(Slice99Writer *self, uint64_t x) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Writer_remaining(*self) >= Slice99Writer_varint_size(x));
+
+    for (; x >= 0x80; x >>= 7) {
+        *self->cursor++ = (uint8_t)(x | 0x80);
+    }
+    *self->cursor++ = (uint8_t)x;
+}
+
+/**
+ * Writes @p size bytes from @p ptr.
+ *
+ * @param[in,out] self The writer.
+ * @param[in] ptr The bytes to write.
+ * @param[in] size The number of bytes to write.
+ *
+ * @return `true` if the bytes have been written, `false` if the writer is overflowed.
+ *
+ * @pre `self != NULL`
+ * @pre `ptr != NULL`
+ */
+inline static bool
+Slice99Writer_write(Slice99Writer *restrict self, const void *restrict ptr, size_t size) {
+    if (!Slice99Writer_reserve(self, size)) {
+        return false;
+    }
+
+    Slice99Writer_put(self, ptr, size);
+    return true;
+}
+
+/**
+ * Writes the bytes of @p slice.
+ *
+ * The same as #Slice99Writer_write with `slice.ptr` and `Slice99_size(slice)`.
+ */
+inline static bool Slice99Writer_write_slice(Slice99Writer *self, Slice99 slice) {
+    return Slice99Writer_write(self, slice.ptr, Slice99_size(slice));
+}
+
+/**
+ * Writes the object representation of @p obj.
+ *
+ * The same as #Slice99Writer_write with `&obj` and `sizeof(obj)`.
+ *
+ * @param[in,out] self The writer.
+ * @param[in] obj The object (lvalue) to write.
+ */
+#define Slice99Writer_write_obj(self, obj) Slice99Writer_write((self), &(obj), sizeof(obj))
+
+/**
+ * Writes @p x.
+ *
+ * @return `true` if @p x has been written, `false` if the writer is overflowed.
+ *
+ * @pre `self != NULL`
+ */
+inline static bool Slice99Writer_write_u8(Slice99Writer *self, uint8_t x) {
+    if (!Slice99Writer_reserve(self, 1)) {
+        return false;
+    }
+
+    Slice99Writer_put_u8(self, x);
+    return true;
+}
+
+/**
+ * Writes @p x in little-endian.
+ *
+ * @return `true` if @p x has been written, `false` if the writer is overflowed.
+ *
+ * @pre `self != NULL`
+ */
+inline static bool Slice99Writer_write_u16le(Slice99Writer *self, uint16_t x) {
+    if (!Slice99Writer_reserve(self, 2)) {
+        return false;
+    }
+
+    Slice99Writer_put_u16le(self, x);
+    return true;
+}
+
+/**
+ * Writes @p x in big-endian.
+ *
+ * @return `true` if @p x has been written, `false` if the writer is overflowed.
+ *
+ * @pre `self != NULL`
+ */
+inline static bool Slice99Writer_write_u16be(Slice99Writer *self, uint16_t x) {
+    if (!Slice99Writer_reserve(self, 2)) {
+        return false;
+    }
+
+    Slice99Writer_put_u16be(self, x);
+    return true;
+}
+
+/**
+ * Writes @p x in little-endian.
+ *
+ * @return `true` if @p x has been written, `false` if the writer is overflowed.
+ *
+ * @pre `self != NULL`
+ */
+inline static bool Slice99Writer_write_u32le(Slice99Writer *self, uint32_t x) {
+    if (!Slice99Writer_reserve(self, 4)) {
+        return false;
+    }
+
+    Slice99Writer_put_u32le(self, x);
+    return true;
+}
+
+/**
+ * Writes @p x in big-endian.
+ *
+ * @return `true` if @p x has been written, `false` if the writer is overflowed.
+ *
+ * @pre `self != NULL`
+ */
+inline static bool Slice99Writer_write_u32be(Slice99Writer *self, uint32_t x) {
+    if (!Slice99Writer_reserve(self, 4)) {
+        return false;
+    }
+
+    Slice99Writer_put_u32be(self, x);
+    return true;
+}
+
+/**
+ * Writes @p x in little-endian.
+ *
+ * @return `true` if @p x has been written, `false` if the writer is overflowed.
+ *
+ * @pre `self != NULL`
+ */
+inline static bool Slice99Writer_write_u64le(Slice99Writer *self, uint64_t x) {
+    if (!Slice99Writer_reserve(self, 8)) {
+        return false;
+    }
+
+    Slice99Writer_put_u64le(self, x);
+    return true;
+}
+
+/**
+ * Writes @p x in big-endian.
+ *
+ * @return `true` if @p x has been written, `false` if the writer is overflowed.
+ *
+ * @pre `self != NULL`
+ */
+inline static bool Slice99Writer_write_u64be(Slice99Writer *self, uint64_t x) {
+    if (!Slice99Writer_reserve(self, 8)) {
+        return false;
+    }
+
+    Slice99Writer_put_u64be(self, x);
+    return true;
+}
+
+/**
+ * Writes @p x in the unsigned LEB128 encoding.
+ *
+ * @return `true` if @p x has been written, `false` if the writer is overflowed.
+ *
+ * @pre `self != NULL`
+ */
+inline static bool Slice99Writer_write_varint(Slice99Writer *self, uint64_t x) {
+    // Avoid computing the size when any value fits.
+    const size_t required = Slice99Writer_remaining(*self) >= SLICE99_VARINT_MAX_SIZE
+                                ? SLICE99_VARINT_MAX_SIZE
+                                : Slice99Writer_varint_size(x);
+    if (!Slice99Writer_reserve(self, required)) {
+        return false;
+    }
+
+    Slice99Writer_put_varint(self, x);
+    return true;
+}
+
+/**
+ * A zero-copy reader over an octet buffer.
+ *
+ * This is the reading counterpart of #Slice99Writer:
+ *
+ *  - `Slice99Reader_read_*` check that the value is available.
+ *  - `Slice99Reader_take_*` do not check anything and compile down to plain loads. They are meant
+ * to be used after a single #Slice99Reader_require covering a whole batch of fields, such as a
+ * fixed-layout header.
+ *
+ * Errors are latched: once a read or a requirement is not satisfied, the `failed` flag is set and
+ * all subsequent reads do not consume anything and return zeros or empty slices, so that a whole
+ * message can be parsed before checking for failure once.
+ *
+ * Integers are read without regard to alignment. Defined only if `uint8_t`, `uint16_t`,
+ * `uint32_t`, and `uint64_t` are available.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * void parse(U8Slice99 frame) {
+ *     Slice99Reader r = Slice99Reader_new(frame);
+ *
+ *     uint16_t kind = 0;
+ *     uint32_t id = 0;
+ *
+ *     // Check the length once for the fixed-size header.
+ *     if (Slice99Reader_require(&r, 2 + 4)) {
+ *         kind = Slice99Reader_take_u16be(&r);
+ *         id = Slice99Reader_take_u32le(&r);
+ *     }
+ *
+ *     // Or check every field, and then check for failure once.
+ *     const uint64_t len = Slice99Reader_read_varint(&r);
+ *     const U8Slice99 payload = Slice99Reader_read_slice(&r, (size_t)len);
+ *
+ *     if (r.failed) {
+ *         // Handle the error...
+ *     }
+ *
+ *     (void)kind;
+ *     (void)id;
+ *     (void)payload;
+ * }
+ * @endcode
+ */
+typedef struct {
+    /**
+     * The position to read from next.
+     */
+    uint8_t *cursor;
+
+    /**
+     * The end of the buffer.
+     */
+    uint8_t *end;
+
+    /**
+     * Whether a read has gone past the end of the buffer or has encountered malformed data.
+     */
+    bool failed;
+} Slice99Reader;
+
+/**
+ * Constructs a reader over @p buffer.
+ *
+ * @param[in] buffer The buffer to read from.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Reader Slice99Reader_new(U8Slice99 buffer) {
+    const Slice99Reader result = {
+        .cursor = buffer.ptr,
+        .end = buffer.ptr + buffer.len,
+        .failed = false,
+    };
+    return result;
+}
+
+/**
+ * Returns the number of bytes that can still be read.
+ *
+ * @param[in] self The reader.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST size_t
+Slice99Reader_remaining(Slice99Reader self) {
+    return (size_t)(self.end - self.cursor);
+}
+
+/**
+ * Returns the bytes that have not been read yet.
+ *
+ * @param[in] self The reader.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST U8Slice99
+Slice99Reader_rest(Slice99Reader self) {
+    return U8Slice99_new(self.cursor, Slice99Reader_remaining(self));
+}
+
+/**
+ * Returns at most @p size next bytes without consuming them.
+ *
+ * @param[in] self The reader.
+ * @param[in] size The maximum number of bytes to return.
+ *
+ * @return The next `min(size, Slice99Reader_remaining(self))` bytes, or an empty slice if @p self
+ * has failed.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST U8Slice99
+Slice99Reader_peek(Slice99Reader self, size_t size) {
+    const size_t remaining = Slice99Reader_remaining(self);
+    return U8Slice99_new(self.cursor, self.failed ? 0 : size < remaining ? size : remaining);
+}
+
+/**
+ * Checks that @p size more bytes can be read.
+ *
+ * If they cannot, the reader becomes failed.
+ *
+ * @param[in,out] self The reader.
+ * @param[in] size The number of bytes to be read.
+ *
+ * @return `true` if the reader has not failed and @p size bytes can be read with the
+ * `Slice99Reader_take_*` functions, `false` otherwise.
+ *
+ * @pre `self != NULL`
+ */
+inline static SLICE99_ALWAYS_INLINE bool Slice99Reader_require(Slice99Reader *self, size_t size) {
+    SLICE99_ASSERT(self);
+
+    if (size > Slice99Reader_remaining(*self)) {
+        self->failed = true;
+    }
+
+    return !self->failed;
+}
+
+/**
+ * Borrows the next @p size bytes without checking the length.
+ *
+ * @param[in,out] self The reader.
+ * @param[in] size The number of bytes to borrow.
+ *
+ * @return A slice pointing into the buffer of @p self.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Reader_remaining(*self) >= size`
+ */
+inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT U8Slice99
+Slice99Reader_take(Slice99Reader *self, size_t size) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Reader_remaining(*self) >= size);
+
+    const U8Slice99 result = U8Slice99_new(self->cursor, size);
+    self->cursor += size;
+    return result;
+}
+
+/**
+ * Reads `uint8_t` without checking the length.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Reader_remaining(*self) >= 1`
+ */
+inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT uint8_t
+Slice99Reader_take_u8(Slice99Reader *self) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Reader_remaining(*self) >= 1);
+
+    return *self->cursor++;
+}
+
+/**
+ * Reads little-endian `uint16_t` without checking the length.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Reader_remaining(*self) >= 2`
+ */
+inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT uint16_t
+Slice99Reader_take_u16le(Slice99Reader *self) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Reader_remaining(*self) >= 2);
+
+    const uint16_t x = (uint16_t)slice99_priv_load_le(self->cursor, 2);
+    self->cursor += 2;
+    return x;
+}
+
+/**
+ * Reads big-endian `uint16_t` without checking the length.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Reader_remaining(*self) >= 2`
+ */
+inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT uint16_t
+Slice99Reader_take_u16be(Slice99Reader *self) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Reader_remaining(*self) >= 2);
+
+    const uint16_t x = (uint16_t)slice99_priv_load_be(self->cursor, 2);
+    self->cursor += 2;
+    return x;
+}
+
+/**
+ * Reads little-endian `uint32_t` without checking the length.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Reader_remaining(*self) >= 4`
+ */
+inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT uint32_t
+Slice99Reader_take_u32le(Slice99Reader *self) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Reader_remaining(*self) >= 4);
+
+    const uint32_t x = (uint32_t)slice99_priv_load_le(self->cursor, 4);
+    self->cursor += 4;
+    return x;
+}
+
+/**
+ * Reads big-endian `uint32_t` without checking the length.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Reader_remaining(*self) >= 4`
+ */
+inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT uint32_t
+Slice99Reader_take_u32be(Slice99Reader *self) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Reader_remaining(*self) >= 4);
+
+    const uint32_t x = (uint32_t)slice99_priv_load_be(self->cursor, 4);
+    self->cursor += 4;
+    return x;
+}
+
+/**
+ * Reads little-endian `uint64_t` without checking the length.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Reader_remaining(*self) >= 8`
+ */
+inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT uint64_t
+Slice99Reader_take_u64le(Slice99Reader *self) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Reader_remaining(*self) >= 8);
+
+    const uint64_t x = slice99_priv_load_le(self->cursor, 8);
+    self->cursor += 8;
+    return x;
+}
+
+/**
+ * Reads big-endian `uint64_t` without checking the length.
+ *
+ * @pre `self != NULL`
+ * @pre `Slice99Reader_remaining(*self) >= 8`
+ */
+inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT uint64_t
+Slice99Reader_take_u64be(Slice99Reader *self) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(Slice99Reader_remaining(*self) >= 8);
+
+    const uint64_t x = slice99_priv_load_be(self->cursor, 8);
+    self->cursor += 8;
+    return x;
+}
+
+/**
+ * Borrows the next @p size bytes.
+ *
+ * @param[in,out] self The reader.
+ * @param[in] size The number of bytes to borrow.
+ *
+ * @return A slice pointing into the buffer of @p self, or an empty slice if the reader has failed.
+ *
+ * @pre `self != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT U8Slice99
+Slice99Reader_read_slice(Slice99Reader *self, size_t size) {
+    return Slice99Reader_require(self, size) ? Slice99Reader_take(self, size) : U8Slice99_empty();
+}
+
+/**
+ * Copies the next @p size bytes to @p out.
+ *
+ * @param[in,out] self The reader.
+ * @param[out] out The memory area to copy to.
+ * @param[in] size The number of bytes to copy.
+ *
+ * @return `true` if the bytes have been copied, `false` if the reader has failed. In the latter
+ * case, @p out is left unchanged.
+ *
+ * @pre `self != NULL`
+ * @pre `out != NULL`
+ */
+inline static bool
+Slice99Reader_read(Slice99Reader *restrict self, void *restrict out, size_t size) {
+    if (!Slice99Reader_require(self, size)) {
+        return false;
+    }
+
+    SLICE99_MEMCPY(out, Slice99Reader_take(self, size).ptr, size);
+    return true;
+}
+
+/**
+ * Copies the next `sizeof(obj)` bytes to @p obj.
+ *
+ * The same as #Slice99Reader_read with `&obj` and `sizeof(obj)`.
+ *
+ * @param[in,out] self The reader.
+ * @param[out] obj The object (lvalue) to read to.
+ */
+#define Slice99Reader_read_obj(self, obj) Slice99Reader_read((self), &(obj), sizeof(obj))
+
+/**
+ * Reads `uint8_t`.
+ *
+ * @return The value read, or 0 if the reader has failed.
+ *
+ * @pre `self != NULL`
+ */
+inline static uint8_t Slice99Reader_read_u8(Slice99Reader *self) {
+    return Slice99Reader_require(self, 1) ? Slice99Reader_take_u8(self) : 0;
+}
+
+/**
+ * Reads little-endian `uint16_t`.
+ *
+ * @return The value read, or 0 if the reader has failed.
+ *
+ * @pre `self != NULL`
+ */
+inline static uint16_t Slice99Reader_read_u16le(Slice99Reader *self) {
+    return Slice99Reader_require(self, 2) ? Slice99Reader_take_u16le(self) : 0;
+}
+
+/**
+ * Reads big-endian `uint16_t`.
+ *
+ * @return The value read, or 0 if the reader has failed.
+ *
+ * @pre `self != NULL`
+ */
+inline static uint16_t Slice99Reader_read_u16be(Slice99Reader *self) {
+    return Slice99Reader_require(self, 2) ? Slice99Reader_take_u16be(self) : 0;
+}
+
+/**
+ * Reads little-endian `uint32_t`.
+ *
+ * @return The value read, or 0 if the reader has failed.
+ *
+ * @pre `self != NULL`
+ */
+inline static uint32_t Slice99Reader_read_u32le(Slice99Reader *self) {
+    return Slice99Reader_require(self, 4) ? Slice99Reader_take_u32le(self) : 0;
+}
+
+/**
+ * Reads big-endian `uint32_t`.
+ *
+ * @return The value read, or 0 if the reader has failed.
+ *
+ * @pre `self != NULL`
+ */
+inline static uint32_t Slice99Reader_read_u32be(Slice99Reader *self) {
+    return Slice99Reader_require(self, 4) ? Slice99Reader_take_u32be(self) : 0;
+}
+
+/**
+ * Reads little-endian `uint64_t`.
+ *
+ * @return The value read, or 0 if the reader has failed.
+ *
+ * @pre `self != NULL`
+ */
+inline static uint64_t Slice99Reader_read_u64le(Slice99Reader *self) {
+    return Slice99Reader_require(self, 8) ? Slice99Reader_take_u64le(self) : 0;
+}
+
+/**
+ * Reads big-endian `uint64_t`.
+ *
+ * @return The value read, or 0 if the reader has failed.
+ *
+ * @pre `self != NULL`
+ */
+inline static uint64_t Slice99Reader_read_u64be(Slice99Reader *self) {
+    return Slice99Reader_require(self, 8) ? Slice99Reader_take_u64be(self) : 0;
+}
+
+/**
+ * Reads an integer in the unsigned LEB128 encoding, as written by #Slice99Writer_write_varint.
+ *
+ * A varint that is truncated or does not fit into `uint64_t` makes the reader failed.
+ *
+ * @return The value read, or 0 if the reader has failed. In the latter case, nothing is consumed.
+ *
+ * @pre `self != NULL`
+ */
+inline static uint64_t Slice99Reader_read_varint(Slice99Reader *self) {
+    SLICE99_ASSERT(self);
+
+    if (self->failed) {
+        return 0;
+    }
+
+    const size_t remaining = Slice99Reader_remaining(*self);
+    const size_t max_size =
+        remaining < SLICE99_VARINT_MAX_SIZE ? remaining : SLICE99_VARINT_MAX_SIZE;
+
+    uint64_t x = 0;
+    for (size_t i = 0; i < max_size; i++) {
+        const uint8_t byte = self->cursor[i];
+        x |= (uint64_t)(byte & 0x7F) << (7 * i);
+
+        if (byte < 0x80) {
+            // The tenth byte can only hold the most significant bit.
+            if (i == SLICE99_VARINT_MAX_SIZE - 1 && byte > 1) {
+                break;
+            }
+
+            self->cursor += i + 1;
+            return x;
+        }
+    }
+
+    self->failed = true;
+    return 0;
+}
+
+/**
+ * A ring buffer of bytes with contiguous views of its readable bytes and writable space.
+ *
+ * A producer, e.g., a socket reader, writes into #Slice99Ring_writable and publishes the written
+ * bytes with #Slice99Ring_commit; a consumer, e.g., a parser, reads #Slice99Ring_readable and
+ * releases the parsed bytes with #Slice99Ring_consume. An empty #Slice99Ring_writable means that
+ * the consumer lags behind, i.e., backpressure.
+ *
+ * Without mirroring, the views stop at the end of the buffer, so the bytes after the wraparound
+ * become visible once the bytes before it have been consumed. With `SLICE99_ENABLE_MMAP`,
+ * #Slice99Ring_new_mirrored maps the buffer twice in a row, so that the views are always whole.
+ *
+ * Both positions count bytes from the construction and are reduced modulo #cap, which is a power
+ * of two, when accessing the buffer.
+ *
+ * This structure should not be constructed manually; use #Slice99Ring_new instead.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     uint8_t buffer[8];
+ *     Slice99Ring ring = Slice99Ring_new((U8Slice99)Slice99_typed_from_array(buffer));
+ *
+ *     U8Slice99 space = Slice99Ring_writable(ring);
+ *     assert(space.len == 8);
+ *     U8Slice99_copy(space, U8Slice99_new((uint8_t *)"abcdef", 6));
+ *     Slice99Ring_commit(&ring, 6);
+ *
+ *     Slice99Ring_consume(&ring, 4);
+ *     const U8Slice99 data = Slice99Ring_readable(ring);
+ *     assert(data.len == 2 && data.ptr[0] == 'e' && data.ptr[1] == 'f');
+ *
+ *     // The space up to the end of the buffer, and then from its beginning.
+ *     assert(Slice99Ring_writable(ring).len == 2);
+ *     Slice99Ring_commit(&ring, 2);
+ *     assert(Slice99Ring_writable(ring).len == 4);
+ * }
+ * @endcode
+ */
+typedef struct {
+    /**
+     * The buffer of #cap bytes, followed by its mirror if #mirrored is `true`.
+     */
+    uint8_t *ptr;
+
+    /**
+     * The capacity of the ring, in bytes.
+     */
+    size_t cap;
+
+    /**
+     * The count of consumed bytes.
+     */
+    size_t head;
+
+    /**
+     * The count of committed bytes.
+     */
+    size_t tail;
+
+    /**
+     * Whether #ptr is mapped twice in a row (see #Slice99Ring_new_mirrored).
+     */
+    bool mirrored;
+} Slice99Ring;
+
+#ifndef DOXYGEN_IGNORE
+
+inline static SLICE99_ALWAYS_INLINE SLICE99_WARN_UNUSED_RESULT U8Slice99 slice99_priv_ring_view(
+    uint8_t *ptr, size_t cap, bool mirrored, size_t start, size_t len) {
+    const size_t offset = start & (cap - 1), until_end = cap - offset;
+    return U8Slice99_new(ptr + offset, mirrored || len <= until_end ? len : until_end);
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Constructs an empty ring using @p buffer as storage.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[in] buffer The storage of the ring. It must outlive the ring.
+ *
+ * @pre `buffer.len` must be a power of two.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Ring Slice99Ring_new(U8Slice99 buffer) {
+    SLICE99_ASSERT(buffer.len > 0 && (buffer.len & (buffer.len - 1)) == 0);
+
+    const Slice99Ring result = {
+        .ptr = buffer.ptr,
+        .cap = buffer.len,
+        .head = 0,
+        .tail = 0,
+        .mirrored = false,
+    };
+    return result;
+}
+
+/**
+ * Computes the count of readable bytes of @p self.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[in] self The ring.
+ *
+ * @return The count of committed bytes that have not been consumed yet.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST size_t Slice99Ring_len(Slice99Ring self) {
+    return self.tail - self.head;
+}
+
+/**
+ * Computes the view of the readable bytes of @p self.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[in] self The ring.
+ *
+ * @return All the readable bytes if @p self is mirrored or they do not wrap around, the readable
+ * bytes up to the end of the buffer otherwise.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT U8Slice99 Slice99Ring_readable(Slice99Ring self) {
+    return slice99_priv_ring_view(
+        self.ptr, self.cap, self.mirrored, self.head, Slice99Ring_len(self));
+}
+
+/**
+ * Computes the view of the writable space of @p self.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[in] self The ring.
+ *
+ * @return All the free space if @p self is mirrored or it does not wrap around, the free space up
+ * to the end of the buffer otherwise.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT U8Slice99 Slice99Ring_writable(Slice99Ring self) {
+    return slice99_priv_ring_view(
+        self.ptr, self.cap, self.mirrored, self.tail, self.cap - Slice99Ring_len(self));
+}
+
+/**
+ * Makes the first @p n bytes of #Slice99Ring_writable readable.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[out] self The ring.
+ * @param[in] n The count of the written bytes.
+ *
+ * @pre `self != NULL`
+ * @pre `n <= Slice99Ring_writable(*self).len`
+ */
+inline static void Slice99Ring_commit(Slice99Ring *self, size_t n) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(n <= Slice99Ring_writable(*self).len);
+
+    self->tail += n;
+}
+
+/**
+ * Makes the first @p n bytes of #Slice99Ring_readable writable again.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[out] self The ring.
+ * @param[in] n The count of the processed bytes.
+ *
+ * @pre `self != NULL`
+ * @pre `n <= Slice99Ring_len(*self)`
+ */
+inline static void Slice99Ring_consume(Slice99Ring *self, size_t n) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(n <= Slice99Ring_len(*self));
+
+    self->head += n;
+}
+
+#ifdef SLICE99_PRIV_ATOMICS
+
+/**
+ * The size of a cache line assumed by the lock-free structures to prevent false sharing.
+ *
+ * Defaults to 64 if not defined before including this header file. Must be at least 32.
+ */
+#ifndef SLICE99_CACHE_LINE_SIZE
+#define SLICE99_CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * #Slice99Ring shared by one producer thread and one consumer thread without locks.
+ *
+ * The producer calls only #Slice99SpscRing_writable and #Slice99SpscRing_commit, and the consumer
+ * calls only #Slice99SpscRing_readable and #Slice99SpscRing_consume. A commit publishes the
+ * written bytes to the consumer (a release store, paired with the acquire load in
+ * #Slice99SpscRing_readable), and a consume publishes the freed space to the producer in the same
+ * manner.
+ *
+ * The positions written by the two threads are kept on separate cache lines (see
+ * #SLICE99_CACHE_LINE_SIZE), and each thread caches the position of the other one, so that the
+ * cache line of the other thread is touched only when the cached view is exhausted.
+ *
+ * This structure should not be constructed manually; use #Slice99SpscRing_new instead. It must
+ * not be copied after the threads have started using it.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available and the
+ * compiler provides the GNU `__atomic` built-ins (GCC 4.7+ and Clang).
+ */
+typedef struct {
+    /**
+     * The underlying ring. Its positions are not used.
+     */
+    Slice99Ring ring;
+
+    /**
+     * Keeps #head off the cache line of #ring.
+     */
+    unsigned char padding_1[SLICE99_CACHE_LINE_SIZE];
+
+    /**
+     * The count of consumed bytes, written by the consumer.
+     */
+    size_t head;
+
+    /**
+     * The last value of #tail seen by the consumer.
+     */
+    size_t cached_tail;
+
+    /**
+     * Keeps #tail off the cache line of #head and #cached_tail.
+     */
+    unsigned char padding_2[SLICE99_CACHE_LINE_SIZE];
+
+    /**
+     * The count of committed bytes, written by the producer.
+     */
+    size_t tail;
+
+    /**
+     * The last value of #head seen by the producer.
+     */
+    size_t cached_head;
+
+    /**
+     * Keeps the data that follows off the cache line of #tail and #cached_head.
+     */
+    unsigned char padding_3[SLICE99_CACHE_LINE_SIZE];
+} Slice99SpscRing;
+
+// Fails to compile if the positions of the consumer and the producer can share a cache line.
+typedef char slice99_priv_spsc_ring_layout_check
+    [offsetof(Slice99SpscRing, tail) - offsetof(Slice99SpscRing, cached_tail) - sizeof(size_t) >=
+             SLICE99_CACHE_LINE_SIZE
+         ? 1
+         : -1];
+
+/**
+ * Constructs a lock-free ring on top of the empty @p ring.
+ *
+ * Defined only if #Slice99SpscRing is defined.
+ *
+ * @param[in] ring The storage, constructed with #Slice99Ring_new or #Slice99Ring_new_mirrored.
+ *
+ * @pre `Slice99Ring_len(ring) == 0`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99SpscRing Slice99SpscRing_new(Slice99Ring ring) {
+    SLICE99_ASSERT(Slice99Ring_len(ring) == 0);
+
+    Slice99SpscRing result;
+    SLICE99_MEMSET(&result, 0, sizeof result);
+    result.ring = ring;
+    result.head = result.cached_tail = result.tail = result.cached_head = ring.head;
+    return result;
+}
+
+/**
+ * Computes the view of the writable space of @p self. Called by the producer.
+ *
+ * The free space is reloaded from the consumer only if the cached free space is exhausted, so the
+ * view may be shorter than the actual free space.
+ *
+ * Defined only if #Slice99SpscRing is defined.
+ *
+ * @param[in,out] self The ring.
+ *
+ * @return The view of the writable space, empty if the ring is full.
+ *
+ * @pre `self != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT U8Slice99 Slice99SpscRing_writable(Slice99SpscRing *self) {
+    SLICE99_ASSERT(self);
+
+    const size_t tail = self->tail, cap = self->ring.cap;
+    if (tail - self->cached_head == cap) {
+        self->cached_head = __atomic_load_n(&self->head, __ATOMIC_ACQUIRE);
+    }
+
+    return slice99_priv_ring_view(
+        self->ring.ptr, cap, self->ring.mirrored, tail, cap - (tail - self->cached_head));
+}
+
+/**
+ * Publishes the first @p n bytes of #Slice99SpscRing_writable to the consumer. Called by the
+ * producer.
+ *
+ * Defined only if #Slice99SpscRing is defined.
+ *
+ * @param[in,out] self The ring.
+ * @param[in] n The count of the written bytes.
+ *
+ * @pre `self != NULL`
+ * @pre @p n does not exceed the length of the last #Slice99SpscRing_writable.
+ */
+inline static void Slice99SpscRing_commit(Slice99SpscRing *self, size_t n) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(n <= self->ring.cap - (self->tail - self->cached_head));
+
+    __atomic_store_n(&self->tail, self->tail + n, __ATOMIC_RELEASE);
+}
+
+/**
+ * Computes the view of the readable bytes of @p self. Called by the consumer.
+ *
+ * The committed bytes are reloaded from the producer only if the cached ones are exhausted, so the
+ * view may be shorter than the actual readable bytes.
+ *
+ * Defined only if #Slice99SpscRing is defined.
+ *
+ * @param[in,out] self The ring.
+ *
+ * @return The view of the readable bytes, empty if the ring is empty.
+ *
+ * @pre `self != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT U8Slice99 Slice99SpscRing_readable(Slice99SpscRing *self) {
+    SLICE99_ASSERT(self);
+
+    const size_t head = self->head;
+    if (self->cached_tail == head) {
+        self->cached_tail = __atomic_load_n(&self->tail, __ATOMIC_ACQUIRE);
+    }
+
+    return slice99_priv_ring_view(
+        self->ring.ptr, self->ring.cap, self->ring.mirrored, head, self->cached_tail - head);
+}
+
+/**
+ * Returns the first @p n bytes of #Slice99SpscRing_readable to the producer. Called by the
+ * consumer.
+ *
+ * Defined only if #Slice99SpscRing is defined.
+ *
+ * @param[in,out] self The ring.
+ * @param[in] n The count of the processed bytes.
+ *
+ * @pre `self != NULL`
+ * @pre @p n does not exceed the length of the last #Slice99SpscRing_readable.
+ */
+inline static void Slice99SpscRing_consume(Slice99SpscRing *self, size_t n) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(n <= self->cached_tail - self->head);
+
+    __atomic_store_n(&self->head, self->head + n, __ATOMIC_RELEASE);
+}
+
+/**
+ * A bounded lock-free queue of slices between one producer thread and one consumer thread.
+ *
+ * Only the descriptors are queued, so the memory they refer to is handed over to the consumer, and
+ * its contents written before #Slice99SpscQueue_push are visible to the consumer after
+ * #Slice99SpscQueue_pop. Typed slices can be queued as `SLICE99_TO_UNTYPED(slice)` and restored
+ * as `(T)SLICE99_TO_TYPED(slice)`.
+ *
+ * The layout is the same as in #Slice99SpscRing: the positions of the two threads are kept on
+ * separate cache lines, and each thread caches the position of the other one. The batch
+ * operations publish many slices with a single release store.
+ *
+ * This structure should not be constructed manually; use #Slice99SpscQueue_new instead. It must
+ * not be copied after the threads have started using it.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available and the
+ * compiler provides the GNU `__atomic` built-ins (GCC 4.7+ and Clang).
+ */
+typedef struct {
+    /**
+     * The storage of #cap slices.
+     */
+    Slice99 *items;
+
+    /**
+     * The capacity of the queue, a power of two.
+     */
+    size_t cap;
+
+    /**
+     * Keeps #head off the cache line of #items.
+     */
+    unsigned char padding_1[SLICE99_CACHE_LINE_SIZE];
+
+    /**
+     * The count of popped slices, written by the consumer.
+     */
+    size_t head;
+
+    /**
+     * The last value of #tail seen by the consumer.
+     */
+    size_t cached_tail;
+
+    /**
+     * Keeps #tail off the cache line of #head and #cached_tail.
+     */
+    unsigned char padding_2[SLICE99_CACHE_LINE_SIZE];
+
+    /**
+     * The count of pushed slices, written by the producer.
+     */
+    size_t tail;
+
+    /**
+     * The last value of #head seen by the producer.
+     */
+    size_t cached_head;
+
+    /**
+     * Keeps the data that follows off the cache line of #tail and #cached_head.
+     */
+    unsigned char padding_3[SLICE99_CACHE_LINE_SIZE];
+} Slice99SpscQueue;
+
+// Fails to compile if the positions of the consumer and the producer can share a cache line.
+typedef char slice99_priv_spsc_queue_layout_check
+    [offsetof(Slice99SpscQueue, tail) - offsetof(Slice99SpscQueue, cached_tail) - sizeof(size_t) >=
+             SLICE99_CACHE_LINE_SIZE
+         ? 1
+         : -1];
+
+/**
+ * Constructs an empty queue using @p buffer as storage.
+ *
+ * Defined only if #Slice99SpscQueue is defined.
+ *
+ * @param[in] buffer The storage of at least @p cap slices. It must outlive the queue.
+ * @param[in] cap The capacity of the queue.
+ *
+ * @pre `buffer != NULL`
+ * @pre @p cap must be a power of two.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99SpscQueue
+Slice99SpscQueue_new(Slice99 buffer[], size_t cap) {
+    SLICE99_ASSERT(buffer);
+    SLICE99_ASSERT(cap > 0 && (cap & (cap - 1)) == 0);
+
+    Slice99SpscQueue result;
+    SLICE99_MEMSET(&result, 0, sizeof result);
+    result.items = buffer;
+    result.cap = cap;
+    return result;
+}
+
+/**
+ * Pushes up to @p n slices from @p items to @p self. Called by the producer.
+ *
+ * Defined only if #Slice99SpscQueue is defined.
+ *
+ * @param[in,out] self The queue.
+ * @param[in] items The slices to push.
+ * @param[in] n The count of @p items.
+ *
+ * @return The count of pushed slices, which is less than @p n if the queue has become full.
+ *
+ * @pre `self != NULL`
+ * @pre `items != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT size_t
+Slice99SpscQueue_push_batch(Slice99SpscQueue *self, const Slice99 *items, size_t n) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(items);
+
+    const size_t tail = self->tail, cap = self->cap;
+    if (cap - (tail - self->cached_head) < n) {
+        self->cached_head = __atomic_load_n(&self->head, __ATOMIC_ACQUIRE);
+    }
+
+    const size_t space = cap - (tail - self->cached_head);
+    if (n > space) {
+        n = space;
+    }
+
+    const size_t offset = tail & (cap - 1), until_end = cap - offset;
+    const size_t first = n < until_end ? n : until_end;
+    SLICE99_MEMCPY(self->items + offset, items, first * sizeof(Slice99));
+    SLICE99_MEMCPY(self->items, items + first, (n - first) * sizeof(Slice99));
+
+    __atomic_store_n(&self->tail, tail + n, __ATOMIC_RELEASE);
+    return n;
+}
+
+/**
+ * Pops up to @p n slices from @p self to @p out. Called by the consumer.
+ *
+ * Defined only if #Slice99SpscQueue is defined.
+ *
+ * @param[in,out] self The queue.
+ * @param[out] out The location to which the popped slices will be written.
+ * @param[in] n The capacity of @p out.
+ *
+ * @return The count of popped slices, which is less than @p n if the queue has become empty.
+ *
+ * @pre `self != NULL`
+ * @pre `out != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT size_t
+Slice99SpscQueue_pop_batch(Slice99SpscQueue *self, Slice99 *out, size_t n) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(out);
+
+    const size_t head = self->head, cap = self->cap;
+    if (self->cached_tail - head < n) {
+        self->cached_tail = __atomic_load_n(&self->tail, __ATOMIC_ACQUIRE);
+    }
+
+    const size_t available = self->cached_tail - head;
+    if (n > available) {
+        n = available;
+    }
+
+    const size_t offset = head & (cap - 1), until_end = cap - offset;
+    const size_t first = n < until_end ? n : until_end;
+    SLICE99_MEMCPY(out, self->items + offset, first * sizeof(Slice99));
+    SLICE99_MEMCPY(out + first, self->items, (n - first) * sizeof(Slice99));
+
+    __atomic_store_n(&self->head, head + n, __ATOMIC_RELEASE);
+    return n;
+}
+
+/**
+ * Pushes @p item to @p self. Called by the producer.
+ *
+ * Defined only if #Slice99SpscQueue is defined.
+ *
+ * @param[in,out] self The queue.
+ * @param[in] item The slice to push.
+ *
+ * @return `true` on success, `false` if the queue is full.
+ *
+ * @pre `self != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99SpscQueue_push(Slice99SpscQueue *self, Slice99 item) {
+    return Slice99SpscQueue_push_batch(self, &item, 1) == 1;
+}
+
+/**
+ * Pops a slice from @p self. Called by the consumer.
+ *
+ * Defined only if #Slice99SpscQueue is defined.
+ *
+ * @param[in,out] self The queue.
+ * @param[out] out The location to which the popped slice will be written.
+ *
+ * @return `true` on success, `false` if the queue is empty. In the latter case, @p out is left
+ * unchanged.
+ *
+ * @pre `self != NULL`
+ * @pre `out != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99SpscQueue_pop(Slice99SpscQueue *self, Slice99 *out) {
+    return Slice99SpscQueue_pop_batch(self, out, 1) == 1;
+}
+
+/**
+ * A cell of #Slice99MpmcQueue.
+ *
+ * Defined only if #Slice99MpmcQueue is defined.
+ */
+typedef struct {
+    /**
+     * The position for which the cell is ready: to be pushed at if it is equal to the position,
+     * to be popped at if it is greater by one.
+     */
+    size_t sequence;
+
+    /**
+     * The queued slice.
+     */
+    Slice99 item;
+} Slice99MpmcCell;
+
+/**
+ * A bounded lock-free queue of slices between any number of producer and consumer threads.
+ *
+ * This is the bounded queue of Dmitry Vyukov: each cell carries a sequence number telling whether
+ * it is free or full for the current lap, so a push or a pop is a single compare-and-swap on the
+ * shared position, and producers do not contend with consumers. The batch operations claim
+ * several consecutive cells with a single compare-and-swap.
+ *
+ * The memory ordering is the same as in #Slice99SpscQueue.
+ *
+ * This structure should not be constructed manually; use #Slice99MpmcQueue_new instead. It must
+ * not be copied after the threads have started using it.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available and the
+ * compiler provides the GNU `__atomic` built-ins (GCC 4.7+ and Clang).
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     Slice99MpmcCell cells[16];
+ *     Slice99MpmcQueue queue = Slice99MpmcQueue_new(cells, 16);
+ *
+ *     const CharSlice99 message = CharSlice99_from_str("hello");
+ *     assert(Slice99MpmcQueue_push(&queue, SLICE99_TO_UNTYPED(message)));
+ *
+ *     Slice99 item;
+ *     assert(Slice99MpmcQueue_pop(&queue, &item));
+ *     assert(CharSlice99_primitive_eq((CharSlice99)SLICE99_TO_TYPED(item), message));
+ *     assert(!Slice99MpmcQueue_pop(&queue, &item));
+ * }
+ * @endcode
+ */
+typedef struct {
+    /**
+     * The storage of #cap cells.
+     */
+    Slice99MpmcCell *cells;
+
+    /**
+     * The capacity of the queue, a power of two.
+     */
+    size_t cap;
+
+    /**
+     * Keeps #tail off the cache line of #cells.
+     */
+    unsigned char padding_1[SLICE99_CACHE_LINE_SIZE];
+
+    /**
+     * The position of the next push, shared by the producers.
+     */
+    size_t tail;
+
+    /**
+     * Keeps #head off the cache line of #tail.
+     */
+    unsigned char padding_2[SLICE99_CACHE_LINE_SIZE - sizeof(size_t)];
+
+    /**
+     * The position of the next pop, shared by the consumers.
+     */
+    size_t head;
+
+    /**
+     * Keeps the data that follows off the cache line of #head.
+     */
+    unsigned char padding_3[SLICE99_CACHE_LINE_SIZE - sizeof(size_t)];
+} Slice99MpmcQueue;
+
+/**
+ * Constructs an empty queue using @p buffer as storage.
+ *
+ * Defined only if #Slice99MpmcQueue is defined.
+ *
+ * @param[out] buffer The storage of at least @p cap cells, which will be initialised. It must
+ * outlive the queue.
+ * @param[in] cap The capacity of the queue.
+ *
+ * @pre `buffer != NULL`
+ * @pre @p cap must be a power of two.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99MpmcQueue
+Slice99MpmcQueue_new(Slice99MpmcCell buffer[], size_t cap) {
+    SLICE99_ASSERT(buffer);
+    SLICE99_ASSERT(cap > 0 && (cap & (cap - 1)) == 0);
+
+    for (size_t i = 0; i < cap; i++) {
+        buffer[i].sequence = i;
+    }
+
+    Slice99MpmcQueue result;
+    SLICE99_MEMSET(&result, 0, sizeof result);
+    result.cells = buffer;
+    result.cap = cap;
+    return result;
+}
+
+#ifndef DOXYGEN_IGNORE
+
+// Claims up to `n` consecutive cells at `*position` whose sequence numbers are `*position + i +
+// lag` (0 for pushing, 1 for popping), returning their count and start. Returns 0 if the first
+// cell is not ready, i.e., the queue is full or empty.
+inline static SLICE99_WARN_UNUSED_RESULT size_t slice99_priv_mpmc_claim(
+    Slice99MpmcQueue *self, size_t *position, size_t lag, size_t n, size_t *start) {
+    const size_t mask = self->cap - 1;
+    size_t pos = __atomic_load_n(position, __ATOMIC_RELAXED);
+
+    for (;;) {
+        size_t count = 0;
+        while (count < n) {
+            const size_t sequence =
+                __atomic_load_n(&self->cells[(pos + count) & mask].sequence, __ATOMIC_ACQUIRE);
+            if (sequence != pos + count + lag) {
+                break;
+            }
+            count++;
+        }
+
+        if (count == 0) {
+            // The cell is a lap behind (the queue is full or empty), or `pos` is stale.
+            const size_t sequence =
+                __atomic_load_n(&self->cells[pos & mask].sequence, __ATOMIC_ACQUIRE);
+            if ((ptrdiff_t)(sequence - (pos + lag)) < 0) {
+                return 0;
+            }
+            pos = __atomic_load_n(position, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        // On failure, `pos` is updated with the current position.
+        if (__atomic_compare_exchange_n(
+                position, &pos, pos + count, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            *start = pos;
+            return count;
+        }
+    }
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Pushes up to @p n slices from @p items to @p self.
+ *
+ * Defined only if #Slice99MpmcQueue is defined.
+ *
+ * @param[in,out] self The queue.
+ * @param[in] items The slices to push.
+ * @param[in] n The count of @p items.
+ *
+ * @return The count of pushed slices, which is less than @p n if the queue has become full.
+ *
+ * @pre `self != NULL`
+ * @pre `items != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT size_t
+Slice99MpmcQueue_push_batch(Slice99MpmcQueue *self, const Slice99 *items, size_t n) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(items);
+
+    size_t pushed = 0;
+    while (pushed < n) {
+        size_t start;
+        const size_t count = slice99_priv_mpmc_claim(self, &self->tail, 0, n - pushed, &start);
+        if (count == 0) {
+            break;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            Slice99MpmcCell *cell = &self->cells[(start + i) & (self->cap - 1)];
+            cell->item = items[pushed + i];
+            __atomic_store_n(&cell->sequence, start + i + 1, __ATOMIC_RELEASE);
+        }
+        pushed += count;
+    }
+
+    return pushed;
+}
+
+/**
+ * Pops up to @p n slices from @p self to @p out.
+ *
+ * Defined only if #Slice99MpmcQueue is defined.
+ *
+ * @param[in,out] self The queue.
+ * @param[out] out The location to which the popped slices will be written.
+ * @param[in] n The capacity of @p out.
+ *
+ * @return The count of popped slices, which is less than @p n if the queue has become empty.
+ *
+ * @pre `self != NULL`
+ * @pre `out != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT size_t
+Slice99MpmcQueue_pop_batch(Slice99MpmcQueue *self, Slice99 *out, size_t n) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(out);
+
+    size_t popped = 0;
+    while (popped < n) {
+        size_t start;
+        const size_t count = slice99_priv_mpmc_claim(self, &self->head, 1, n - popped, &start);
+        if (count == 0) {
+            break;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            Slice99MpmcCell *cell = &self->cells[(start + i) & (self->cap - 1)];
+            out[popped + i] = cell->item;
+            __atomic_store_n(&cell->sequence, start + i + self->cap, __ATOMIC_RELEASE);
+        }
+        popped += count;
+    }
+
+    return popped;
+}
+
+/**
+ * Pushes @p item to @p self.
+ *
+ * Defined only if #Slice99MpmcQueue is defined.
+ *
+ * @param[in,out] self The queue.
+ * @param[in] item The slice to push.
+ *
+ * @return `true` on success, `false` if the queue is full.
+ *
+ * @pre `self != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99MpmcQueue_push(Slice99MpmcQueue *self, Slice99 item) {
+    return Slice99MpmcQueue_push_batch(self, &item, 1) == 1;
+}
+
+/**
+ * Pops a slice from @p self.
+ *
+ * Defined only if #Slice99MpmcQueue is defined.
+ *
+ * @param[in,out] self The queue.
+ * @param[out] out The location to which the popped slice will be written.
+ *
+ * @return `true` on success, `false` if the queue is empty. In the latter case, @p out is left
+ * unchanged.
+ *
+ * @pre `self != NULL`
+ * @pre `out != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99MpmcQueue_pop(Slice99MpmcQueue *self, Slice99 *out) {
+    return Slice99MpmcQueue_pop_batch(self, out, 1) == 1;
+}
+
+#endif // SLICE99_PRIV_ATOMICS
+
+#endif // defined(UINT8_MAX) && defined(UINT16_MAX) && defined(UINT32_MAX) && defined(UINT64_MAX)
+
+#ifndef SLICE99_DISABLE_STDLIB
+
+/**
+ * An entry of #Slice99Map.
+ */
+typedef struct {
+    /**
+     * The key, which points to the bytes owned by the map.
+     */
+    Slice99 key;
+
+    /**
+     * The value associated with the key.
+     */
+    void *value;
+} Slice99MapEntry;
+
+/**
+ * An open-addressing hash map from slices to pointers.
+ *
+ * Keys are compared byte by byte (see #Slice99_primitive_eq) and hashed with
+ * #Slice99_primitive_hash. The bytes of every inserted key are copied into an arena owned by the
+ * map, so the caller's slice need not outlive the insertion; lookups borrow the caller's slice and
+ * neither copy nor allocate.
+ *
+ * The table follows the Swiss table design: every slot has a control byte holding either the 7 low
+ * bits of the hash of its key or a marker of an empty or deleted slot. The control bytes are probed
+ * in groups of 8, each matched against the sought 7 bits with a few word operations, so that keys
+ * are compared only when their control bytes match, and the entries are accessed only on a likely
+ * match. At most 7/8 of the slots are occupied.
+ *
+ * Inserting may move the entries, invalidating the pointers returned by the lookup functions. The
+ * keys themselves never move until #Slice99Map_free. The bytes of removed keys are reclaimed only
+ * by #Slice99Map_free.
+ *
+ * This structure should not be constructed manually; use #Slice99Map_new instead.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     Slice99Map map = Slice99Map_new(0);
+ *     int a = 1, b = 2;
+ *
+ *     assert(Slice99Map_insert(&map, SLICE99_TO_UNTYPED(CharSlice99_from_str("a")), &a));
+ *     assert(Slice99Map_insert(&map, SLICE99_TO_UNTYPED(CharSlice99_from_str("b")), &b));
+ *
+ *     const Slice99MapEntry *entry = Slice99Map_get(&map, Slice99_from_str("b"));
+ *     assert(entry != NULL && entry->value == &b);
+ *     assert(Slice99Map_get(&map, Slice99_from_str("c")) == NULL);
+ *
+ *     Slice99Map_free(&map);
+ * }
+ * @endcode
+ */
+typedef struct {
+    /**
+     * The slots, followed by `cap` control bytes in the same allocation.
+     */
+    Slice99MapEntry *entries;
+
+    /**
+     * The control bytes.
+     */
+    unsigned char *ctrl;
+
+    /**
+     * The number of slots, either zero or a power of two not less than 8.
+     */
+    size_t cap;
+
+    /**
+     * The number of entries.
+     */
+    size_t len;
+
+    /**
+     * The number of entries that can be inserted into empty slots before the table is rebuilt.
+     */
+    size_t growth_left;
+
+    /**
+     * The seed passed to #Slice99_primitive_hash.
+     */
+    uint64_t seed;
+
+    /**
+     * The storage of the keys.
+     */
+    Slice99Arena keys;
+} Slice99Map;
+
+#ifndef DOXYGEN_IGNORE
+
+#define SLICE99_PRIV_CTRL_EMPTY 0x80
+#define SLICE99_PRIV_CTRL_DELETED 0xFE
+#define SLICE99_PRIV_GROUP_SIZE 8
+
+#define SLICE99_PRIV_GROUP_LSB UINT64_C(0x0101010101010101)
+#define SLICE99_PRIV_GROUP_MSB UINT64_C(0x8080808080808080)
+
+// A group of control bytes is loaded as a little-endian word, so that the lowest set bit of a mask
+// below corresponds to the first matching slot on every platform. In every mask, only the most
+// significant bit of each byte is set.
+
+// The bytes equal to `h2`. May have false positives right after a true match, due to the borrow in
+// the subtraction; they are rejected by checking the control byte.
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST uint64_t
+slice99_priv_group_match(uint64_t group, unsigned char h2) {
+    const uint64_t x = group ^ (SLICE99_PRIV_GROUP_LSB * h2);
+    return (x - SLICE99_PRIV_GROUP_LSB) & ~x & SLICE99_PRIV_GROUP_MSB;
+}
+
+// Empty slots have the most significant bit set and bit 1 clear, unlike deleted ones.
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST uint64_t
+slice99_priv_group_match_empty(uint64_t group) {
+    return group & ~(group << 6) & SLICE99_PRIV_GROUP_MSB;
+}
+
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST uint64_t
+slice99_priv_group_match_free(uint64_t group) {
+    return group & SLICE99_PRIV_GROUP_MSB;
+}
+
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST size_t slice99_priv_group_first(uint64_t mask) {
+#ifdef __GNUC__
+    return (size_t)__builtin_ctzll((unsigned long long)mask) / 8;
+#else
+    size_t i = 0;
+    while ((mask & 0x80) == 0) {
+        mask >>= 8;
+        i++;
+    }
+    return i;
+#endif
+}
+
+inline static SLICE99_ALWAYS_INLINE size_t slice99_priv_map_probe_start(size_t cap, uint64_t hash) {
+    return (size_t)(hash >> 7) * SLICE99_PRIV_GROUP_SIZE & (cap - 1);
+}
+
+// Groups are probed triangularly, which visits every group exactly once per cycle since the number
+// of groups is a power of two.
+inline static SLICE99_WARN_UNUSED_RESULT Slice99MapEntry *
+slice99_priv_map_find(const Slice99Map *self, Slice99 key, uint64_t hash) {
+    if (self->len == 0) {
+        return NULL;
+    }
+
+    const unsigned char h2 = (unsigned char)(hash & 0x7F);
+    size_t pos = slice99_priv_map_probe_start(self->cap, hash);
+
+    for (size_t stride = SLICE99_PRIV_GROUP_SIZE;; stride += SLICE99_PRIV_GROUP_SIZE) {
+        const uint64_t group = slice99_priv_hash_read8(self->ctrl + pos);
+
+        for (uint64_t mask = slice99_priv_group_match(group, h2); mask != 0; mask &= mask - 1) {
+            const size_t i = pos + slice99_priv_group_first(mask);
+            if (self->ctrl[i] == h2 && Slice99_primitive_eq(self->entries[i].key, key)) {
+                return &self->entries[i];
+            }
+        }
+
+        if (slice99_priv_group_match_empty(group) != 0) {
+            return NULL;
+        }
+
+        pos = (pos + stride) & (self->cap - 1);
+    }
+}
+
+// Returns the first empty or deleted slot on the probe sequence of `hash`.
+inline static SLICE99_WARN_UNUSED_RESULT size_t
+slice99_priv_map_find_free(const Slice99Map *self, uint64_t hash) {
+    size_t pos = slice99_priv_map_probe_start(self->cap, hash);
+
+    for (size_t stride = SLICE99_PRIV_GROUP_SIZE;; stride += SLICE99_PRIV_GROUP_SIZE) {
+        const uint64_t group = slice99_priv_hash_read8(self->ctrl + pos);
+        const uint64_t mask = slice99_priv_group_match_free(group);
+        if (mask != 0) {
+            return pos + slice99_priv_group_first(mask);
+        }
+
+        pos = (pos + stride) & (self->cap - 1);
+    }
+}
+
+inline static SLICE99_WARN_UNUSED_RESULT bool
+slice99_priv_map_rehash(Slice99Map *self, size_t new_cap) {
+    SLICE99_ASSERT(new_cap - new_cap / 8 >= self->len);
+
+    if (new_cap > SIZE_MAX / (sizeof(Slice99MapEntry) + 1)) {
+        return false;
+    }
+
+    Slice99MapEntry *entries =
+        (Slice99MapEntry *)SLICE99_REALLOC(NULL, new_cap * (sizeof(Slice99MapEntry) + 1));
+    if (entries == NULL) {
+        return false;
+    }
+
+    Slice99Map new_map = *self;
+    new_map.entries = entries;
+    new_map.ctrl = (unsigned char *)(entries + new_cap);
+    new_map.cap = new_cap;
+    new_map.growth_left = new_cap - new_cap / 8 - self->len;
+    SLICE99_MEMSET(new_map.ctrl, SLICE99_PRIV_CTRL_EMPTY, new_cap);
+
+    for (size_t i = 0; i < self->cap; i++) {
+        if (self->ctrl[i] < SLICE99_PRIV_CTRL_EMPTY) {
+            const uint64_t hash = slice99_priv_hash(
+                self->entries[i].key.ptr, Slice99_size(self->entries[i].key), self->seed);
+            const size_t j = slice99_priv_map_find_free(&new_map, hash);
+            new_map.ctrl[j] = (unsigned char)(hash & 0x7F);
+            new_map.entries[j] = self->entries[i];
+        }
+    }
+
+    SLICE99_FREE(self->entries);
+    *self = new_map;
+    return true;
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Constructs an empty map.
+ *
+ * No memory is allocated until the first insertion.
+ *
+ * @param[in] seed The seed passed to #Slice99_primitive_hash. A secret random seed makes the map
+ * resistant to collisions forced by an adversary.
+ *
+ * @return The new map, to be released with #Slice99Map_free.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Map Slice99Map_new(uint64_t seed) {
+    const Slice99Map map = {
+        .entries = NULL,
+        .ctrl = NULL,
+        .cap = 0,
+        .len = 0,
+        .growth_left = 0,
+        .seed = seed,
+        .keys = Slice99Arena_new(NULL, 0),
+    };
+    return map;
+}
+
+/**
+ * Releases the memory owned by @p self, including the bytes of its keys.
+ *
+ * After this call, @p self is an empty map with the same seed.
+ *
+ * @param[in,out] self The map to release.
+ *
+ * @pre `self != NULL`
+ */
+inline static void Slice99Map_free(Slice99Map *self) {
+    SLICE99_ASSERT(self);
+
+    SLICE99_FREE(self->entries);
+    Slice99Arena_free(&self->keys);
+    *self = Slice99Map_new(self->seed);
+}
+
+/**
+ * Ensures that @p self can hold at least @p additional more entries without rebuilding its table.
+ *
+ * @param[in,out] self The map to grow.
+ * @param[in] additional The number of entries to make room for.
+ *
+ * @return `true` on success, `false` if the allocation has failed. In the latter case, @p self is
+ * left unchanged.
+ *
+ * @pre `self != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99Map_reserve(Slice99Map *self, size_t additional) {
+    SLICE99_ASSERT(self);
+
+    if (additional <= self->growth_left) {
+        return true;
+    }
+
+    if (additional > SIZE_MAX / 2 - self->len) {
+        return false;
+    }
+
+    const size_t required = self->len + additional;
+    size_t new_cap = SLICE99_PRIV_GROUP_SIZE;
+    while (new_cap - new_cap / 8 < required) {
+        if (new_cap > SIZE_MAX / 2) {
+            return false;
+        }
+        new_cap *= 2;
+    }
+
+    return slice99_priv_map_rehash(self, new_cap);
+}
+
+/**
+ * Looks up @p key in @p self.
+ *
+ * @param[in] self The map to search in.
+ * @param[in] key The key to look up, which is only borrowed.
+ *
+ * @return A pointer to the entry with a key equal to @p key, or `NULL` if there is no such entry.
+ * The pointer is valid until the next insertion.
+ *
+ * @pre `self != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99MapEntry *
+Slice99Map_get(const Slice99Map *self, Slice99 key) {
+    SLICE99_ASSERT(self);
+
+    const uint64_t hash = slice99_priv_hash(key.ptr, Slice99_size(key), self->seed);
+    return slice99_priv_map_find(self, key, hash);
+}
+
+/**
+ * Looks up @p key in @p self, inserting an entry with a `NULL` value if there is none.
+ *
+ * When an entry is inserted, the bytes of @p key are copied to the map.
+ *
+ * @param[in,out] self The map to search in.
+ * @param[in] key The key to look up.
+ * @param[out] inserted The location to which `true` is written if the entry has been inserted,
+ * `false` otherwise. May be `NULL`.
+ *
+ * @return A pointer to the entry with a key equal to @p key, or `NULL` if the allocation has
+ * failed. The pointer is valid until the next insertion.
+ *
+ * @pre `self != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99MapEntry *
+Slice99Map_entry(Slice99Map *restrict self, Slice99 key, bool *restrict inserted) {
+    SLICE99_ASSERT(self);
+
+    const uint64_t hash = slice99_priv_hash(key.ptr, Slice99_size(key), self->seed);
+
+    Slice99MapEntry *entry = slice99_priv_map_find(self, key, hash);
+    if (entry != NULL) {
+        if (inserted != NULL) {
+            *inserted = false;
+        }
+        return entry;
+    }
+
+    if (self->growth_left == 0) {
+        size_t new_cap = SLICE99_PRIV_GROUP_SIZE;
+        if (self->cap != 0) {
+            // Reclaim the deleted slots if they are at least half of the occupied ones.
+            new_cap = self->cap;
+            if (self->len > (self->cap - self->cap / 8) / 2) {
+                if (self->cap > SIZE_MAX / 2) {
+                    return NULL;
+                }
+                new_cap *= 2;
+            }
+        }
+        if (!slice99_priv_map_rehash(self, new_cap)) {
+            return NULL;
+        }
+    }
+
+    Slice99 key_copy;
+    if (!Slice99_arena_dup(key, &self->keys, &key_copy)) {
+        return NULL;
+    }
+
+    const size_t i = slice99_priv_map_find_free(self, hash);
+    if (self->ctrl[i] == SLICE99_PRIV_CTRL_EMPTY) {
+        self->growth_left--;
+    }
+
+    self->ctrl[i] = (unsigned char)(hash & 0x7F);
+    self->entries[i].key = key_copy;
+    self->entries[i].value = NULL;
+    self->len++;
+
+    if (inserted != NULL) {
+        *inserted = true;
+    }
+    return &self->entries[i];
+}
+
+/**
+ * Associates @p value with @p key in @p self, replacing the previous value if any.
+ *
+ * @param[in,out] self The map to insert into.
+ * @param[in] key The key, copied to the map if it is not there yet.
+ * @param[in] value The value.
+ *
+ * @return `true` on success, `false` if the allocation has failed. In the latter case, @p self is
+ * left unchanged.
+ *
+ * @pre `self != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99Map_insert(Slice99Map *self, Slice99 key, void *value) {
+    Slice99MapEntry *entry = Slice99Map_entry(self, key, NULL);
+    if (entry == NULL) {
+        return false;
+    }
+
+    entry->value = value;
+    return true;
+}
+
+/**
+ * Removes the entry with a key equal to @p key from @p self.
+ *
+ * @param[in,out] self The map to remove from.
+ * @param[in] key The key to look up.
+ *
+ * @return `true` if the entry has been removed, `false` if there is no such entry.
+ *
+ * @pre `self != NULL`
+ */
+inline static bool Slice99Map_remove(Slice99Map *self, Slice99 key) {
+    SLICE99_ASSERT(self);
+
+    const Slice99MapEntry *entry = Slice99Map_get(self, key);
+    if (entry == NULL) {
+        return false;
+    }
+
+    const size_t i = (size_t)(entry - self->entries);
+    const size_t group = i & ~(size_t)(SLICE99_PRIV_GROUP_SIZE - 1);
+
+    // Probing stops at a group with an empty slot, so if there is one, no probe sequence continues
+    // past this group, and the slot can become empty instead of deleted.
+    if (slice99_priv_group_match_empty(slice99_priv_hash_read8(self->ctrl + group)) != 0) {
+        self->ctrl[i] = SLICE99_PRIV_CTRL_EMPTY;
+        self->growth_left++;
+    } else {
+        self->ctrl[i] = SLICE99_PRIV_CTRL_DELETED;
+    }
+
+    self->len--;
+    return true;
+}
+
+/**
+ * Iterates over the entries of @p self in an unspecified order.
+ *
+ * @param[in] self The map to iterate over.
+ * @param[in,out] cursor The iteration state, initially 0.
+ * @param[out] entry The location to which the next entry is written.
+ *
+ * @return `true` if an entry has been written to @p entry, `false` if the iteration is over.
+ *
+ * @pre `self != NULL`
+ * @pre `cursor != NULL`
+ * @pre `entry != NULL`
+ * @pre @p self must not be modified during the iteration, except for the values of its entries.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool Slice99Map_next(
+    const Slice99Map *restrict self, size_t *restrict cursor, Slice99MapEntry **restrict entry) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(cursor);
+    SLICE99_ASSERT(entry);
+
+    for (; *cursor < self->cap; (*cursor)++) {
+        if (self->ctrl[*cursor] < SLICE99_PRIV_CTRL_EMPTY) {
+            *entry = &self->entries[(*cursor)++];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#ifndef DOXYGEN_IGNORE
+
+#ifdef SLICE99_PRIV_ATOMICS
+#define SLICE99_PRIV_LOAD_ACQUIRE(ptr)         __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define SLICE99_PRIV_STORE_RELEASE(ptr, value) __atomic_store_n(ptr, value, __ATOMIC_RELEASE)
+#else
+#define SLICE99_PRIV_LOAD_ACQUIRE(ptr)         (*(ptr))
+#define SLICE99_PRIV_STORE_RELEASE(ptr, value) ((void)(*(ptr) = (value)))
+#endif
+
+#define SLICE99_PRIV_INTERNER_MIN_CAP 16
+
+// A lookup table of `CharSlice99Interner`, which is never modified after being replaced.
+struct slice99_priv_interner_table {
+    // The table replaced by this one, freed only by `CharSlice99Interner_free` since concurrent
+    // lookups may still be reading it.
+    struct slice99_priv_interner_table *retired;
+
+    // The number of slots, a power of two. At most half of them are occupied.
+    size_t cap;
+
+    // The identifiers plus one, or 0 for the empty slots. Stored after `strs`.
+    uint32_t *slots;
+
+    // The interned strings indexed by identifier, with room for `cap / 2` of them.
+    CharSlice99 strs[];
+};
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * A string interning pool.
+ *
+ * Interning a string returns its 32-bit identifier: equal strings have the same identifier and the
+ * identifiers are assigned consecutively from 0. Each distinct string is stored once in an
+ * append-only arena, so its canonical copy (see #CharSlice99Interner_str) never moves until
+ * #CharSlice99Interner_free. Thus, interned strings are compared by identifier instead of by
+ * contents, and two canonical copies are equal if and only if their `ptr` and `len` are equal.
+ *
+ * The strings are looked up in an open-addressing table of identifiers. If the compiler provides
+ * the GNU `__atomic` built-ins (GCC 4.7+ and Clang), #CharSlice99Interner_get and
+ * #CharSlice99Interner_str are lock-free and can run concurrently with #CharSlice99Interner_intern,
+ * which must still be serialized by the caller: a new identifier is published with a release store
+ * after its string, and a full table is replaced by a bigger copy instead of being resized in
+ * place. The replaced tables are kept until #CharSlice99Interner_free, which at most doubles the
+ * memory used by the tables. Otherwise, the lookups are only safe to run concurrently with each
+ * other.
+ *
+ * This structure should not be constructed manually; use #CharSlice99Interner_new instead.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     CharSlice99Interner interner = CharSlice99Interner_new(0);
+ *     char buffer[] = "abc";
+ *     uint32_t a, b, c;
+ *
+ *     assert(CharSlice99Interner_intern(&interner, CharSlice99_from_str("abc"), &a));
+ *     assert(CharSlice99Interner_intern(&interner, CharSlice99_from_str("xyz"), &b));
+ *     assert(CharSlice99Interner_intern(&interner, CharSlice99_from_str(buffer), &c));
+ *     assert(a == 0 && b == 1 && c == a);
+ *
+ *     const CharSlice99 str = CharSlice99Interner_str(&interner, c);
+ *     assert(str.ptr != buffer && CharSlice99_primitive_eq(str, CharSlice99_from_str("abc")));
+ *
+ *     CharSlice99Interner_free(&interner);
+ * }
+ * @endcode
+ */
+typedef struct {
+    /**
+     * The seed passed to #Slice99_primitive_hash.
+     */
+    uint64_t seed;
+
+    /**
+     * The storage of the interned strings.
+     */
+    Slice99Arena bytes;
+
+    /**
+     * The current lookup table, which links to the tables it has replaced.
+     */
+    struct slice99_priv_interner_table *table;
+
+    /**
+     * The number of interned strings.
+     */
+    size_t len;
+} CharSlice99Interner;
+
+#ifndef DOXYGEN_IGNORE
+
+// Returns the identifier plus one stored in the slot of `str`, or 0 if `str` is not in `table`.
+// Either way, `*slot` is the index of that slot.
+inline static SLICE99_WARN_UNUSED_RESULT uint32_t slice99_priv_interner_find(
+    const struct slice99_priv_interner_table *table, CharSlice99 str, uint64_t hash,
+    size_t *slot) {
+    const size_t mask = table->cap - 1;
+
+    for (size_t i = (size_t)hash & mask;; i = (i + 1) & mask) {
+        const uint32_t value = SLICE99_PRIV_LOAD_ACQUIRE(&table->slots[i]);
+        if (value == 0 || CharSlice99_primitive_eq(table->strs[value - 1], str)) {
+            *slot = i;
+            return value;
+        }
+    }
+}
+
+// Publishes a copy of the current table with twice as many slots.
+inline static SLICE99_WARN_UNUSED_RESULT bool
+slice99_priv_interner_grow(CharSlice99Interner *self) {
+    struct slice99_priv_interner_table *old = self->table;
+    const size_t per_str = sizeof(CharSlice99) + 2 * sizeof(uint32_t);
+
+    if (old != NULL && old->cap > (SIZE_MAX - sizeof(*old)) / per_str) {
+        return false;
+    }
+    const size_t cap = old != NULL ? old->cap * 2 : SLICE99_PRIV_INTERNER_MIN_CAP,
+                 size = sizeof(*old) + cap / 2 * per_str;
+
+    struct slice99_priv_interner_table *table =
+        (struct slice99_priv_interner_table *)SLICE99_REALLOC(NULL, size);
+    if (table == NULL) {
+        return false;
+    }
+
+    table->retired = old;
+    table->cap = cap;
+    table->slots = (uint32_t *)(void *)(table->strs + cap / 2);
+    SLICE99_MEMSET(table->slots, 0, cap * sizeof(uint32_t));
+
+    for (size_t id = 0; id < self->len; id++) {
+        const CharSlice99 str = old->strs[id];
+        size_t slot;
+        const uint32_t found = slice99_priv_interner_find(
+            table, str, slice99_priv_hash(str.ptr, str.len, self->seed), &slot);
+        SLICE99_ASSERT(found == 0);
+        (void)found;
+
+        table->strs[id] = str;
+        table->slots[slot] = (uint32_t)id + 1;
+    }
+
+    SLICE99_PRIV_STORE_RELEASE(&self->table, table);
+    return true;
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Constructs an empty interning pool.
+ *
+ * No memory is allocated until the first string is interned.
+ *
+ * @param[in] seed The seed passed to #Slice99_primitive_hash. A secret random seed makes the pool
+ * resistant to collisions forced by an adversary.
+ *
+ * @return The new pool, to be released with #CharSlice99Interner_free.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT CharSlice99Interner
+CharSlice99Interner_new(uint64_t seed) {
+    const CharSlice99Interner interner = {
+        .seed = seed,
+        .bytes = Slice99Arena_new(NULL, 0),
+        .table = NULL,
+        .len = 0,
+    };
+    return interner;
+}
+
+/**
+ * Releases the memory owned by @p self, including all the interned strings.
+ *
+ * After this call, @p self is an empty pool with the same seed.
+ *
+ * @param[in,out] self The pool to release.
+ *
+ * @pre `self != NULL`
+ * @pre No other thread is using @p self.
+ */
+inline static void CharSlice99Interner_free(CharSlice99Interner *self) {
+    SLICE99_ASSERT(self);
+
+    for (struct slice99_priv_interner_table *table = self->table; table != NULL;) {
+        struct slice99_priv_interner_table *retired = table->retired;
+        SLICE99_FREE(table);
+        table = retired;
+    }
+    Slice99Arena_free(&self->bytes);
+    *self = CharSlice99Interner_new(self->seed);
+}
+
+/**
+ * Interns @p str into @p self.
+ *
+ * If a string equal to @p str has not been interned yet, its bytes are copied to @p self and it is
+ * assigned the next identifier.
+ *
+ * @param[in,out] self The pool to intern into.
+ * @param[in] str The string to intern, which is only borrowed.
+ * @param[out] id The location to which the identifier of @p str will be written.
+ *
+ * @return `true` on success, `false` if the allocation has failed or the identifiers are
+ * exhausted, which happens after interning `UINT32_MAX` strings. In the latter case, @p self and
+ * @p id are left unchanged.
+ *
+ * @pre `self != NULL`
+ * @pre `id != NULL`
+ * @pre No other thread is interning into @p self.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool CharSlice99Interner_intern(
+    CharSlice99Interner *restrict self, CharSlice99 str, uint32_t *restrict id) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(id);
+
+    const uint64_t hash = slice99_priv_hash(str.ptr, str.len, self->seed);
+    size_t slot = 0;
+
+    if (self->table != NULL) {
+        const uint32_t found = slice99_priv_interner_find(self->table, str, hash, &slot);
+        if (found != 0) {
+            *id = found - 1;
+            return true;
+        }
+    }
+
+#if SIZE_MAX > UINT32_MAX
+    // The slots hold the identifiers plus one.
+    if (self->len == UINT32_MAX) {
+        return false;
+    }
+#endif
+
+    if (self->table == NULL || self->len == self->table->cap / 2) {
+        if (!slice99_priv_interner_grow(self)) {
+            return false;
+        }
+
+        const uint32_t found = slice99_priv_interner_find(self->table, str, hash, &slot);
+        SLICE99_ASSERT(found == 0);
+        (void)found;
+    }
+
+    Slice99 copy;
+    if (!Slice99_arena_dup(SLICE99_TO_UNTYPED(str), &self->bytes, &copy)) {
+        return false;
+    }
+
+    // Concurrent lookups find the new identifier only after its string, and the pool length only
+    // after both.
+    self->table->strs[self->len] = CharSlice99_new((char *)copy.ptr, copy.len);
+    SLICE99_PRIV_STORE_RELEASE(&self->table->slots[slot], (uint32_t)self->len + 1);
+    *id = (uint32_t)self->len;
+    SLICE99_PRIV_STORE_RELEASE(&self->len, self->len + 1);
+    return true;
+}
+
+/**
+ * Finds the identifier of @p str in @p self without interning it.
+ *
+ * Lock-free and safe to call concurrently with #CharSlice99Interner_intern if the compiler
+ * provides the GNU `__atomic` built-ins. A string interned concurrently may be not found yet.
+ *
+ * @param[in] self The pool to search in.
+ * @param[in] str The string to look up.
+ * @param[out] id The location to which the identifier of @p str will be written.
+ *
+ * @return `true` if @p str has been interned, `false` otherwise. In the latter case, @p id is left
+ * unchanged.
+ *
+ * @pre `self != NULL`
+ * @pre `id != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool CharSlice99Interner_get(
+    const CharSlice99Interner *restrict self, CharSlice99 str, uint32_t *restrict id) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(id);
+
+    const struct slice99_priv_interner_table *table = SLICE99_PRIV_LOAD_ACQUIRE(&self->table);
+    if (table == NULL) {
+        return false;
+    }
+
+    size_t slot;
+    const uint32_t found = slice99_priv_interner_find(
+        table, str, slice99_priv_hash(str.ptr, str.len, self->seed), &slot);
+    if (found == 0) {
+        return false;
+    }
+
+    *id = found - 1;
+    return true;
+}
+
+/**
+ * Returns the canonical copy of the string interned as @p id.
+ *
+ * Lock-free and safe to call concurrently with #CharSlice99Interner_intern if the compiler
+ * provides the GNU `__atomic` built-ins.
+ *
+ * @param[in] self The pool to search in.
+ * @param[in] id The identifier returned by #CharSlice99Interner_intern or
+ * #CharSlice99Interner_get.
+ *
+ * @return The interned string, valid until #CharSlice99Interner_free.
+ *
+ * @pre `self != NULL`
+ * @pre `id < self->len`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT CharSlice99
+CharSlice99Interner_str(const CharSlice99Interner *self, uint32_t id) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(id < SLICE99_PRIV_LOAD_ACQUIRE(&self->len));
+
+    return SLICE99_PRIV_LOAD_ACQUIRE(&self->table)->strs[id];
+}
+
+#ifdef SLICE99_PRIV_ATOMICS
+
+#ifndef DOXYGEN_IGNORE
+
+struct slice99_priv_shared_block {
+    size_t refcount;
+
+    // Aligns the items for any type.
+    union {
+        long double ld;
+        long long ll;
+        void *ptr;
+        void (*fn)(void);
+    } data[];
+};
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * A reference-counted handle to a view of a heap-allocated buffer.
+ *
+ * Every handle owns one reference to the buffer; the buffer is freed along with its last
+ * reference. Handing the buffer to another consumer with #Slice99Shared_share or
+ * #Slice99Shared_sub costs a single atomic increment and copies no items, and handles can be
+ * released from any thread.
+ *
+ * The items of a shared buffer must not be modified; call #Slice99Shared_make_mut first, which
+ * copies the viewed items only if there are other handles to the buffer.
+ *
+ * Defined only if `SLICE99_DISABLE_STDLIB` is **not** defined and the compiler provides the GNU
+ * `__atomic` built-ins (GCC 4.7+ and Clang).
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ * #include <string.h>
+ *
+ * #define SUBSCRIBERS 4
+ *
+ * int main(void) {
+ *     Slice99Shared message;
+ *     if (!Slice99Shared_new(1, 1024 * 1024, &message)) {
+ *         return 1;
+ *     }
+ *     memset(message.slice.ptr, 'x', message.slice.len);
+ *
+ *     // No copies are made.
+ *     Slice99Shared subscribers[SUBSCRIBERS];
+ *     for (int i = 0; i < SUBSCRIBERS; i++) {
+ *         subscribers[i] = Slice99Shared_share(message);
+ *     }
+ *     Slice99Shared_release(message);
+ *
+ *     // The first subscriber gets its own copy, because the buffer is shared.
+ *     if (!Slice99Shared_make_mut(&subscribers[0])) {
+ *         return 1;
+ *     }
+ *     *(char *)subscribers[0].slice.ptr = 'y';
+ *     assert(*(char *)subscribers[1].slice.ptr == 'x');
+ *
+ *     for (int i = 0; i < SUBSCRIBERS; i++) {
+ *         Slice99Shared_release(subscribers[i]);
+ *     }
+ * }
+ * @endcode
+ */
+typedef struct {
+    /**
+     * The items viewed by this handle.
+     */
+    Slice99 slice;
+
+    /**
+     * The buffer containing #slice and its reference count.
+     */
+    struct slice99_priv_shared_block *block;
+} Slice99Shared;
+
+/**
+ * Allocates a buffer of @p len uninitialised items of @p item_size bytes each.
+ *
+ * Defined only if #Slice99Shared is defined.
+ *
+ * @param[in] item_size The value of Slice99#item_size.
+ * @param[in] len The number of items.
+ * @param[out] out The location to which the only handle to the buffer will be written.
+ *
+ * @return `true` on success, `false` if the memory cannot be allocated. In the latter case, @p out
+ * is left unchanged.
+ *
+ * @pre `item_size > 0`
+ * @pre `out != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99Shared_new(size_t item_size, size_t len, Slice99Shared *out) {
+    SLICE99_ASSERT(item_size > 0);
+    SLICE99_ASSERT(out);
+
+    if (len > (SIZE_MAX - sizeof(struct slice99_priv_shared_block)) / item_size) {
+        return false;
+    }
+
+    struct slice99_priv_shared_block *block = (struct slice99_priv_shared_block *)SLICE99_REALLOC(
+        NULL, sizeof(*block) + item_size * len);
+    if (block == NULL) {
+        return false;
+    }
+
+    block->refcount = 1;
+
+    const Slice99Shared result = {
+        .slice = Slice99_new(block->data, item_size, len),
+        .block = block,
+    };
+    *out = result;
+    return true;
+}
+
+/**
+ * Allocates a buffer holding a copy of @p slice.
+ *
+ * Defined only if #Slice99Shared is defined.
+ *
+ * @param[in] slice The items to copy.
+ * @param[out] out The location to which the only handle to the buffer will be written.
+ *
+ * @return `true` on success, `false` if the memory cannot be allocated. In the latter case, @p out
+ * is left unchanged.
+ *
+ * @pre `out != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99Shared_from_slice(Slice99 slice, Slice99Shared *out) {
+    SLICE99_ASSERT(out);
+
+    Slice99Shared result;
+    if (!Slice99Shared_new(slice.item_size, slice.len, &result)) {
+        return false;
+    }
+
+    Slice99_copy_non_overlapping(result.slice, slice);
+    *out = result;
+    return true;
+}
+
+/**
+ * Makes another handle to the buffer of @p self.
+ *
+ * Defined only if #Slice99Shared is defined.
+ *
+ * @param[in] self The handle to share.
+ *
+ * @return A handle viewing the same items as @p self, to be released separately.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Shared Slice99Shared_share(Slice99Shared self) {
+    // A new reference can only be made from an existing one, so nothing has to be synchronised.
+    __atomic_fetch_add(&self.block->refcount, 1, __ATOMIC_RELAXED);
+    return self;
+}
+
+/**
+ * Makes another handle to the buffer of @p self, viewing [@p start_idx `..` @p end_idx] of
+ * `self.slice`.
+ *
+ * The returned handle keeps the whole buffer alive, even after @p self has been released.
+ *
+ * Defined only if #Slice99Shared is defined.
+ *
+ * @param[in] self The handle to share.
+ * @param[in] start_idx The index at which the new view will reside, inclusively.
+ * @param[in] end_idx The index at which the new view will end, exclusively.
+ *
+ * @return A handle to be released separately.
+ *
+ * @pre `0 <= start_idx && start_idx <= end_idx && end_idx <= self.slice.len`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT Slice99Shared
+Slice99Shared_sub(Slice99Shared self, ptrdiff_t start_idx, ptrdiff_t end_idx) {
+    SLICE99_ASSERT(0 <= start_idx && start_idx <= end_idx);
+    SLICE99_ASSERT((size_t)end_idx <= self.slice.len);
+
+    Slice99Shared result = Slice99Shared_share(self);
+    result.slice = Slice99_sub(self.slice, start_idx, end_idx);
+    return result;
+}
+
+/**
+ * Releases @p self, freeing the buffer if it was the last handle to it.
+ *
+ * Defined only if #Slice99Shared is defined.
+ *
+ * @param[in] self The handle to release. It must not be used afterwards.
+ */
+inline static void Slice99Shared_release(Slice99Shared self) {
+    // Acquire-release, so that all accesses through the other handles happen before freeing.
+    if (__atomic_sub_fetch(&self.block->refcount, 1, __ATOMIC_ACQ_REL) == 0) {
+        SLICE99_FREE(self.block);
+    }
+}
+
+/**
+ * Checks whether @p self is the only handle to its buffer.
+ *
+ * Defined only if #Slice99Shared is defined.
+ *
+ * @param[in] self The checked handle.
+ *
+ * @return `true` if the items of @p self can be modified, otherwise `false`.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool Slice99Shared_is_unique(Slice99Shared self) {
+    // Acquire, so that the accesses through the released handles happen before the modification.
+    return __atomic_load_n(&self.block->refcount, __ATOMIC_ACQUIRE) == 1;
+}
+
+/**
+ * Ensures that @p self is the only handle to its buffer, so that `self->slice` can be modified.
+ *
+ * If @p self is not unique, its items are copied into a new buffer that replaces the reference of
+ * @p self to the old one. Other handles are not affected.
+ *
+ * Defined only if #Slice99Shared is defined.
+ *
+ * @param[in,out] self The handle to make unique.
+ *
+ * @return `true` on success, `false` if the memory cannot be allocated. In the latter case, @p self
+ * is left unchanged.
+ *
+ * @pre `self != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool Slice99Shared_make_mut(Slice99Shared *self) {
+    SLICE99_ASSERT(self);
+
+    if (Slice99Shared_is_unique(*self)) {
+        return true;
+    }
+
+    Slice99Shared copy;
+    if (!Slice99Shared_from_slice(self->slice, &copy)) {
+        return false;
+    }
+
+    Slice99Shared_release(*self);
+    *self = copy;
+    return true;
+}
+
+#endif // SLICE99_PRIV_ATOMICS
+
+#endif // SLICE99_DISABLE_STDLIB
+
+/**
+ * The maximum number of characters written by #CharSlice99_write_u64.
+ */
+#define SLICE99_U64_STR_MAX 20
+
+/**
+ * The maximum number of characters written by #CharSlice99_write_i64.
+ */
+#define SLICE99_I64_STR_MAX 20
+
+#ifndef DOXYGEN_IGNORE
+
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST bool slice99_priv_is_digit(char c) {
+    return (unsigned char)(c - '0') < 10;
+}
+
+// Checks that the 8 bytes of the little-endian word `x` are all decimal digits.
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST bool slice99_priv_is_8_digits(uint64_t x) {
+    const uint64_t high = UINT64_C(0xF0F0F0F0F0F0F0F0);
+    return ((x & high) | (((x + UINT64_C(0x0606060606060606)) & high) >> 4)) ==
+           UINT64_C(0x3333333333333333);
+}
+
+// Converts the 8 decimal digits of the little-endian word `x`, most significant digit first, in
+// three multiplications: pairs, quadruples, and then the whole number are combined in parallel.
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST uint64_t slice99_priv_parse_8_digits(uint64_t x) {
+    const uint64_t mask = UINT64_C(0x000000FF000000FF);
+    const uint64_t mul1 = UINT64_C(0x000F424000000064); // 100 + (1000000 << 32)
+    const uint64_t mul2 = UINT64_C(0x0000271000000001); // 1 + (10000 << 32)
+
+    x -= UINT64_C(0x3030303030303030);
+    x = x * 10 + (x >> 8);
+    return ((x & mask) * mul1 + ((x >> 16) & mask) * mul2) >> 32;
+}
+
+// Returns the number of decimal digits at the start of `p[0..len)`.
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE size_t
+slice99_priv_count_digits(const char *p, size_t len) {
+    size_t i = 0;
+    while (len - i >= 8 &&
+           slice99_priv_is_8_digits(slice99_priv_hash_read8((const unsigned char *)p + i))) {
+        i += 8;
+    }
+    while (i < len && slice99_priv_is_digit(p[i])) {
+        i++;
+    }
+    return i;
+}
+
+// Converts the `n` decimal digits at `p`, whose value must be less than 10^19.
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE uint64_t
+slice99_priv_parse_digits(const char *p, size_t n) {
+    uint64_t x = 0;
+    size_t i = 0;
+    for (; n - i >= 8; i += 8) {
+        x = x * 100000000 +
+            slice99_priv_parse_8_digits(slice99_priv_hash_read8((const unsigned char *)p + i));
+    }
+    for (; i < n; i++) {
+        x = x * 10 + (uint64_t)(p[i] - '0');
+    }
+    return x;
+}
+
+// Converts the `n` decimal digits at `p`, failing if there are none or the value does not fit.
+inline static SLICE99_WARN_UNUSED_RESULT bool
+slice99_priv_parse_u64_digits(const char *restrict p, size_t n, uint64_t *restrict out) {
+    if (n == 0) {
+        return false;
+    }
+
+    while (n > 1 && *p == '0') {
+        p++;
+        n--;
+    }
+
+    // Up to 19 digits always fit; the 20th one may overflow.
+    if (n > 20) {
+        return false;
+    }
+
+    uint64_t x = slice99_priv_parse_digits(p, n < 19 ? n : 19);
+    if (n == 20) {
+        const uint64_t digit = (uint64_t)(p[19] - '0');
+        if (x > (UINT64_MAX - digit) / 10) {
+            return false;
+        }
+        x = x * 10 + digit;
+    }
+
+    *out = x;
+    return true;
+}
+
+inline static SLICE99_WARN_UNUSED_RESULT bool
+slice99_priv_parse_finish(CharSlice99 self, size_t consumed, CharSlice99 *rest) {
+    if (rest == NULL) {
+        return consumed == self.len;
+    }
+
+    *rest = CharSlice99_advance(self, (ptrdiff_t)consumed);
+    return true;
+}
+
+// "00", "01", ..., "99".
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST const char *slice99_priv_digit_pairs(void) {
+    static const char pairs[] = "00010203040506070809"
+                                "10111213141516171819"
+                                "20212223242526272829"
+                                "30313233343536373839"
+                                "40414243444546474849"
+                                "50515253545556575859"
+                                "60616263646566676869"
+                                "70717273747576777879"
+                                "80818283848586878889"
+                                "90919293949596979899";
+    return pairs;
+}
+
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST size_t slice99_priv_num_digits(uint64_t x) {
+    for (size_t n = 1;; n += 4) {
+        if (x < 10) {
+            return n;
+        }
+        if (x < 100) {
+            return n + 1;
+        }
+        if (x < 1000) {
+            return n + 2;
+        }
+        if (x < 10000) {
+            return n + 3;
+        }
+        x /= 10000;
+    }
+}
+
+// Writes the decimal digits of `x` backwards, so that the last one is right before `end`.
+inline static void slice99_priv_write_digits(char *end, uint64_t x) {
+    const char *pairs = slice99_priv_digit_pairs();
+
+    while (x >= 100) {
+        const size_t i = (size_t)(x % 100) * 2;
+        x /= 100;
+        end -= 2;
+        end[0] = pairs[i];
+        end[1] = pairs[i + 1];
+    }
+
+    if (x >= 10) {
+        end[-2] = pairs[x * 2];
+        end[-1] = pairs[x * 2 + 1];
+    } else {
+        end[-1] = (char)('0' + x);
+    }
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Parses an unsigned decimal integer at the start of @p self.
+ *
+ * The integer consists of one or more decimal digits, without a sign, leading whitespace, or a
+ * base prefix. Unlike `strtoull`, this function does not require a null-terminated string and does
+ * not depend on the locale. Eight digits at a time are validated and converted with word
+ * operations.
+ *
+ * @param[in] self The characters to parse.
+ * @param[out] out The location to which the integer will be written.
+ * @param[out] rest The location to which the characters following the integer will be written. If
+ * `NULL`, @p self must consist of the integer only.
+ *
+ * @return `true` on success, `false` if there is no integer, if it does not fit into `uint64_t`,
+ * or if @p rest is `NULL` and the integer is followed by other characters. In the latter case,
+ * @p out and @p rest are left unchanged.
+ *
+ * @pre `out != NULL`
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     CharSlice99 rest;
+ *     uint64_t x;
+ *
+ *     assert(CharSlice99_parse_u64(CharSlice99_from_str("123,456"), &x, &rest));
+ *     assert(x == 123);
+ *     assert(CharSlice99_primitive_eq(rest, CharSlice99_from_str(",456")));
+ *
+ *     assert(CharSlice99_parse_u64(CharSlice99_from_str("18446744073709551615"), &x, NULL));
+ *     assert(!CharSlice99_parse_u64(CharSlice99_from_str("18446744073709551616"), &x, NULL));
+ *     assert(!CharSlice99_parse_u64(CharSlice99_from_str("123,456"), &x, NULL));
+ * }
+ * @endcode
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+CharSlice99_parse_u64(CharSlice99 self, uint64_t *restrict out, CharSlice99 *restrict rest) {
+    SLICE99_ASSERT(out);
+
+    const size_t n = slice99_priv_count_digits(self.ptr, self.len);
+
+    uint64_t x;
+    if (!slice99_priv_parse_u64_digits(self.ptr, n, &x) ||
+        !slice99_priv_parse_finish(self, n, rest)) {
+        return false;
+    }
+
+    *out = x;
+    return true;
+}
+
+/**
+ * Parses a signed decimal integer at the start of @p self.
+ *
+ * The same as #CharSlice99_parse_u64, except that the digits may be preceded by `+` or `-`, and the
+ * integer must fit into `int64_t`.
+ *
+ * @pre `out != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+CharSlice99_parse_i64(CharSlice99 self, int64_t *restrict out, CharSlice99 *restrict rest) {
+    SLICE99_ASSERT(out);
+
+    const size_t sign = self.len > 0 && (self.ptr[0] == '-' || self.ptr[0] == '+');
+    const bool negative = sign == 1 && self.ptr[0] == '-';
+    const size_t n = slice99_priv_count_digits(self.ptr + sign, self.len - sign);
+
+    uint64_t magnitude;
+    if (!slice99_priv_parse_u64_digits(self.ptr + sign, n, &magnitude) ||
+        magnitude > (uint64_t)INT64_MAX + negative ||
+        !slice99_priv_parse_finish(self, sign + n, rest)) {
+        return false;
+    }
+
+    // Negating in `int64_t` avoids converting the out-of-range magnitude of `INT64_MIN`.
+    *out = negative ? -(int64_t)(magnitude - 1) - 1 : (int64_t)magnitude;
+    return true;
+}
+
+/**
+ * Writes @p x in decimal to @p out.
+ *
+ * No null character is written.
+ *
+ * @param[out] out The buffer of at least #SLICE99_U64_STR_MAX characters.
+ * @param[in] x The integer to write.
+ *
+ * @return The slice of the characters written to @p out.
+ *
+ * @pre `out != NULL`
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     char buffer[SLICE99_I64_STR_MAX];
+ *
+ *     assert(CharSlice99_primitive_eq(
+ *         CharSlice99_write_u64(buffer, 12345), CharSlice99_from_str("12345")));
+ *     assert(CharSlice99_primitive_eq(
+ *         CharSlice99_write_i64(buffer, -42), CharSlice99_from_str("-42")));
+ * }
+ * @endcode
+ */
+inline static SLICE99_WARN_UNUSED_RESULT CharSlice99
+CharSlice99_write_u64(char out[restrict], uint64_t x) {
+    SLICE99_ASSERT(out);
+
+    const size_t n = slice99_priv_num_digits(x);
+    slice99_priv_write_digits(out + n, x);
+    return CharSlice99_new(out, n);
+}
+
+/**
+ * Writes @p x in decimal to @p out.
+ *
+ * The same as #CharSlice99_write_u64, except that a negative @p x is preceded by `-`.
+ *
+ * @param[out] out The buffer of at least #SLICE99_I64_STR_MAX characters.
+ * @param[in] x The integer to write.
+ *
+ * @pre `out != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT CharSlice99
+CharSlice99_write_i64(char out[restrict], int64_t x) {
+    SLICE99_ASSERT(out);
+
+    if (x >= 0) {
+        return CharSlice99_write_u64(out, (uint64_t)x);
+    }
+
+    out[0] = '-';
+    const CharSlice99 digits = CharSlice99_write_u64(out + 1, (uint64_t)0 - (uint64_t)x);
+    return CharSlice99_new(out, digits.len + 1);
+}
+
+#if FLT_RADIX == 2 && DBL_MANT_DIG == 53 && DBL_MAX_EXP == 1024
+
+/**
+ * The maximum number of characters written by #CharSlice99_write_f64.
+ */
+#define SLICE99_F64_STR_MAX 24
+
+#ifndef DOXYGEN_IGNORE
+
+// Grisu2 by Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with
+// Integers" (2010), with the parameters alpha = -60 and gamma = -32.
+
+// The number `f * 2^e`.
+struct slice99_priv_diyfp {
+    uint64_t f;
+    int e;
+};
+
+inline static SLICE99_ALWAYS_INLINE struct slice99_priv_diyfp
+slice99_priv_diyfp_mul(struct slice99_priv_diyfp x, struct slice99_priv_diyfp y) {
+    uint64_t lo = x.f, hi = y.f;
+    slice99_priv_mum(&lo, &hi);
+
+    // The upper half of the product, rounded to nearest with ties up.
+    const struct slice99_priv_diyfp result = {hi + (lo >> 63), x.e + y.e + 64};
+    return result;
+}
+
+inline static SLICE99_ALWAYS_INLINE struct slice99_priv_diyfp
+slice99_priv_diyfp_normalize(struct slice99_priv_diyfp x) {
+    while ((x.f >> 63) == 0) {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+// Returns the normalised cached power of ten `c = f * 2^e ~= 10^k` such that the exponent of the
+// product of `c` and a normalised number with the exponent `e` lies in [alpha, gamma]. The powers
+// are 10^-300, 10^-292, ..., 10^324, so that `k` is written to `*k`.
+inline static struct slice99_priv_diyfp slice99_priv_cached_power(int e, int *k) {
+    static const struct {
+        uint64_t f;
+        int16_t e;
+    } powers[] = {
+        {UINT64_C(0xAB70FE17C79AC6CA), -1060}, {UINT64_C(0xFF77B1FCBEBCDC4F), -1034},
+        {UINT64_C(0xBE5691EF416BD60C), -1007}, {UINT64_C(0x8DD01FAD907FFC3C), -980},
+        {UINT64_C(0xD3515C2831559A83), -954}, {UINT64_C(0x9D71AC8FADA6C9B5), -927},
+        {UINT64_C(0xEA9C227723EE8BCB), -901}, {UINT64_C(0xAECC49914078536D), -874},
+        {UINT64_C(0x823C12795DB6CE57), -847}, {UINT64_C(0xC21094364DFB5637), -821},
+        {UINT64_C(0x9096EA6F3848984F), -794}, {UINT64_C(0xD77485CB25823AC7), -768},
+        {UINT64_C(0xA086CFCD97BF97F4), -741}, {UINT64_C(0xEF340A98172AACE5), -715},
+        {UINT64_C(0xB23867FB2A35B28E), -688}, {UINT64_C(0x84C8D4DFD2C63F3B), -661},
+        {UINT64_C(0xC5DD44271AD3CDBA), -635}, {UINT64_C(0x936B9FCEBB25C996), -608},
+        {UINT64_C(0xDBAC6C247D62A584), -582}, {UINT64_C(0xA3AB66580D5FDAF6), -555},
+        {UINT64_C(0xF3E2F893DEC3F126), -529}, {UINT64_C(0xB5B5ADA8AAFF80B8), -502},
+        {UINT64_C(0x87625F056C7C4A8B), -475}, {UINT64_C(0xC9BCFF6034C13053), -449},
+        {UINT64_C(0x964E858C91BA2655), -422}, {UINT64_C(0xDFF9772470297EBD), -396},
+        {UINT64_C(0xA6DFBD9FB8E5B88F), -369}, {UINT64_C(0xF8A95FCF88747D94), -343},
+        {UINT64_C(0xB94470938FA89BCF), -316}, {UINT64_C(0x8A08F0F8BF0F156B), -289},
+        {UINT64_C(0xCDB02555653131B6), -263}, {UINT64_C(0x993FE2C6D07B7FAC), -236},
+        {UINT64_C(0xE45C10C42A2B3B06), -210}, {UINT64_C(0xAA242499697392D3), -183},
+        {UINT64_C(0xFD87B5F28300CA0E), -157}, {UINT64_C(0xBCE5086492111AEB), -130},
+        {UINT64_C(0x8CBCCC096F5088CC), -103}, {UINT64_C(0xD1B71758E219652C), -77},
+        {UINT64_C(0x9C40000000000000), -50}, {UINT64_C(0xE8D4A51000000000), -24},
+        {UINT64_C(0xAD78EBC5AC620000), 3}, {UINT64_C(0x813F3978F8940984), 30},
+        {UINT64_C(0xC097CE7BC90715B3), 56}, {UINT64_C(0x8F7E32CE7BEA5C70), 83},
+        {UINT64_C(0xD5D238A4ABE98068), 109}, {UINT64_C(0x9F4F2726179A2245), 136},
+        {UINT64_C(0xED63A231D4C4FB27), 162}, {UINT64_C(0xB0DE65388CC8ADA8), 189},
+        {UINT64_C(0x83C7088E1AAB65DB), 216}, {UINT64_C(0xC45D1DF942711D9A), 242},
+        {UINT64_C(0x924D692CA61BE758), 269}, {UINT64_C(0xDA01EE641A708DEA), 295},
+        {UINT64_C(0xA26DA3999AEF774A), 322}, {UINT64_C(0xF209787BB47D6B85), 348},
+        {UINT64_C(0xB454E4A179DD1877), 375}, {UINT64_C(0x865B86925B9BC5C2), 402},
+        {UINT64_C(0xC83553C5C8965D3D), 428}, {UINT64_C(0x952AB45CFA97A0B3), 455},
+        {UINT64_C(0xDE469FBD99A05FE3), 481}, {UINT64_C(0xA59BC234DB398C25), 508},
+        {UINT64_C(0xF6C69A72A3989F5C), 534}, {UINT64_C(0xB7DCBF5354E9BECE), 561},
+        {UINT64_C(0x88FCF317F22241E2), 588}, {UINT64_C(0xCC20CE9BD35C78A5), 614},
+        {UINT64_C(0x98165AF37B2153DF), 641}, {UINT64_C(0xE2A0B5DC971F303A), 667},
+        {UINT64_C(0xA8D9D1535CE3B396), 694}, {UINT64_C(0xFB9B7CD9A4A7443C), 720},
+        {UINT64_C(0xBB764C4CA7A44410), 747}, {UINT64_C(0x8BAB8EEFB6409C1A), 774},
+        {UINT64_C(0xD01FEF10A657842C), 800}, {UINT64_C(0x9B10A4E5E9913129), 827},
+        {UINT64_C(0xE7109BFBA19C0C9D), 853}, {UINT64_C(0xAC2820D9623BF429), 880},
+        {UINT64_C(0x80444B5E7AA7CF85), 907}, {UINT64_C(0xBF21E44003ACDD2D), 933},
+        {UINT64_C(0x8E679C2F5E44FF8F), 960}, {UINT64_C(0xD433179D9C8CB841), 986},
+        {UINT64_C(0x9E19DB92B4E31BA9), 1013},
+    };
+
+    // ceil(log10(2^(alpha - e - 1))), computed exactly for the exponents of `double`.
+    const int f = -60 - e - 1;
+    const int min_k = f * 78913 / (1 << 18) + (f > 0);
+    const int i = (300 + min_k + 7) / 8;
+
+    SLICE99_ASSERT(i >= 0 && (size_t)i < SLICE99_ARRAY_LEN(powers));
+
+    *k = -300 + 8 * i;
+    const struct slice99_priv_diyfp result = {powers[i].f, powers[i].e};
+    return result;
+}
+
+// Removes the last digit while the result stays within (`M-`, `M+`) and gets closer to `w`.
+inline static void slice99_priv_grisu2_round(
+    char *buffer, size_t len, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t ten_k) {
+    while (rest < dist && delta - rest >= ten_k &&
+           (rest + ten_k < dist || dist - rest > rest + ten_k - dist)) {
+        buffer[len - 1]--;
+        rest += ten_k;
+    }
+}
+
+// Writes the digits `d` of a number within (`M-`, `M+`) close to `w`, such that the number equals
+// `d * 10^*exp10`, and returns their count.
+inline static size_t slice99_priv_grisu2_digits(
+    char *buffer, int *exp10, struct slice99_priv_diyfp m_minus, struct slice99_priv_diyfp w,
+    struct slice99_priv_diyfp m_plus) {
+    uint64_t delta = m_plus.f - m_minus.f, dist = m_plus.f - w.f;
+
+    const int shift = -m_plus.e;
+    const uint64_t one = UINT64_C(1) << shift;
+
+    // `M+` is split into the integral part `p1`, which fits into 32 bits since alpha >= -60, and
+    // the fractional part `p2`.
+    uint32_t p1 = (uint32_t)(m_plus.f >> shift);
+    uint64_t p2 = m_plus.f & (one - 1);
+
+    uint32_t pow10 = 1;
+    int n = 1;
+    while (n < 10 && p1 / pow10 >= 10) {
+        pow10 *= 10;
+        n++;
+    }
+
+    size_t len = 0;
+    while (n > 0) {
+        buffer[len++] = (char)('0' + p1 / pow10);
+        p1 %= pow10;
+        n--;
+
+        const uint64_t rest = ((uint64_t)p1 << shift) + p2;
+        if (rest <= delta) {
+            *exp10 += n;
+            slice99_priv_grisu2_round(buffer, len, dist, delta, rest, (uint64_t)pow10 << shift);
+            return len;
+        }
+
+        pow10 /= 10;
+    }
+
+    int m = 0;
+    for (;;) {
+        p2 *= 10;
+        buffer[len++] = (char)('0' + (p2 >> shift));
+        p2 &= one - 1;
+        m++;
+
+        delta *= 10;
+        dist *= 10;
+        if (p2 <= delta) {
+            break;
+        }
+    }
+
+    *exp10 -= m;
+    slice99_priv_grisu2_round(buffer, len, dist, delta, p2, one);
+    return len;
+}
+
+// Writes the shortest digits (in most cases) `d` of the finite positive `x`, such that
+// `d * 10^*exp10` converts back to `x`, and returns their count, which is at most 17.
+inline static size_t slice99_priv_grisu2(char *buffer, int *exp10, double x) {
+    uint64_t bits;
+    SLICE99_MEMCPY(&bits, &x, sizeof bits);
+
+    const uint64_t hidden_bit = UINT64_C(1) << 52;
+    const uint64_t biased_e = bits >> 52, fraction = bits & (hidden_bit - 1);
+
+    // `v` and the boundaries `m-` and `m+` halfway to the adjacent numbers.
+    struct slice99_priv_diyfp v = {fraction, 1 - 1075};
+    if (biased_e != 0) {
+        v.f += hidden_bit;
+        v.e = (int)biased_e - 1075;
+    }
+
+    const bool lower_is_closer = fraction == 0 && biased_e > 1;
+    const struct slice99_priv_diyfp m_plus =
+        slice99_priv_diyfp_normalize((struct slice99_priv_diyfp){2 * v.f + 1, v.e - 1});
+    struct slice99_priv_diyfp m_minus = {2 * v.f - 1, v.e - 1};
+    if (lower_is_closer) {
+        m_minus.f = 4 * v.f - 1;
+        m_minus.e = v.e - 2;
+    }
+    m_minus.f <<= m_minus.e - m_plus.e;
+    m_minus.e = m_plus.e;
+
+    int k;
+    const struct slice99_priv_diyfp c = slice99_priv_cached_power(m_plus.e, &k);
+    const struct slice99_priv_diyfp w =
+        slice99_priv_diyfp_mul(slice99_priv_diyfp_normalize(v), c);
+    struct slice99_priv_diyfp w_minus = slice99_priv_diyfp_mul(m_minus, c),
+                              w_plus = slice99_priv_diyfp_mul(m_plus, c);
+
+    // Shrink the interval by one unit in the last place to account for the errors of the products.
+    w_minus.f++;
+    w_plus.f--;
+
+    *exp10 = -k;
+    return slice99_priv_grisu2_digits(buffer, exp10, w_minus, w, w_plus);
+}
+
+inline static SLICE99_WARN_UNUSED_RESULT bool
+slice99_priv_ascii_ieq(const char *p, const char *lowercase, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if ((p[i] | 0x20) != lowercase[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Writes @p x in decimal to @p out.
+ *
+ * The digits are generated by Grisu2, which always produces digits that convert back to @p x
+ * and, in the vast majority of cases, the shortest ones. Numbers with a decimal exponent in
+ * [-4, 15) are written in the fixed notation (`0.001`, `123.45`, `1000`) and the others in the
+ * exponential one (`1e-7`, `1.5e300`). Infinities and NaNs are written as `inf`, `-inf`, and `nan`.
+ * No null character is written. The output does not depend on the locale and is accepted by
+ * #CharSlice99_parse_f64.
+ *
+ * Defined only if `double` is the IEEE 754 binary64 format.
+ *
+ * @param[out] out The buffer of at least #SLICE99_F64_STR_MAX characters.
+ * @param[in] x The number to write.
+ *
+ * @return The slice of the characters written to @p out.
+ *
+ * @pre `out != NULL`
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     char buffer[SLICE99_F64_STR_MAX];
+ *
+ *     assert(CharSlice99_primitive_eq(
+ *         CharSlice99_write_f64(buffer, 0.1), CharSlice99_from_str("0.1")));
+ *     assert(CharSlice99_primitive_eq(
+ *         CharSlice99_write_f64(buffer, -1e100), CharSlice99_from_str("-1e100")));
+ * }
+ * @endcode
+ */
+inline static SLICE99_WARN_UNUSED_RESULT CharSlice99
+CharSlice99_write_f64(char out[restrict], double x) {
+    SLICE99_ASSERT(out);
+
+    uint64_t bits;
+    SLICE99_MEMCPY(&bits, &x, sizeof bits);
+
+    const uint64_t exp_mask = UINT64_C(0x7FF0000000000000),
+                   fraction_mask = (UINT64_C(1) << 52) - 1;
+    char *p = out;
+
+    if ((bits & exp_mask) == exp_mask && (bits & fraction_mask) != 0) {
+        SLICE99_MEMCPY(p, "nan", 3);
+        return CharSlice99_new(out, 3);
+    }
+
+    if (bits >> 63) {
+        *p++ = '-';
+        bits &= ~(UINT64_C(1) << 63);
+        SLICE99_MEMCPY(&x, &bits, sizeof x);
+    }
+
+    if (bits == exp_mask) {
+        SLICE99_MEMCPY(p, "inf", 3);
+        return CharSlice99_new(out, (size_t)(p - out) + 3);
+    }
+
+    if (bits == 0) {
+        *p++ = '0';
+        return CharSlice99_new(out, (size_t)(p - out));
+    }
+
+    // The digits are generated right after the room for the leading "0.00" of the fixed notation.
+    char *digits = p + 4;
+    int exp10;
+    const size_t len = slice99_priv_grisu2(digits, &exp10, x);
+
+    // The value is 0.d * 10^point.
+    const int point = (int)len + exp10;
+
+    if (point > 0 && point <= 15) {
+        SLICE99_MEMMOVE(p, digits, len);
+        if ((size_t)point >= len) {
+            SLICE99_MEMSET(p + len, '0', (size_t)point - len);
+            p += point;
+        } else {
+            SLICE99_MEMMOVE(p + point + 1, p + point, len - (size_t)point);
+            p[point] = '.';
+            p += len + 1;
+        }
+    } else if (point > -4 && point <= 0) {
+        // The digits are moved first, since the zeros may overwrite them.
+        SLICE99_MEMMOVE(p + 2 - point, digits, len);
+        p[0] = '0';
+        p[1] = '.';
+        SLICE99_MEMSET(p + 2, '0', (size_t)-point);
+        p += 2 - point + (int)len;
+    } else {
+        p[0] = digits[0];
+        p++;
+        if (len > 1) {
+            SLICE99_MEMMOVE(p + 1, digits + 1, len - 1);
+            p[0] = '.';
+            p += len;
+        }
+
+        *p++ = 'e';
+        int e = point - 1;
+        if (e < 0) {
+            *p++ = '-';
+            e = -e;
+        }
+        p += slice99_priv_num_digits((uint64_t)e);
+        slice99_priv_write_digits(p, (uint64_t)e);
+    }
+
+    return CharSlice99_new(out, (size_t)(p - out));
+}
+
+#ifndef SLICE99_DISABLE_STDLIB
+
+#ifndef DOXYGEN_IGNORE
+
+// Clinger's fast path: if both the mantissa and the power of ten are exact doubles, so is the
+// correctly rounded result of an IEEE 754 multiplication or division. Requires `double` operations
+// to be evaluated in `double` precision, as opposed to the x87 extended precision.
+inline static SLICE99_WARN_UNUSED_RESULT bool slice99_priv_parse_f64_fast(
+    CharSlice99 int_digits, CharSlice99 frac_digits, size_t significant, int64_t exp10,
+    double *out) {
+#if FLT_EVAL_METHOD == 0
+    static const double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                   1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                   1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    static const uint64_t pow10_u64[] = {
+        UINT64_C(1),
+        UINT64_C(10),
+        UINT64_C(100),
+        UINT64_C(1000),
+        UINT64_C(10000),
+        UINT64_C(100000),
+        UINT64_C(1000000),
+        UINT64_C(10000000),
+        UINT64_C(100000000),
+        UINT64_C(1000000000),
+        UINT64_C(10000000000),
+        UINT64_C(100000000000),
+        UINT64_C(1000000000000),
+        UINT64_C(10000000000000),
+        UINT64_C(100000000000000),
+        UINT64_C(1000000000000000),
+        UINT64_C(10000000000000000),
+        UINT64_C(100000000000000000),
+        UINT64_C(1000000000000000000),
+    };
+    const uint64_t max_exact = UINT64_C(1) << 53;
+
+    if (significant > 19) {
+        return false;
+    }
+
+    // If the integral part is not zero, all the fractional digits are significant.
+    const uint64_t int_value = slice99_priv_parse_digits(int_digits.ptr, int_digits.len),
+                   frac_value = slice99_priv_parse_digits(frac_digits.ptr, frac_digits.len);
+    const uint64_t mantissa =
+        int_value == 0 ? frac_value : int_value * pow10_u64[frac_digits.len] + frac_value;
+
+    if (mantissa <= max_exact && exp10 >= -22 && exp10 <= 22) {
+        *out = exp10 < 0 ? (double)mantissa / pow10[-exp10] : (double)mantissa * pow10[exp10];
+        return true;
+    }
+
+    // Extra powers of ten can be moved to the mantissa if it stays exact.
+    if (exp10 > 22 && exp10 <= 22 + 18 && mantissa <= max_exact / pow10_u64[exp10 - 22]) {
+        *out = (double)(mantissa * pow10_u64[exp10 - 22]) * 1e22;
+        return true;
+    }
+
+    return false;
+#else
+    (void)int_digits;
+    (void)frac_digits;
+    (void)significant;
+    (void)exp10;
+    (void)out;
+    return false;
+#endif
+}
+
+// Converts the decimal digits scaled by 10^`exp10` with `SLICE99_STRTOD`. The decimal point is
+// omitted, so the result does not depend on the locale.
+inline static SLICE99_WARN_UNUSED_RESULT bool slice99_priv_parse_f64_slow(
+    CharSlice99 int_digits, CharSlice99 frac_digits, int64_t exp10, double *out) {
+    char stack_buffer[128];
+    const size_t size = int_digits.len + frac_digits.len + 1 + SLICE99_I64_STR_MAX + 1;
+
+    char *buffer = stack_buffer;
+    if (size > sizeof stack_buffer) {
+        buffer = (char *)SLICE99_REALLOC(NULL, size);
+        if (buffer == NULL) {
+            return false;
+        }
+    }
+
+    char *p = buffer;
+    SLICE99_MEMCPY(p, int_digits.ptr, int_digits.len);
+    p += int_digits.len;
+    SLICE99_MEMCPY(p, frac_digits.ptr, frac_digits.len);
+    p += frac_digits.len;
+    *p++ = 'e';
+    p += CharSlice99_write_i64(p, exp10).len;
+    *p = '\0';
+
+    *out = SLICE99_STRTOD(buffer, NULL);
+
+    if (buffer != stack_buffer) {
+        SLICE99_FREE(buffer);
+    }
+    return true;
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Parses a decimal floating-point number at the start of @p self.
+ *
+ * The number is an optional sign followed by digits with an optional decimal point (at least one
+ * digit is required), optionally followed by `e` or `E`, an optional sign, and digits. `inf`,
+ * `infinity`, and `nan` are accepted in any case. Hexadecimal numbers are not supported. Unlike
+ * `strtod`, this function does not require a null-terminated string and always uses `.` as the
+ * decimal point, regardless of the locale.
+ *
+ * The result is correctly rounded. When the significant digits fit into 53 bits and the decimal
+ * exponent is small, which is the case for most numbers in practice, the result is computed with
+ * a single floating-point multiplication or division; otherwise, the digits are converted by
+ * #SLICE99_STRTOD.
+ *
+ * Defined only if `double` is the IEEE 754 binary64 format and `SLICE99_DISABLE_STDLIB` is
+ * **not** defined.
+ *
+ * @param[in] self The characters to parse.
+ * @param[out] out The location to which the number will be written. Numbers too big to be
+ * represented become infinities.
+ * @param[out] rest The location to which the characters following the number will be written. If
+ * `NULL`, @p self must consist of the number only.
+ *
+ * @return `true` on success, `false` if there is no number, if the allocation for a very long
+ * number has failed, or if @p rest is `NULL` and the number is followed by other characters. In
+ * the latter case, @p out and @p rest are left unchanged.
+ *
+ * @pre `out != NULL`
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     CharSlice99 rest;
+ *     double x;
+ *
+ *     assert(CharSlice99_parse_f64(CharSlice99_from_str("-1.5e3 ms"), &x, &rest));
+ *     assert(x == -1500.0);
+ *     assert(CharSlice99_primitive_eq(rest, CharSlice99_from_str(" ms")));
+ * }
+ * @endcode
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+CharSlice99_parse_f64(CharSlice99 self, double *restrict out, CharSlice99 *restrict rest) {
+    SLICE99_ASSERT(out);
+
+    char *p = self.ptr, *end = self.ptr + self.len;
+
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    double x;
+
+    if ((size_t)(end - p) >= 3 && slice99_priv_ascii_ieq(p, "inf", 3)) {
+        p += 3;
+        if ((size_t)(end - p) >= 5 && slice99_priv_ascii_ieq(p, "inity", 5)) {
+            p += 5;
+        }
+        const uint64_t bits = UINT64_C(0x7FF0000000000000);
+        SLICE99_MEMCPY(&x, &bits, sizeof x);
+    } else if ((size_t)(end - p) >= 3 && slice99_priv_ascii_ieq(p, "nan", 3)) {
+        p += 3;
+        const uint64_t bits = UINT64_C(0x7FF8000000000000);
+        SLICE99_MEMCPY(&x, &bits, sizeof x);
+    } else {
+        const CharSlice99 int_digits =
+            CharSlice99_new(p, slice99_priv_count_digits(p, (size_t)(end - p)));
+        p += int_digits.len;
+
+        CharSlice99 frac_digits = CharSlice99_new(p, 0);
+        if (p != end && *p == '.') {
+            p++;
+            frac_digits = CharSlice99_new(p, slice99_priv_count_digits(p, (size_t)(end - p)));
+            p += frac_digits.len;
+        }
+
+        if (int_digits.len == 0 && frac_digits.len == 0) {
+            return false;
+        }
+
+        // Once the exponent exceeds the number of the digits by more than the range of `double`
+        // (from 10^-343 to 10^309), the result overflows or underflows whatever the digits are, so
+        // the exponent saturates there without affecting the result.
+        const size_t digits = int_digits.len + frac_digits.len;
+        const int64_t max_exp10 =
+            (uint64_t)digits < INT64_MAX / 16 ? (int64_t)digits + 400 : INT64_MAX / 16;
+        int64_t exp10 = 0;
+        if (p != end && (*p == 'e' || *p == 'E')) {
+            char *q = p + 1;
+            bool exp_negative = false;
+            if (q != end && (*q == '-' || *q == '+')) {
+                exp_negative = *q == '-';
+                q++;
+            }
+
+            // Without digits, `e` does not belong to the number.
+            const size_t n = slice99_priv_count_digits(q, (size_t)(end - q));
+            if (n > 0) {
+                for (size_t i = 0; i < n && exp10 <= max_exp10; i++) {
+                    exp10 = exp10 * 10 + (q[i] - '0');
+                }
+                exp10 = exp_negative ? -exp10 : exp10;
+                p = q + n;
+            }
+        }
+
+        // The significant digits, without the leading zeros.
+        size_t zeros = 0;
+        while (zeros < int_digits.len && int_digits.ptr[zeros] == '0') {
+            zeros++;
+        }
+        if (zeros == int_digits.len) {
+            while (zeros - int_digits.len < frac_digits.len &&
+                   frac_digits.ptr[zeros - int_digits.len] == '0') {
+                zeros++;
+            }
+        }
+        const size_t significant = int_digits.len + frac_digits.len - zeros;
+
+        const int64_t scale = exp10 - (int64_t)frac_digits.len;
+
+        if (significant == 0) {
+            x = 0.0;
+        } else if (
+            !slice99_priv_parse_f64_fast(int_digits, frac_digits, significant, scale, &x) &&
+            !slice99_priv_parse_f64_slow(int_digits, frac_digits, scale, &x)) {
+            return false;
+        }
+    }
+
+    if (!slice99_priv_parse_finish(self, (size_t)(p - self.ptr), rest)) {
+        return false;
+    }
+
+    *out = negative ? -x : x;
+    return true;
+}
+
+#endif // SLICE99_DISABLE_STDLIB
+
+#endif // FLT_RADIX == 2 && DBL_MANT_DIG == 53 && DBL_MAX_EXP == 1024
+
+#if defined(UINT8_MAX) && defined(UINT16_MAX) && defined(UINT32_MAX) && defined(UINT64_MAX)
+
+/**
+ * The replacement character U+FFFD, yielded by #U8Slice99_utf8_next for invalid sequences.
+ */
+#define SLICE99_UTF8_REPLACEMENT 0xFFFD
+
+#ifndef DOXYGEN_IGNORE
+
+// Decodes the character at the start of the non-empty `p[0..len)` and returns its size. If the
+// character is invalid, returns the size of its longest valid prefix, which is at least 1, and
+// writes the replacement character, so that invalid sequences are replaced as recommended by the
+// Unicode Standard (Section 3.9, "U+FFFD Substitution of Maximal Subparts").
+inline static size_t
+slice99_priv_utf8_decode(const unsigned char *p, size_t len, uint32_t *codepoint, bool *valid) {
+    const unsigned char lead = p[0];
+
+    if (lead < 0x80) {
+        *codepoint = lead;
+        *valid = true;
+        return 1;
+    }
+
+    size_t size;
+    uint32_t cp;
+    unsigned char min = 0x80, max = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        size = 2;
+        cp = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        size = 3;
+        cp = lead & 0x0F;
+        // Overlong encodings and surrogates.
+        min = lead == 0xE0 ? 0xA0 : 0x80;
+        max = lead == 0xED ? 0x9F : 0xBF;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        size = 4;
+        cp = lead & 0x07;
+        // Overlong encodings and codepoints beyond U+10FFFF.
+        min = lead == 0xF0 ? 0x90 : 0x80;
+        max = lead == 0xF4 ? 0x8F : 0xBF;
+    } else {
+        *codepoint = SLICE99_UTF8_REPLACEMENT;
+        *valid = false;
+        return 1;
+    }
+
+    for (size_t i = 1; i < size; i++) {
+        if (i == len || p[i] < min || p[i] > max) {
+            *codepoint = SLICE99_UTF8_REPLACEMENT;
+            *valid = false;
+            return i;
+        }
+
+        cp = cp << 6 | (p[i] & 0x3F);
+        min = 0x80;
+        max = 0xBF;
+    }
+
+    *codepoint = cp;
+    *valid = true;
+    return size;
+}
+
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE bool
+slice99_priv_utf8_validate_scalar(const unsigned char *p, size_t len) {
+    size_t i = 0;
+    while (i < len) {
+        // Skip ASCII 8 bytes at a time.
+        for (; i + 8 <= len; i += 8) {
+            uint64_t word;
+            SLICE99_MEMCPY(&word, p + i, 8);
+            if ((word & UINT64_C(0x8080808080808080)) != 0) {
+                break;
+            }
+        }
+        if (i == len) {
+            break;
+        }
+
+        uint32_t codepoint;
+        bool valid;
+        i += slice99_priv_utf8_decode(p + i, len - i, &codepoint, &valid);
+        if (!valid) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#ifdef SLICE99_PRIV_SSSE3
+
+// The lookup algorithm by John Keiser and Daniel Lemire, "Validating UTF-8 In Less Than One
+// Instruction Per Byte" (2021). Every byte is classified together with the preceding one by three
+// table lookups on their nibbles, whose AND is non-zero exactly for the invalid pairs. Then, the
+// continuation bytes required by three- and four-byte sequences are checked.
+//
+// Returns `true` if the 16-byte blocks of `p[0..len)` are valid. The characters that cross the
+// end of the last block must be checked separately.
+inline static SLICE99_WARN_UNUSED_RESULT bool
+slice99_priv_utf8_validate_ssse3(const unsigned char *p, size_t len) {
+    enum {
+        TOO_SHORT = 1 << 0,      // 11______ 0_______, 11______ 11______
+        TOO_LONG = 1 << 1,       // 0_______ 10______
+        OVERLONG_3 = 1 << 2,     // 11100000 100_____
+        TOO_LARGE = 1 << 3,      // 11110100 1001____, 11110100 101_____, 11110101+ 1001____, ...
+        SURROGATE = 1 << 4,      // 11101101 101_____
+        OVERLONG_2 = 1 << 5,     // 1100000_ 10______
+        TOO_LARGE_1000 = 1 << 6, // 11110101+ 1000____
+        OVERLONG_4 = 1 << 6,     // 11110000 1000____
+        TWO_CONTS = 1 << 7,      // 10______ 10______
+        CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS,
+    };
+
+    const __m128i byte_1_high_table = _mm_setr_epi8(
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+        (char)TWO_CONTS, (char)TWO_CONTS, (char)TWO_CONTS, (char)TWO_CONTS,
+        TOO_SHORT | OVERLONG_2, TOO_SHORT, TOO_SHORT | OVERLONG_3 | SURROGATE,
+        TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+    const __m128i byte_1_low_table = _mm_setr_epi8(
+        (char)(CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4), (char)(CARRY | OVERLONG_2),
+        (char)CARRY, (char)CARRY, (char)(CARRY | TOO_LARGE),
+        (char)(CARRY | TOO_LARGE | TOO_LARGE_1000), (char)(CARRY | TOO_LARGE | TOO_LARGE_1000),
+        (char)(CARRY | TOO_LARGE | TOO_LARGE_1000), (char)(CARRY | TOO_LARGE | TOO_LARGE_1000),
+        (char)(CARRY | TOO_LARGE | TOO_LARGE_1000), (char)(CARRY | TOO_LARGE | TOO_LARGE_1000),
+        (char)(CARRY | TOO_LARGE | TOO_LARGE_1000), (char)(CARRY | TOO_LARGE | TOO_LARGE_1000),
+        (char)(CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE),
+        (char)(CARRY | TOO_LARGE | TOO_LARGE_1000), (char)(CARRY | TOO_LARGE | TOO_LARGE_1000));
+    const __m128i byte_2_high_table = _mm_setr_epi8(
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+        (char)(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4),
+        (char)(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE),
+        (char)(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+        (char)(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE), TOO_SHORT, TOO_SHORT,
+        TOO_SHORT, TOO_SHORT);
+
+    const __m128i low_nibble = _mm_set1_epi8(0x0F);
+    __m128i prev = _mm_setzero_si128(), error = _mm_setzero_si128();
+
+    for (size_t i = 0; len - i >= 16; i += 16) {
+        const __m128i input = _mm_loadu_si128((const __m128i *)(const void *)(p + i));
+
+        // An ASCII block is valid if the previous one does not end with an incomplete character,
+        // which the next non-ASCII block or the final check will catch.
+        if (_mm_movemask_epi8(input) == 0) {
+            error = _mm_or_si128(
+                error,
+                _mm_subs_epu8(
+                    prev, _mm_setr_epi8(
+                              -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                              (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1))));
+            prev = input;
+            continue;
+        }
+
+        const __m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+        const __m128i byte_1_high = _mm_shuffle_epi8(
+            byte_1_high_table, _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble));
+        const __m128i byte_1_low =
+            _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, low_nibble));
+        const __m128i byte_2_high = _mm_shuffle_epi8(
+            byte_2_high_table, _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble));
+        const __m128i special =
+            _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+        // Only 111_____ and 1111____ remain at least 0x80 after these subtractions.
+        const __m128i prev2 = _mm_alignr_epi8(input, prev, 14),
+                      prev3 = _mm_alignr_epi8(input, prev, 13);
+        const __m128i must_be_continuation = _mm_and_si128(
+            _mm_or_si128(
+                _mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 0x80))),
+                _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 0x80)))),
+            _mm_set1_epi8((char)0x80));
+
+        error = _mm_or_si128(error, _mm_xor_si128(must_be_continuation, special));
+        prev = input;
+    }
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+}
+
+#endif // SLICE99_PRIV_SSSE3
+
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE bool
+slice99_priv_utf8_validate(const unsigned char *p, size_t len) {
+    size_t start = 0;
+
+#ifdef SLICE99_PRIV_SSSE3
+    const size_t blocks_len = len & ~(size_t)15;
+    if (!slice99_priv_utf8_validate_ssse3(p, blocks_len)) {
+        return false;
+    }
+
+    // Recheck the last character starting in the blocks, which may be incomplete.
+    start = blocks_len;
+    for (size_t i = 1; i <= 3 && i <= blocks_len; i++) {
+        if (p[blocks_len - i] >= 0xC0) {
+            start = blocks_len - i;
+            break;
+        }
+    }
+#endif
+
+    return slice99_priv_utf8_validate_scalar(p + start, len - start);
+}
+
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE size_t
+slice99_priv_utf8_len(const unsigned char *p, size_t len) {
+    size_t i = 0, continuations = 0;
+
+    for (; len - i >= 8; i += 8) {
+        // Continuation bytes are 10______.
+        const uint64_t x = slice99_priv_hash_read8(p + i);
+        const uint64_t mask = x & ~(x << 1) & UINT64_C(0x8080808080808080);
+        continuations += (size_t)(((mask >> 7) * UINT64_C(0x0101010101010101)) >> 56);
+    }
+    for (; i < len; i++) {
+        continuations += (p[i] & 0xC0) == 0x80;
+    }
+
+    return len - continuations;
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Checks that the bytes of @p self are valid UTF-8.
+ *
+ * Valid UTF-8 consists of the shortest encodings of the codepoints up to U+10FFFF, except
+ * surrogates (U+D800 to U+DFFF). ASCII is skipped 8 bytes at a time. If SSSE3 is enabled by the
+ * compiler flags, 16 bytes at a time are validated with the algorithm of simdutf.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[in] self The bytes to check.
+ *
+ * @return `true` if @p self is valid UTF-8, `false` otherwise.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE bool U8Slice99_utf8_validate(U8Slice99 self) {
+    return slice99_priv_utf8_validate(self.ptr, self.len);
+}
+
+/**
+ * Decodes the first character of @p self and advances @p self past it.
+ *
+ * An invalid sequence is decoded as #SLICE99_UTF8_REPLACEMENT, and @p self is advanced past its
+ * longest prefix that could start a valid character, or past one byte if there is no such prefix.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[in,out] self The bytes to decode.
+ * @param[out] codepoint The location to which the decoded codepoint will be written.
+ *
+ * @return `true` if a character has been decoded, `false` if @p self is empty.
+ *
+ * @pre `self != NULL`
+ * @pre `codepoint != NULL`
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     CharSlice99 str = CharSlice99_from_str("a\xC3\xA9\xE2\x82\xAC!");
+ *     uint32_t codepoints[4], codepoint;
+ *     size_t i = 0;
+ *
+ *     assert(CharSlice99_utf8_validate(str));
+ *     assert(CharSlice99_utf8_len(str) == 4);
+ *
+ *     while (CharSlice99_utf8_next(&str, &codepoint)) {
+ *         codepoints[i++] = codepoint;
+ *     }
+ *
+ *     assert(codepoints[0] == 'a' && codepoints[1] == 0xE9 && codepoints[2] == 0x20AC);
+ *     assert(codepoints[3] == '!');
+ * }
+ * @endcode
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+U8Slice99_utf8_next(U8Slice99 *restrict self, uint32_t *restrict codepoint) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(codepoint);
+
+    if (self->len == 0) {
+        return false;
+    }
+
+    bool valid;
+    const size_t size = slice99_priv_utf8_decode(self->ptr, self->len, codepoint, &valid);
+    self->ptr += size;
+    self->len -= size;
+    return true;
+}
+
+/**
+ * Counts the characters of the valid UTF-8 @p self.
+ *
+ * The characters are counted as the bytes that are not continuation bytes, 8 bytes at a time. If
+ * @p self is not valid UTF-8, the result is still the number of such bytes.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[in] self The bytes to count the characters of.
+ *
+ * @return The number of the characters.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE size_t U8Slice99_utf8_len(U8Slice99 self) {
+    return slice99_priv_utf8_len(self.ptr, self.len);
+}
+
+/**
+ * The #U8Slice99_utf8_validate twin for character slices.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE bool
+CharSlice99_utf8_validate(CharSlice99 self) {
+    return slice99_priv_utf8_validate((const unsigned char *)self.ptr, self.len);
+}
+
+/**
+ * The #U8Slice99_utf8_next twin for character slices.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @pre `self != NULL`
+ * @pre `codepoint != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT bool
+CharSlice99_utf8_next(CharSlice99 *restrict self, uint32_t *restrict codepoint) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(codepoint);
+
+    if (self->len == 0) {
+        return false;
+    }
+
+    bool valid;
+    const size_t size = slice99_priv_utf8_decode(
+        (const unsigned char *)self->ptr, self->len, codepoint, &valid);
+    self->ptr += size;
+    self->len -= size;
+    return true;
+}
+
+/**
+ * The #U8Slice99_utf8_len twin for character slices.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE size_t
+CharSlice99_utf8_len(CharSlice99 self) {
+    return slice99_priv_utf8_len((const unsigned char *)self.ptr, self.len);
+}
+
+#ifndef DOXYGEN_IGNORE
+
+// Sets the most significant bit of every byte of `word` in `[lo, lo + count)` and clears the other
+// bits. No sum below carries into the next byte, so the bytes are classified independently.
+//
+// Requires `lo > 0` and `lo + count <= 0x80`.
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST uint64_t
+slice99_priv_ascii_range(uint64_t word, unsigned char lo, unsigned char count) {
+    const uint64_t ones = UINT64_C(0x0101010101010101), highs = UINT64_C(0x8080808080808080);
+    const uint64_t heptets = word & ~highs;
+    const uint64_t ge_lo = heptets + ones * (uint64_t)(0x80 - lo),
+                   ge_hi = heptets + ones * (uint64_t)(0x80 - lo - count);
+    return ~word & (ge_lo ^ ge_hi) & highs;
+}
+
+// Flips the case of the letters in `[lo, lo + 26)`: lowercases for `lo == 'A'`, uppercases for
+// `lo == 'a'`.
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST uint64_t
+slice99_priv_ascii_flip_word(uint64_t word, unsigned char lo) {
+    return word ^ (slice99_priv_ascii_range(word, lo, 26) >> 2);
+}
+
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST unsigned char
+slice99_priv_ascii_flip_byte(unsigned char c, unsigned char lo) {
+    return (unsigned char)(c - lo) < 26 ? (unsigned char)(c ^ 0x20) : c;
+}
+
+// The C-locale whitespace: the space, `\t`, `\n`, `\v`, `\f`, and `\r`.
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST bool
+slice99_priv_ascii_is_space(unsigned char c) {
+    return c == ' ' || (unsigned char)(c - '\t') < 5;
+}
+
+inline static SLICE99_ALWAYS_INLINE SLICE99_CONST uint64_t
+slice99_priv_ascii_space_word(uint64_t word) {
+    return slice99_priv_ascii_range(word, '\t', 5) | slice99_priv_ascii_range(word, ' ', 1);
+}
+
+#ifdef SLICE99_PRIV_SSE2
+
+// The signed comparisons reject the bytes above 0x7F, just as `slice99_priv_ascii_range` does.
+inline static SLICE99_ALWAYS_INLINE __m128i
+slice99_priv_ascii_range_sse2(__m128i block, char lo, char count) {
+    return _mm_and_si128(
+        _mm_cmpgt_epi8(block, _mm_set1_epi8((char)(lo - 1))),
+        _mm_cmplt_epi8(block, _mm_set1_epi8((char)(lo + count))));
+}
+
+inline static SLICE99_ALWAYS_INLINE __m128i slice99_priv_ascii_flip_sse2(__m128i block, char lo) {
+    const __m128i letters = slice99_priv_ascii_range_sse2(block, lo, 26);
+    return _mm_xor_si128(block, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+}
+
+// A bit mask of the bytes of `p[0..16)` that are not whitespace.
+inline static SLICE99_ALWAYS_INLINE unsigned slice99_priv_ascii_non_space_sse2(const void *p) {
+    const __m128i block = _mm_loadu_si128((const __m128i *)p);
+    const __m128i space = _mm_or_si128(
+        _mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), slice99_priv_ascii_range_sse2(block, '\t', 5));
+    return ~(unsigned)_mm_movemask_epi8(space) & 0xFFFF;
+}
+
+#endif // SLICE99_PRIV_SSE2
+
+// Flips the case of the letters in `[lo, lo + 26)` of `p[0..n)` in place, 16 bytes at a time with
+// SSE2 and 8 bytes at a time otherwise.
+inline static void slice99_priv_ascii_flip_case(unsigned char *p, size_t n, unsigned char lo) {
+    size_t i = 0;
+
+#ifdef SLICE99_PRIV_SSE2
+    for (; n - i >= 16; i += 16) {
+        const __m128i block = _mm_loadu_si128((const __m128i *)(void *)(p + i));
+        _mm_storeu_si128((__m128i *)(void *)(p + i), slice99_priv_ascii_flip_sse2(block, (char)lo));
+    }
+#endif
+
+    for (; n - i >= 8; i += 8) {
+        uint64_t word;
+        SLICE99_MEMCPY(&word, p + i, 8);
+        word = slice99_priv_ascii_flip_word(word, lo);
+        SLICE99_MEMCPY(p + i, &word, 8);
+    }
+
+    for (; i < n; i++) {
+        p[i] = slice99_priv_ascii_flip_byte(p[i], lo);
+    }
+}
+
+// Compares `lhs[0..n)` and `rhs[0..n)` with both lowercased on the fly.
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE bool slice99_priv_ascii_eq_ignore_case(
+    const unsigned char *lhs, const unsigned char *rhs, size_t n) {
+    size_t i = 0;
+
+#ifdef SLICE99_PRIV_SSE2
+    for (; n - i >= 16; i += 16) {
+        const __m128i l = _mm_loadu_si128((const __m128i *)(const void *)(lhs + i)),
+                      r = _mm_loadu_si128((const __m128i *)(const void *)(rhs + i));
+        const __m128i eq = _mm_cmpeq_epi8(
+            slice99_priv_ascii_flip_sse2(l, 'A'), slice99_priv_ascii_flip_sse2(r, 'A'));
+        if (_mm_movemask_epi8(eq) != 0xFFFF) {
+            return false;
+        }
+    }
+#endif
+
+    for (; n - i >= 8; i += 8) {
+        uint64_t l, r;
+        SLICE99_MEMCPY(&l, lhs + i, 8);
+        SLICE99_MEMCPY(&r, rhs + i, 8);
+        if (slice99_priv_ascii_flip_word(l, 'A') != slice99_priv_ascii_flip_word(r, 'A')) {
+            return false;
+        }
+    }
+
+    // Compare the rest as the last 8 bytes, which overlap the bytes already compared.
+    if (i < n && n >= 8) {
+        uint64_t l, r;
+        SLICE99_MEMCPY(&l, lhs + (n - 8), 8);
+        SLICE99_MEMCPY(&r, rhs + (n - 8), 8);
+        return slice99_priv_ascii_flip_word(l, 'A') == slice99_priv_ascii_flip_word(r, 'A');
+    }
+
+    for (; i < n; i++) {
+        const unsigned char l = lhs[i], r = rhs[i];
+        if (slice99_priv_ascii_flip_byte(l, 'A') != slice99_priv_ascii_flip_byte(r, 'A')) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// The number of the leading whitespace bytes of `p[0..n)`.
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE size_t
+slice99_priv_ascii_space_prefix(const unsigned char *p, size_t n) {
+    size_t i = 0;
+
+#ifdef SLICE99_PRIV_SSE2
+    for (; n - i >= 16; i += 16) {
+        const unsigned mask = slice99_priv_ascii_non_space_sse2(p + i);
+        if (mask != 0) {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+#else
+    // Skip 8-byte words of whitespace.
+    for (; n - i >= 8; i += 8) {
+        uint64_t word;
+        SLICE99_MEMCPY(&word, p + i, 8);
+        if (slice99_priv_ascii_space_word(word) != UINT64_C(0x8080808080808080)) {
+            break;
+        }
+    }
+#endif
+
+    while (i < n && slice99_priv_ascii_is_space(p[i])) {
+        i++;
+    }
+
+    return i;
+}
+
+// The number of the trailing whitespace bytes of `p[0..n)`.
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE size_t
+slice99_priv_ascii_space_suffix(const unsigned char *p, size_t n) {
+    // `p[i..n)` is whitespace.
+    size_t i = n;
+
+#ifdef SLICE99_PRIV_SSE2
+    for (; i >= 16; i -= 16) {
+        const unsigned mask = slice99_priv_ascii_non_space_sse2(p + i - 16);
+        if (mask != 0) {
+            return n - (i - 16 + (size_t)(32 - __builtin_clz(mask)));
+        }
+    }
+#else
+    // Skip 8-byte words of whitespace.
+    for (; i >= 8; i -= 8) {
+        uint64_t word;
+        SLICE99_MEMCPY(&word, p + i - 8, 8);
+        if (slice99_priv_ascii_space_word(word) != UINT64_C(0x8080808080808080)) {
+            break;
+        }
+    }
+#endif
+
+    while (i > 0 && slice99_priv_ascii_is_space(p[i - 1])) {
+        i--;
+    }
+
+    return n - i;
+}
+
+#endif // DOXYGEN_IGNORE
+
+/**
+ * Checks whether @p lhs and @p rhs are equal, ignoring the case of the ASCII letters.
  *
- * It is equivalent to #Slice99_new but it automatically computes an item size as `sizeof(*ptr)`.
+ * The bytes are lowercased on the fly and compared 16 bytes at a time with SSE2, and 8 bytes at a
+ * time otherwise. The bytes outside of ASCII are compared exactly.
  *
- * @param[in] ptr The pointer of the resulting slice. Must not point to `void`.
- * @param[in] len The length of the resulting slice.
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[in] lhs The first slice to be compared.
+ * @param[in] rhs The second slice to be compared.
+ *
+ * @return `true` if @p lhs and @p rhs are equal when lowercased, otherwise `false`.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     CharSlice99 header = CharSlice99_from_str("Content-Length");
+ *     assert(CharSlice99_eq_ignore_ascii_case(header, CharSlice99_from_str("content-length")));
+ *     assert(!CharSlice99_eq_ignore_ascii_case(header, CharSlice99_from_str("content-type")));
+ * }
+ * @endcode
  */
-#define Slice99_from_typed_ptr(ptr, len) Slice99_new(ptr, sizeof(*(ptr)), len)
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE bool
+CharSlice99_eq_ignore_ascii_case(CharSlice99 lhs, CharSlice99 rhs) {
+    return lhs.len == rhs.len &&
+           slice99_priv_ascii_eq_ignore_case(
+               (const unsigned char *)lhs.ptr, (const unsigned char *)rhs.ptr, lhs.len);
+}
 
 /**
- * A slice of some array.
+ * Checks whether @p prefix is a prefix of @p self, ignoring the case of the ASCII letters.
  *
- * This structure should not be constructed manually; use #Slice99_new instead.
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
  *
- * @invariant #ptr must not be `NULL`.
- * @invariant #item_size must be strictly greater than 0.
+ * @param[in] self The slice to be checked for @p prefix.
+ * @param[in] prefix The slice to be checked whether it is a prefix of @p self.
+ *
+ * @return `true` if @p prefix is a prefix of @p self when both are lowercased, otherwise `false`.
  */
-typedef struct {
-    /**
-     * The pointer to data.
-     */
-    void *ptr;
-
-    /**
-     * The size of each item in the array addressed by #ptr.
-     */
-    size_t item_size;
-
-    /**
-     * The count of items in the array addressed by #ptr.
-     */
-    size_t len;
-} Slice99;
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE bool
+CharSlice99_starts_with_ignore_ascii_case(CharSlice99 self, CharSlice99 prefix) {
+    return self.len >= prefix.len &&
+           slice99_priv_ascii_eq_ignore_case(
+               (const unsigned char *)self.ptr, (const unsigned char *)prefix.ptr, prefix.len);
+}
 
 /**
- * Constructs a slice.
+ * Checks whether @p postfix is a postfix of @p self, ignoring the case of the ASCII letters.
  *
- * @param[in] ptr The value of Slice99#ptr.
- * @param[in] item_size The value of Slice99#item_size.
- * @param[in] len The value of Slice99#len.
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
  *
- * @pre `ptr != NULL`
- * @pre `item_size > 0`
+ * @param[in] self The slice to be checked for @p postfix.
+ * @param[in] postfix The slice to be checked whether it is a postfix of @p self.
+ *
+ * @return `true` if @p postfix is a postfix of @p self when both are lowercased, otherwise
+ * `false`.
  */
-inline static SLICE99_WARN_UNUSED_RESULT Slice99
-Slice99_new(void *ptr, size_t item_size, size_t len) {
-    SLICE99_ASSERT(ptr);
-    SLICE99_ASSERT(item_size > 0);
-
-    return (Slice99){.ptr = ptr, .item_size = item_size, .len = len};
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE bool
+CharSlice99_ends_with_ignore_ascii_case(CharSlice99 self, CharSlice99 postfix) {
+    return self.len >= postfix.len &&
+           slice99_priv_ascii_eq_ignore_case(
+               (const unsigned char *)self.ptr + (self.len - postfix.len),
+               (const unsigned char *)postfix.ptr, postfix.len);
 }
 
 /**
- * Constructs a slice from @p str.
+ * Converts the ASCII letters of @p self to lowercase in place.
  *
- * @param[in] str Any null-terminated string.
+ * The bytes outside of ASCII are left unchanged.
  *
- * @pre `str != NULL`
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[out] self The slice to be converted.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     char str[] = "Hello, World!";
+ *     CharSlice99 s = CharSlice99_from_str(str);
+ *     CharSlice99_to_ascii_lower(s);
+ *     assert(CharSlice99_primitive_eq(s, CharSlice99_from_str("hello, world!")));
+ * }
+ * @endcode
  */
-inline static SLICE99_WARN_UNUSED_RESULT Slice99 Slice99_from_str(char *str) {
-    SLICE99_ASSERT(str);
-
-    return Slice99_new(str, sizeof(char), SLICE99_STRLEN(str));
+inline static void CharSlice99_to_ascii_lower(CharSlice99 self) {
+    slice99_priv_ascii_flip_case((unsigned char *)self.ptr, self.len, 'A');
 }
 
 /**
- * Constructs a slice residing between @p start (inclusively) and @p end (exclusively).
+ * Converts the ASCII letters of @p self to uppercase in place.
  *
- * @param[in] start The start position of a returned slice, inclusively.
- * @param[in] end The end position of a returned slice, exlusively.
- * @param[in] item_size The value of Slice99#item_size.
+ * The bytes outside of ASCII are left unchanged.
  *
- * @pre `start != NULL`
- * @pre `end != NULL`
- * @pre `((char *)end - (char *)start) >= 0`
- * @pre `(((char *)end - (char *)start)) % item_size == 0`
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[out] self The slice to be converted.
  */
-inline static SLICE99_WARN_UNUSED_RESULT Slice99
-Slice99_from_ptrdiff(void *start, void *end, size_t item_size) {
-    SLICE99_ASSERT(start);
-    SLICE99_ASSERT(end);
-
-    const ptrdiff_t diff = (char *)end - (char *)start;
-
-    SLICE99_ASSERT(diff >= 0);
-    SLICE99_ASSERT((size_t)diff % item_size == 0);
-
-    return Slice99_new(start, item_size, (size_t)(diff / (ptrdiff_t)item_size));
+inline static void CharSlice99_to_ascii_upper(CharSlice99 self) {
+    slice99_priv_ascii_flip_case((unsigned char *)self.ptr, self.len, 'a');
 }
 
 /**
- * Constructs an empty slice.
+ * Removes the leading whitespace of @p self.
  *
- * @param[in] item_size The value of Slice99#item_size.
+ * The whitespace is that of the C locale: the space, `\t`, `\n`, `\v`, `\f`, and `\r`.
  *
- * @pre `item_size > 0`
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[in] self The slice to be trimmed.
+ *
+ * @return The subslice of @p self without the leading whitespace.
  */
-inline static SLICE99_WARN_UNUSED_RESULT Slice99 Slice99_empty(size_t item_size) {
-    SLICE99_ASSERT(item_size > 0);
-    return Slice99_new("", item_size, 0);
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE CharSlice99
+CharSlice99_trim_start(CharSlice99 self) {
+    const size_t n = slice99_priv_ascii_space_prefix((const unsigned char *)self.ptr, self.len);
+    return CharSlice99_advance(self, (ptrdiff_t)n);
 }
 
 /**
- * Updates @p self with the new length @p new_len.
+ * Removes the trailing whitespace of @p self.
  *
- * @param[in] self The slice whose length will be updated.
- * @param[in] new_len The new length.
+ * The whitespace is that of the C locale: the space, `\t`, `\n`, `\v`, `\f`, and `\r`.
+ *
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[in] self The slice to be trimmed.
+ *
+ * @return The subslice of @p self without the trailing whitespace.
  */
-inline static SLICE99_WARN_UNUSED_RESULT Slice99 Slice99_update_len(Slice99 self, size_t new_len) {
-    return Slice99_new(self.ptr, self.item_size, new_len);
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE CharSlice99
+CharSlice99_trim_end(CharSlice99 self) {
+    const size_t n = slice99_priv_ascii_space_suffix((const unsigned char *)self.ptr, self.len);
+    return CharSlice99_update_len(self, self.len - n);
 }
 
 /**
- * Checks whether @p self is empty or not.
+ * Removes the leading and the trailing whitespace of @p self.
  *
- * @param[in] self The checked slice.
+ * The whitespace is that of the C locale: the space, `\t`, `\n`, `\v`, `\f`, and `\r`.
  *
- * @return `true` if @p self is empty, otherwise `false`.
+ * Defined only if `uint8_t`, `uint16_t`, `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[in] self The slice to be trimmed.
+ *
+ * @return The subslice of @p self without the leading and the trailing whitespace.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <assert.h>
+ *
+ * int main(void) {
+ *     CharSlice99 value = CharSlice99_trim(CharSlice99_from_str(" \t keep-alive\r\n"));
+ *     assert(CharSlice99_primitive_eq(value, CharSlice99_from_str("keep-alive")));
+ * }
+ * @endcode
  */
-inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST bool Slice99_is_empty(Slice99 self) {
-    return self.len == 0;
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_PURE CharSlice99
+CharSlice99_trim(CharSlice99 self) {
+    return CharSlice99_trim_end(CharSlice99_trim_start(self));
 }
 
+#endif // defined(UINT8_MAX) && defined(UINT16_MAX) && defined(UINT32_MAX) && defined(UINT64_MAX)
+
+#ifdef SLICE99_ENABLE_MMAP
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// The C library may define `_POSIX_C_SOURCE` itself in the non-strict modes, so this is checked
+// after its headers have been included.
+#if !defined(_POSIX_C_SOURCE) && !defined(_XOPEN_SOURCE) && !defined(_GNU_SOURCE) &&               \
+    !defined(_DEFAULT_SOURCE)
+#error "SLICE99_ENABLE_MMAP requires _POSIX_C_SOURCE >= 200112L to be defined before any #include"
+#endif
+
 /**
- * Computes a total size in bytes.
+ * The flags of #Slice99_mmap_file.
  *
- * @param[in] self The slice whose size is to be computed.
+ * Defined only if `SLICE99_ENABLE_MMAP` is defined.
  */
-inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST size_t Slice99_size(Slice99 self) {
-    return self.item_size * self.len;
+typedef enum {
+    /**
+     * Map the file read-only. Writing to the mapping crashes the program.
+     */
+    SLICE99_MMAP_READ = 0,
+
+    /**
+     * Map the file read-write. Writes go to the page cache and eventually to the file.
+     */
+    SLICE99_MMAP_WRITE = 1 << 0,
+
+    /**
+     * Ask the kernel to back the mapping with transparent huge pages, if it supports them for the
+     * file system of the file. The request is ignored where it is not supported.
+     *
+     * The request is made with `madvise(MADV_HUGEPAGE)`, which glibc declares only if
+     * `_GNU_SOURCE` is defined before including any system header; otherwise, this flag has no
+     * effect.
+     */
+    SLICE99_MMAP_HUGE_PAGES = 1 << 1,
+} Slice99MmapFlags;
+
+/**
+ * The access patterns accepted by #Slice99_madvise.
+ *
+ * Defined only if `SLICE99_ENABLE_MMAP` is defined.
+ */
+typedef enum {
+    /**
+     * No specific pattern (`POSIX_MADV_NORMAL`).
+     */
+    SLICE99_ADVICE_NORMAL,
+
+    /**
+     * Pages will be accessed in order, so the kernel can read ahead aggressively
+     * (`POSIX_MADV_SEQUENTIAL`).
+     */
+    SLICE99_ADVICE_SEQUENTIAL,
+
+    /**
+     * Pages will be accessed in no particular order, so reading ahead is useless
+     * (`POSIX_MADV_RANDOM`).
+     */
+    SLICE99_ADVICE_RANDOM,
+
+    /**
+     * Pages will be needed soon, so the kernel can start reading them in (`POSIX_MADV_WILLNEED`).
+     */
+    SLICE99_ADVICE_WILLNEED,
+
+    /**
+     * Pages will not be needed soon, so the kernel can free them (`POSIX_MADV_DONTNEED`).
+     */
+    SLICE99_ADVICE_DONTNEED,
+} Slice99MmapAdvice;
+
+#ifndef DOXYGEN_IGNORE
+
+inline static SLICE99_WARN_UNUSED_RESULT bool
+slice99_priv_mmap_fd(int fd, int flags, U8Slice99 *restrict out) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        return false;
+    }
+    if ((uintmax_t)st.st_size > SIZE_MAX) {
+        errno = EFBIG;
+        return false;
+    }
+
+    const size_t size = (size_t)st.st_size;
+    if (size == 0) {
+        *out = U8Slice99_empty();
+        return true;
+    }
+
+    const int prot = (flags & SLICE99_MMAP_WRITE) != 0 ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *ptr = mmap(NULL, size, prot, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED) {
+        return false;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if ((flags & SLICE99_MMAP_HUGE_PAGES) != 0) {
+        // Only a hint; not every file system supports huge pages.
+        const int saved_errno = errno;
+        (void)madvise(ptr, size, MADV_HUGEPAGE);
+        errno = saved_errno;
+    }
+#endif
+
+    *out = U8Slice99_new((uint8_t *)ptr, size);
+    return true;
 }
 
+#endif // DOXYGEN_IGNORE
+
 /**
- * Computes a pointer to the @p i -indexed item.
+ * Maps the file at @p path into memory.
  *
- * @param[in] self The slice upon which the pointer will be computed.
- * @param[in] i The index of a desired item. Can be negative.
+ * The mapping is shared, so the page cache backing it is shared with all processes mapping the
+ * same file, and pages are loaded lazily on first access. The file descriptor is closed before
+ * returning; the mapping stays valid until #Slice99_munmap.
  *
- * @pre `self.item_size` must be representable as `ptrdiff_t`.
+ * The mapping of an empty file is an empty slice that does not need to be unmapped, although it
+ * can be.
+ *
+ * Defined only if `SLICE99_ENABLE_MMAP` is defined. Requires POSIX.
+ *
+ * @param[in] path The path to the file.
+ * @param[in] flags A bitwise OR of #Slice99MmapFlags.
+ * @param[out] out The location to which the mapped bytes will be written.
+ *
+ * @return `true` on success, `false` otherwise with `errno` set. In the latter case, @p out is left
+ * unchanged.
+ *
+ * @pre `path != NULL`
+ * @pre `out != NULL`
  */
-inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST void *
-Slice99_get(Slice99 self, ptrdiff_t i) {
-    return (void *)((char *)self.ptr + i * (ptrdiff_t)self.item_size);
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99_mmap_file(const char *restrict path, int flags, U8Slice99 *restrict out) {
+    SLICE99_ASSERT(path);
+    SLICE99_ASSERT(out);
+
+#ifdef O_CLOEXEC
+    const int cloexec = O_CLOEXEC;
+#else
+    const int cloexec = 0;
+#endif
+
+    // The descriptor is closed below, but a program executed by a concurrent `fork` must not
+    // inherit it meanwhile.
+    const int fd =
+        open(path, ((flags & SLICE99_MMAP_WRITE) != 0 ? O_RDWR : O_RDONLY) | cloexec);
+    if (fd < 0) {
+        return false;
+    }
+
+    const bool ok = slice99_priv_mmap_fd(fd, flags, out);
+
+    const int saved_errno = errno;
+    close(fd);
+    errno = saved_errno;
+
+    return ok;
 }
 
 /**
- * Computes a pointer to the first item.
+ * The same as #Slice99_mmap_file but returns `CharSlice99`.
  *
- * @param[in] self The slice upon which the pointer will be computed.
+ * Defined only if `SLICE99_ENABLE_MMAP` is defined.
  */
-inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST void *Slice99_first(Slice99 self) {
-    return Slice99_get(self, 0);
+inline static SLICE99_WARN_UNUSED_RESULT bool
+CharSlice99_mmap_file(const char *restrict path, int flags, CharSlice99 *restrict out) {
+    SLICE99_ASSERT(out);
+
+    U8Slice99 bytes;
+    if (!Slice99_mmap_file(path, flags, &bytes)) {
+        return false;
+    }
+
+    *out = CharSlice99_new((char *)bytes.ptr, bytes.len);
+    return true;
 }
 
 /**
- * Computes a pointer to the last item.
+ * Unmaps a mapping obtained with #Slice99_mmap_file.
  *
- * @param[in] self The slice upon which the pointer will be computed.
+ * Defined only if `SLICE99_ENABLE_MMAP` is defined.
  *
- * @pre `self.len` must be representable as `ptrdiff_t`.
+ * @param[in] mapping The whole mapping, as returned by #Slice99_mmap_file. Untyped and typed
+ * mappings can be passed as `SLICE99_TO_UNTYPED(mapping)`.
+ *
+ * @return `true` on success, `false` otherwise with `errno` set.
  */
-inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST void *Slice99_last(Slice99 self) {
-    return Slice99_get(self, (ptrdiff_t)self.len - 1);
+inline static bool Slice99_munmap(Slice99 mapping) {
+    const size_t size = Slice99_size(mapping);
+    return size == 0 || munmap(mapping.ptr, size) == 0;
 }
 
 /**
- * Subslicing @p self with [@p start_idx `..` @p end_idx].
+ * Advises the kernel about the access pattern of @p region.
  *
- * @param[in] self The original slice.
- * @param[in] start_idx The index at which a new slice will reside, inclusively.
- * @param[in] end_idx The index at which a new slice will end, exclusively.
+ * @p region can be any part of a mapping obtained with #Slice99_mmap_file; it is extended to page
+ * boundaries.
  *
- * @return A slice with the aforementioned properties.
+ * Defined only if `SLICE99_ENABLE_MMAP` is defined.
  *
- * @pre `start_idx <= end_idx`
+ * @param[in] region The memory region to advise about. Typed slices can be passed as
+ * `SLICE99_TO_UNTYPED(region)`.
+ * @param[in] advice The expected access pattern.
+ *
+ * @return `true` on success, `false` otherwise with `errno` set.
  */
-inline static SLICE99_WARN_UNUSED_RESULT Slice99
-Slice99_sub(Slice99 self, ptrdiff_t start_idx, ptrdiff_t end_idx) {
-    SLICE99_ASSERT(start_idx <= end_idx);
+inline static bool Slice99_madvise(Slice99 region, Slice99MmapAdvice advice) {
+    const size_t size = Slice99_size(region);
+    if (size == 0) {
+        return true;
+    }
+
+    int posix_advice = POSIX_MADV_NORMAL;
+    switch (advice) {
+    case SLICE99_ADVICE_NORMAL:
+        posix_advice = POSIX_MADV_NORMAL;
+        break;
+    case SLICE99_ADVICE_SEQUENTIAL:
+        posix_advice = POSIX_MADV_SEQUENTIAL;
+        break;
+    case SLICE99_ADVICE_RANDOM:
+        posix_advice = POSIX_MADV_RANDOM;
+        break;
+    case SLICE99_ADVICE_WILLNEED:
+        posix_advice = POSIX_MADV_WILLNEED;
+        break;
+    case SLICE99_ADVICE_DONTNEED:
+        posix_advice = POSIX_MADV_DONTNEED;
+        break;
+    }
+
+    const uintptr_t page_size = (uintptr_t)sysconf(_SC_PAGESIZE);
+    const uintptr_t start = (uintptr_t)region.ptr & ~(page_size - 1),
+                    end = (uintptr_t)region.ptr + size;
+
+    // Unlike `madvise`, `posix_madvise` returns the error number instead of setting `errno`.
+    const int error = posix_madvise((void *)start, end - start, posix_advice);
+    if (error != 0) {
+        errno = error;
+        return false;
+    }
+
+    return true;
+}
+
+#if defined(UINT8_MAX) && defined(UINT16_MAX) && defined(UINT32_MAX) && defined(UINT64_MAX)
+
+#ifndef DOXYGEN_IGNORE
+
+// Returns a file descriptor of a new anonymous shared memory object, or -1 with `errno` set.
+inline static SLICE99_WARN_UNUSED_RESULT int slice99_priv_ring_fd(void) {
+#ifdef MFD_CLOEXEC
+    return memfd_create("slice99_ring", MFD_CLOEXEC);
+#else
+    // Without `memfd_create`, create a POSIX shared memory object under a unique name and unlink
+    // it at once. The name is derived from the process ID and the address of the stack frame,
+    // which differ among processes and threads; collisions are retried.
+    static const char hex[] = "0123456789abcdef";
+    char name[] = "/slice99-ring-0000000000000000";
+
+    for (uint64_t attempt = 0; attempt < 64; attempt++) {
+        uint64_t x = (uint64_t)getpid() << 32 ^ (uint64_t)(uintptr_t)name ^ attempt;
+        x *= UINT64_C(0x9E3779B97F4A7C15);
+        for (size_t i = 0; i < 16; i++) {
+            name[sizeof name - 2 - i] = hex[(x >> (4 * i)) & 0xF];
+        }
+
+        const int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0) {
+            (void)shm_unlink(name);
+            return fd;
+        }
+        if (errno != EEXIST) {
+            return -1;
+        }
+    }
 
-    return Slice99_from_ptrdiff(
-        Slice99_get(self, start_idx), Slice99_get(self, end_idx), self.item_size);
+    return -1;
+#endif
 }
 
-/**
- * Advances @p self by @p offset items.
- *
- * @param[in] self The original slice.
- * @param[in] offset The number of items to advance. Can be negative.
- *
- * @return A slice advanced by @p offset items.
- *
- * @pre `offset <= (self).len`
- * @pre `self.len` must be representable as `ptrdiff_t`.
- */
-inline static SLICE99_WARN_UNUSED_RESULT Slice99 Slice99_advance(Slice99 self, ptrdiff_t offset) {
-    return Slice99_sub(self, offset, (ptrdiff_t)self.len);
+inline static SLICE99_WARN_UNUSED_RESULT uint8_t *slice99_priv_ring_map(int fd, size_t cap) {
+    if (ftruncate(fd, (off_t)cap) != 0) {
+        return NULL;
+    }
+
+    // Reserve the address range for two copies by mapping it beyond the end of the file, and then
+    // replace the second half (which would fault) with the mirror.
+    void *ptr = mmap(NULL, 2 * cap, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED) {
+        return NULL;
+    }
+
+    void *mirror =
+        mmap((char *)ptr + cap, cap, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    if (mirror == MAP_FAILED) {
+        const int saved_errno = errno;
+        (void)munmap(ptr, 2 * cap);
+        errno = saved_errno;
+        return NULL;
+    }
+
+    return (uint8_t *)ptr;
 }
 
+#endif // DOXYGEN_IGNORE
+
 /**
- * Performs a byte-by-byte comparison of @p lhs with @p rhs.
+ * Constructs an empty ring whose buffer is mapped twice in a row.
  *
- * @param[in] lhs The first slice to be compared.
- * @param[in] rhs The second slice to be compared.
+ * Writing to the first copy changes the second one and vice versa, so #Slice99Ring_readable and
+ * #Slice99Ring_writable are always whole, even when they wrap around the end of the buffer. The
+ * buffer is an anonymous shared memory object (`memfd_create` if available, which requires
+ * `_GNU_SOURCE` with glibc, or `shm_open` otherwise).
  *
- * @return `true` if @p lhs and @p rhs are equal, `false` otherwise.
- */
-inline static SLICE99_WARN_UNUSED_RESULT bool Slice99_primitive_eq(Slice99 lhs, Slice99 rhs) {
-    return Slice99_size(lhs) != Slice99_size(rhs)
-               ? false
-               : SLICE99_MEMCMP(lhs.ptr, rhs.ptr, Slice99_size(lhs)) == 0;
-}
-
-/**
- * Performs a comparison of @p lhs with @p rhs with a user-supplied comparator.
+ * Defined only if `SLICE99_ENABLE_MMAP` is defined. Requires POSIX.
  *
- * @param[in] lhs The first slice to be compared.
- * @param[in] rhs The second slice to be compared.
- * @param[in] cmp The function deciding whether two items are equal ot not (0 if equal, any other
- * value otherwise).
+ * @param[in] min_cap The minimum capacity. The capacity is rounded up to a power of two that is a
+ * multiple of the page size.
+ * @param[out] out The location to which the ring will be written. Release it with
+ * #Slice99Ring_munmap.
  *
- * @return `true` if @p lhs and @p rhs are equal, `false` otherwise.
+ * @return `true` on success, `false` otherwise with `errno` set. In the latter case, @p out is left
+ * unchanged.
  *
- * @pre `lhs.item_size == rhs.item_size`
- * @pre `cmp != NULL`
- * @pre `lhs.len` and `rhs.len` must be representable as `ptrdiff_t`.
+ * @pre `out != NULL`
  */
 inline static SLICE99_WARN_UNUSED_RESULT bool
-Slice99_eq(Slice99 lhs, Slice99 rhs, int (*cmp)(const void *, const void *)) {
-    SLICE99_ASSERT(lhs.item_size == rhs.item_size);
-    SLICE99_ASSERT(cmp);
+Slice99Ring_new_mirrored(size_t min_cap, Slice99Ring *out) {
+    SLICE99_ASSERT(out);
 
-    if (lhs.len != rhs.len) {
+    size_t cap = (size_t)sysconf(_SC_PAGESIZE);
+    while (cap < min_cap) {
+        if (cap > SIZE_MAX / 4) {
+            errno = ENOMEM;
+            return false;
+        }
+        cap *= 2;
+    }
+
+    const int fd = slice99_priv_ring_fd();
+    if (fd < 0) {
         return false;
     }
 
-    for (ptrdiff_t i = 0; i < (ptrdiff_t)lhs.len; i++) {
-        if (cmp(Slice99_get(lhs, i), Slice99_get(rhs, i)) != 0) {
-            return false;
-        }
+    uint8_t *ptr = slice99_priv_ring_map(fd, cap);
+
+    const int saved_errno = errno;
+    close(fd);
+    errno = saved_errno;
+
+    if (ptr == NULL) {
+        return false;
     }
 
+    const Slice99Ring result = {
+        .ptr = ptr,
+        .cap = cap,
+        .head = 0,
+        .tail = 0,
+        .mirrored = true,
+    };
+    *out = result;
     return true;
 }
 
 /**
- * Checks whether @p prefix is a prefix of @p self, byte-by-byte.
+ * Unmaps a ring obtained with #Slice99Ring_new_mirrored.
  *
- * @param[in] self The slice to be checked for @p prefix.
- * @param[in] prefix The slice to be checked whether it is a prefix of @p self.
+ * Defined only if `SLICE99_ENABLE_MMAP` is defined.
  *
- * @return `true` if @p prefix is a prefix of @p self, otherwise `false`.
+ * @param[in] ring The mirrored ring.
  *
- * @pre `prefix.len` must be representable as `ptrdiff_t`.
+ * @return `true` on success, `false` otherwise with `errno` set.
+ *
+ * @pre `ring.mirrored`
  */
-inline static SLICE99_WARN_UNUSED_RESULT bool
-Slice99_primitive_starts_with(Slice99 self, Slice99 prefix) {
-    return Slice99_size(self) < Slice99_size(prefix)
-               ? false
-               : Slice99_primitive_eq(Slice99_sub(self, 0, (ptrdiff_t)prefix.len), prefix);
+inline static bool Slice99Ring_munmap(Slice99Ring ring) {
+    SLICE99_ASSERT(ring.mirrored);
+
+    return munmap(ring.ptr, 2 * ring.cap) == 0;
 }
 
+#endif // defined(UINT8_MAX) && defined(UINT16_MAX) && defined(UINT32_MAX) && defined(UINT64_MAX)
+
+#endif // SLICE99_ENABLE_MMAP
+
+#ifdef SLICE99_ENABLE_IOVEC
+
+#include <errno.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
 /**
- * Checks whether @p prefix is a prefix of @p self with a user-supplied comparator.
+ * A builder of `struct iovec` arrays for vectored I/O, backed by a caller-provided array.
  *
- * @param[in] self The slice to be checked for @p prefix.
- * @param[in] prefix The slice to be checked whether it is a prefix of @p self.
- * @param[in] cmp The function deciding whether two items are equal ot not (0 if equal, any other
- * value otherwise).
+ * Pushing a slice records its address and size without copying its contents, so a response made
+ * of separate header and body slices can be written with a single `writev` call. After a partial
+ * write, #Slice99IoVec_advance drops the written bytes from the front of the vector.
  *
- * @return `true` if @p prefix is a prefix of @p self, otherwise `false`.
+ * #iov and #len can be passed directly to `writev`, `readv`, and io_uring, for example as
+ * `io_uring_prep_writev(sqe, fd, v.iov, (unsigned)v.len, offset)`. In the latter case, the
+ * entries must stay valid until the request has been submitted, and #Slice99IoVec_advance can be
+ * called with the result of a short completion.
  *
- * @pre `self.item_size == prefix.item_size`
- * @pre `cmp != NULL`
- * @pre `prefix.len` must be representable as `ptrdiff_t`.
+ * Defined only if `SLICE99_ENABLE_IOVEC` is defined.
+ *
+ * # Examples
+ *
+ * @code
+ * #include <slice99.h>
+ *
+ * #include <unistd.h>
+ *
+ * int main(void) {
+ *     struct iovec buffer[3];
+ *     Slice99IoVec v = Slice99IoVec_new(buffer, 3);
+ *
+ *     const CharSlice99 pieces[] = {
+ *         CharSlice99_from_str("HTTP/1.1 200 OK\r\n"),
+ *         CharSlice99_from_str("Content-Length: 6\r\n\r\n"),
+ *         CharSlice99_from_str("Hello\n"),
+ *     };
+ *     for (size_t i = 0; i < 3; i++) {
+ *         if (!Slice99IoVec_push(&v, SLICE99_TO_UNTYPED(pieces[i]))) {
+ *             return 1;
+ *         }
+ *     }
+ *
+ *     return Slice99IoVec_writev(&v, STDOUT_FILENO) ? 0 : 1;
+ * }
+ * @endcode
  */
-inline static SLICE99_WARN_UNUSED_RESULT bool
-Slice99_starts_with(Slice99 self, Slice99 prefix, int (*cmp)(const void *, const void *)) {
-    SLICE99_ASSERT(self.item_size == prefix.item_size);
-    SLICE99_ASSERT(cmp);
+typedef struct {
+    /**
+     * The remaining entries.
+     */
+    struct iovec *iov;
 
-    return self.len < prefix.len
-               ? false
-               : Slice99_eq(Slice99_sub(self, 0, (ptrdiff_t)prefix.len), prefix, cmp);
-}
+    /**
+     * The count of the remaining entries.
+     */
+    size_t len;
+
+    /**
+     * The count of entries that #iov can hold.
+     */
+    size_t cap;
+
+    /**
+     * The total size of the remaining entries, in bytes.
+     */
+    size_t size;
+} Slice99IoVec;
 
 /**
- * Checks whether @p postfix is a postfix of @p self, byte-by-byte.
+ * Constructs an empty vector that will store its entries in @p buffer.
  *
- * @param[in] self The slice to be checked for @p postfix.
- * @param[in] postfix The slice to be checked whether it is a postfix of @p self.
+ * Defined only if `SLICE99_ENABLE_IOVEC` is defined.
  *
- * @return `true` if @p postfix is a postfix of @p self, otherwise `false`.
+ * @param[out] buffer The array of at least @p cap entries.
+ * @param[in] cap The count of entries that @p buffer can hold.
  *
- * @pre `self.len` and `postfix.len` must be representable as `ptrdiff_t`.
+ * @pre `buffer != NULL`
  */
-inline static SLICE99_WARN_UNUSED_RESULT bool
-Slice99_primitive_ends_with(Slice99 self, Slice99 postfix) {
-    return Slice99_size(self) < Slice99_size(postfix)
-               ? false
-               : Slice99_primitive_eq(
-                     Slice99_sub(
-                         self, (ptrdiff_t)self.len - (ptrdiff_t)postfix.len, (ptrdiff_t)self.len),
-                     postfix);
+inline static SLICE99_WARN_UNUSED_RESULT Slice99IoVec
+Slice99IoVec_new(struct iovec buffer[], size_t cap) {
+    SLICE99_ASSERT(buffer);
+
+    const Slice99IoVec result = {.iov = buffer, .len = 0, .cap = cap, .size = 0};
+    return result;
 }
 
 /**
- * Checks whether @p postfix is a postfix of @p self with a user-supplied comparator.
+ * Checks whether @p self has no bytes left.
  *
- * @param[in] self The slice to be checked for @p postfix.
- * @param[in] postfix The slice to be checked whether it is a postfix of @p self.
- * @param[in] cmp The function deciding whether two items are equal ot not (0 if equal, any other
- * value otherwise).
+ * Defined only if `SLICE99_ENABLE_IOVEC` is defined.
  *
- * @return `true` if @p postfix is a postfix of @p self, otherwise `false`.
+ * @param[in] self The checked vector.
  *
- * @pre `self.item_size == postfix.item_size`
- * @pre `cmp != NULL`
- * @pre `self.len` and `postfix.len` must be representable as `ptrdiff_t`.
+ * @return `true` if `self.size` is 0, `false` otherwise.
  */
-inline static SLICE99_WARN_UNUSED_RESULT bool
-Slice99_ends_with(Slice99 self, Slice99 postfix, int (*cmp)(const void *, const void *)) {
-    SLICE99_ASSERT(self.item_size == postfix.item_size);
-    SLICE99_ASSERT(cmp);
-
-    return self.len < postfix.len
-               ? false
-               : Slice99_eq(
-                     Slice99_sub(
-                         self, (ptrdiff_t)self.len - (ptrdiff_t)postfix.len, (ptrdiff_t)self.len),
-                     postfix, cmp);
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_CONST bool
+Slice99IoVec_is_empty(Slice99IoVec self) {
+    return self.size == 0;
 }
 
 /**
- * Copies @p other to the beginning of @p self, byte-by-byte.
+ * Appends an entry addressing the bytes of @p slice to @p self.
  *
- * @param[out] self The location to which the whole @p other will be copied.
- * @param[in] other The slice to be copied to @p self.
+ * Empty slices are skipped. The bytes are not copied, so @p slice must outlive the I/O.
+ *
+ * Defined only if `SLICE99_ENABLE_IOVEC` is defined.
+ *
+ * @param[in,out] self The vector to append to.
+ * @param[in] slice The slice to append. Typed slices can be passed as `SLICE99_TO_UNTYPED(slice)`.
+ *
+ * @return `true` on success, `false` if @p self is full. In the latter case, @p self is left
+ * unchanged.
+ *
+ * @pre `self != NULL`
  */
-inline static void Slice99_copy(Slice99 self, Slice99 other) {
-    SLICE99_MEMMOVE(self.ptr, other.ptr, Slice99_size(other));
+inline static SLICE99_WARN_UNUSED_RESULT bool Slice99IoVec_push(Slice99IoVec *self, Slice99 slice) {
+    SLICE99_ASSERT(self);
+
+    const size_t size = Slice99_size(slice);
+    if (size == 0) {
+        return true;
+    }
+    if (self->len == self->cap) {
+        return false;
+    }
+
+    self->iov[self->len].iov_base = slice.ptr;
+    self->iov[self->len].iov_len = size;
+    self->len++;
+    self->size += size;
+    return true;
 }
 
 /**
- * The same as #Slice99_copy except that @p self and @p other must be non-overlapping.
+ * Drops the first @p n bytes from @p self.
  *
- * @pre @p self and @p other must be non-overlapping.
+ * Whole entries are removed from the front, and the first remaining entry is shortened in place.
+ * Pass the result of a partial `writev` or `readv` to continue from where it has stopped.
+ *
+ * Defined only if `SLICE99_ENABLE_IOVEC` is defined.
+ *
+ * @param[in,out] self The vector to advance.
+ * @param[in] n The count of bytes to drop.
+ *
+ * @pre `self != NULL`
+ * @pre `n <= self->size`
  */
-inline static void Slice99_copy_non_overlapping(Slice99 self, Slice99 other) {
-    SLICE99_MEMCPY(self.ptr, other.ptr, Slice99_size(other));
+inline static void Slice99IoVec_advance(Slice99IoVec *self, size_t n) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(n <= self->size);
+
+    self->size -= n;
+
+    while (self->len > 0 && n >= self->iov->iov_len) {
+        n -= self->iov->iov_len;
+        self->iov++;
+        self->len--;
+        self->cap--;
+    }
+
+    if (n > 0) {
+        self->iov->iov_base = (char *)self->iov->iov_base + n;
+        self->iov->iov_len -= n;
+    }
+}
+
+#ifndef DOXYGEN_IGNORE
+
+inline static SLICE99_WARN_UNUSED_RESULT int slice99_priv_iov_max(size_t len) {
+#ifdef IOV_MAX
+    const long max = IOV_MAX;
+#else
+    long max = sysconf(_SC_IOV_MAX);
+    if (max <= 0 || max > INT_MAX) {
+        // The minimum guaranteed by POSIX (`_XOPEN_IOV_MAX`).
+        max = 16;
+    }
+#endif
+
+    return len < (size_t)max ? (int)len : (int)max;
 }
 
+#endif // DOXYGEN_IGNORE
+
 /**
- * Swaps the @p lhs -indexed and @p rhs -indexed items.
+ * Writes all the bytes of @p self to @p fd.
  *
- * @param[out] self The slice in which @p lhs and @p rhs will be swapped.
- * @param[in] lhs The index of the first item.
- * @param[in] rhs The index of the second item.
- * @param[out] backup The memory area of `self.item_size` bytes accessible for reading and writing.
+ * `writev` is called until everything has been written, at most `IOV_MAX` entries at a time, and
+ * is restarted if interrupted by a signal. Empty entries at the front are dropped before each
+ * call, so that it never passes only empty entries. @p self is advanced by the written bytes, so it
+ * holds the unwritten remainder if an error occurs, e.g., `EAGAIN` on a non-blocking socket.
  *
- * @pre `backup != NULL`
- * @pre @p backup must not overlap with `Slice99_get(self, lhs)` and `Slice99_get(self, rhs)`.
- * @pre `Slice99_get(self, lhs)` and `Slice99_get(self, rhs)` must not overlap.
+ * Defined only if `SLICE99_ENABLE_IOVEC` is defined. Requires POSIX.
+ *
+ * @param[in,out] self The vector to write.
+ * @param[in] fd The file descriptor to write to.
+ *
+ * @return `true` on success, `false` otherwise with `errno` set.
+ *
+ * @pre `self != NULL`
  */
-inline static void Slice99_swap(Slice99 self, ptrdiff_t lhs, ptrdiff_t rhs, void *restrict backup) {
-    SLICE99_ASSERT(backup);
+inline static SLICE99_WARN_UNUSED_RESULT bool Slice99IoVec_writev(Slice99IoVec *self, int fd) {
+    SLICE99_ASSERT(self);
+
+    while (self->size > 0) {
+        // Drops the empty entries at the front.
+        Slice99IoVec_advance(self, 0);
+
+        const ssize_t written = writev(fd, self->iov, slice99_priv_iov_max(self->len));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        Slice99IoVec_advance(self, (size_t)written);
+    }
 
-    SLICE99_MEMCPY((backup), Slice99_get(self, lhs), (self).item_size);
-    SLICE99_MEMCPY(Slice99_get(self, lhs), Slice99_get(self, rhs), (self).item_size);
-    SLICE99_MEMCPY(Slice99_get(self, rhs), (backup), (self).item_size);
+    return true;
 }
 
 /**
- * Swaps all the items in @p self with those in @p other.
+ * Reads from @p fd into the bytes addressed by @p self until they are filled or the end of file
+ * is reached.
  *
- * @param[out] self The first slice to be swapped.
- * @param[out] other The second slice to be swapped.
- * @param[out] backup The memory area of `self.item_size` bytes accessible for reading and writing.
+ * `readv` is called in the same manner as `writev` in #Slice99IoVec_writev. @p self is advanced
+ * by the read bytes, so `self->size` is the count of the unfilled bytes afterwards.
  *
- * @pre `self.len == other.len`
- * @pre `self.item_size == other.item_size`
- * @pre @p backup must not overlap with @p self and @p other.
- * @pre @p self and @p other must not overlap.
- * @pre `self.len` must be representable as `ptrdiff_t`.
+ * Defined only if `SLICE99_ENABLE_IOVEC` is defined. Requires POSIX.
+ *
+ * @param[in,out] self The vector to read into.
+ * @param[in] fd The file descriptor to read from.
+ *
+ * @return `true` on success, `false` otherwise with `errno` set.
+ *
+ * @pre `self != NULL`
  */
-inline static void Slice99_swap_with_slice(Slice99 self, Slice99 other, void *restrict backup) {
-    SLICE99_ASSERT(self.len == other.len);
-    SLICE99_ASSERT(self.item_size == other.item_size);
+inline static SLICE99_WARN_UNUSED_RESULT bool Slice99IoVec_readv(Slice99IoVec *self, int fd) {
+    SLICE99_ASSERT(self);
 
-    for (ptrdiff_t i = 0; i < (ptrdiff_t)self.len; i++) {
-        SLICE99_MEMCPY(backup, Slice99_get(self, i), self.item_size);
-        SLICE99_MEMCPY(Slice99_get(self, i), Slice99_get(other, i), self.item_size);
-        SLICE99_MEMCPY(Slice99_get(other, i), backup, self.item_size);
+    while (self->size > 0) {
+        // Drops the empty entries at the front.
+        Slice99IoVec_advance(self, 0);
+
+        const ssize_t received = readv(fd, self->iov, slice99_priv_iov_max(self->len));
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (received == 0) {
+            break;
+        }
+
+        Slice99IoVec_advance(self, (size_t)received);
     }
+
+    return true;
 }
 
+#endif // SLICE99_ENABLE_IOVEC
+
+#ifdef SLICE99_ENABLE_PARALLEL
+
+#include <pthread.h>
+#include <unistd.h>
+
+#ifndef SLICE99_PAR_THRESHOLD
+/// The size in bytes below which the `Slice99_par_*` functions run on the calling thread only.
+/// Defined only if it has not been defined previously **and** `SLICE99_ENABLE_PARALLEL` is defined.
+#define SLICE99_PAR_THRESHOLD (1024 * 1024)
+#endif
+
+#ifndef SLICE99_PAR_CHUNK_SIZE
+/// The approximate size in bytes of the chunks the `Slice99_par_*` functions hand out to threads.
+/// Defined only if it has not been defined previously **and** `SLICE99_ENABLE_PARALLEL` is defined.
+#define SLICE99_PAR_CHUNK_SIZE (256 * 1024)
+#endif
+
+#ifndef SLICE99_PAR_MAX_THREADS
+/// The maximum number of threads the `Slice99_par_*` functions run on. Defined only if it has not
+/// been defined previously **and** `SLICE99_ENABLE_PARALLEL` is defined.
+#define SLICE99_PAR_MAX_THREADS 64
+#endif
+
 /**
- * Reverses the order of items in @p self.
+ * A callback invoked by #Slice99_par_for_each on each chunk.
  *
- * @param[out] self The slice to be reversed.
- * @param[out] backup The memory area of `self.item_size` bytes accessible for reading and writing.
+ * @param[in] chunk The chunk to process.
+ * @param[in] offset The index of the first item of @p chunk in the whole slice.
+ * @param[in] ctx The user-supplied context.
  *
- * @pre `backup != NULL`
- * @pre `self.len` must be representable as `ptrdiff_t`.
+ * Defined only if `SLICE99_ENABLE_PARALLEL` is defined.
  */
-inline static void Slice99_reverse(Slice99 self, void *restrict backup) {
-    SLICE99_ASSERT(backup);
+typedef void (*Slice99ParFn)(Slice99 chunk, size_t offset, void *ctx);
+
+#ifndef DOXYGEN_IGNORE
+
+struct slice99_priv_par_job {
+    pthread_mutex_t lock;
+    size_t next_chunk, num_chunks;
+    // Set when the result is known and the remaining chunks can be skipped.
+    bool done;
+
+    // In items.
+    size_t chunk_len;
+    Slice99 lhs, rhs;
+
+    void (*kernel)(struct slice99_priv_par_job *job, size_t start, size_t len);
+    Slice99ParFn f;
+    void *ctx;
+    bool mismatch;
+};
+
+inline static SLICE99_WARN_UNUSED_RESULT bool
+slice99_priv_par_claim(struct slice99_priv_par_job *job, size_t *start, size_t *len) {
+    pthread_mutex_lock(&job->lock);
+    const bool claimed = !job->done && job->next_chunk < job->num_chunks;
+    const size_t chunk = job->next_chunk++;
+    pthread_mutex_unlock(&job->lock);
 
-    for (ptrdiff_t i = 0; i < (ptrdiff_t)self.len / 2; i++) {
-        Slice99_swap(self, i, (ptrdiff_t)self.len - i - 1, backup);
+    if (claimed) {
+        *start = chunk * job->chunk_len;
+        *len = job->lhs.len - *start < job->chunk_len ? job->lhs.len - *start : job->chunk_len;
     }
+
+    return claimed;
 }
 
-/**
- * Splits @p self into two parts.
- *
- * @param[in] self The slice to be splitted into @p lhs and @p rhs.
- * @param[in] i The index at which @p self will be splitted.
- * @param[out] lhs The first part of @p self indexed as [0; @p i).
- * @param[out] rhs The second part of @p self indexed as [@p i; `self.len`).
- *
- * @pre `i <= self.len`
- * @pre `lhs != NULL`
- * @pre `rhs != NULL`
- * @pre `self.len` and @p i must be representable as `ptrdiff_t`.
- */
-inline static void
-Slice99_split_at(Slice99 self, size_t i, Slice99 *restrict lhs, Slice99 *restrict rhs) {
-    SLICE99_ASSERT(i <= self.len);
-    SLICE99_ASSERT(lhs);
-    SLICE99_ASSERT(rhs);
+inline static void *slice99_priv_par_worker(void *arg) {
+    struct slice99_priv_par_job *job = (struct slice99_priv_par_job *)arg;
 
-    *lhs = Slice99_sub(self, 0, (ptrdiff_t)i);
-    *rhs = Slice99_sub(self, (ptrdiff_t)i, (ptrdiff_t)self.len);
+    size_t start, len;
+    while (slice99_priv_par_claim(job, &start, &len)) {
+        job->kernel(job, start, len);
+    }
+
+    return NULL;
 }
 
-/**
- * Copies @p self to @p out and appends '\0' to the end.
- *
- * @param[in] self The slice that will be copied.
- * @param[in] out The memory area to which @p self and the null character will be copied.
- *
- * @return The pointer @p out.
- *
- * @pre @p out must be capable of writing `Slice99_size(self) + 1` bytes.
- * @pre @p out must not overlap with @p self.
- */
-inline static char *Slice99_c_str(Slice99 self, char out[restrict]) {
-    SLICE99_ASSERT(out);
+inline static SLICE99_WARN_UNUSED_RESULT size_t slice99_priv_par_num_threads(size_t num_threads) {
+    if (num_threads == 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = online > 0 ? (size_t)online : 1;
+#else
+        num_threads = 1;
+#endif
+    }
 
-    SLICE99_MEMCPY(out, self.ptr, Slice99_size(self));
-    out[Slice99_size(self)] = '\0';
-    return out;
+    return num_threads < SLICE99_PAR_MAX_THREADS ? num_threads : SLICE99_PAR_MAX_THREADS;
 }
 
-SLICE99_DEF_TYPED(CharSlice99, char);
-SLICE99_DEF_TYPED(SCharSlice99, signed char);
-SLICE99_DEF_TYPED(UCharSlice99, unsigned char);
+// Splits `job->lhs` into chunks and runs `job->kernel` on them, either on the calling thread alone
+// or on up to `num_threads` threads (including the calling one) claiming chunks dynamically.
+inline static void slice99_priv_par_run(struct slice99_priv_par_job *job, size_t num_threads) {
+    const size_t size = Slice99_size(job->lhs);
+    num_threads = slice99_priv_par_num_threads(num_threads);
 
-SLICE99_DEF_TYPED(ShortSlice99, short);
-SLICE99_DEF_TYPED(UShortSlice99, unsigned short);
+    job->done = false;
+    pthread_mutex_init(&job->lock, NULL);
 
-SLICE99_DEF_TYPED(IntSlice99, int);
-SLICE99_DEF_TYPED(UIntSlice99, unsigned int);
+    // Make chunk sizes a multiple of both the cache line and the item size, so that no cache line
+    // is written by two threads when `job->lhs.ptr` is aligned to the cache line.
+    size_t a = job->lhs.item_size, b = 64;
+    while (b != 0) {
+        const size_t r = a % b;
+        a = b;
+        b = r;
+    }
+    const size_t unit = job->lhs.item_size / a * 64;
+    const size_t chunk_size = SLICE99_PAR_CHUNK_SIZE > unit ? SLICE99_PAR_CHUNK_SIZE / unit * unit
+                                                             : unit;
 
-SLICE99_DEF_TYPED(LongSlice99, long);
-SLICE99_DEF_TYPED(ULongSlice99, unsigned long);
-SLICE99_DEF_TYPED(LongLongSlice99, long long);
-SLICE99_DEF_TYPED(ULongLongSlice99, unsigned long long);
+    job->chunk_len = chunk_size / job->lhs.item_size;
+    job->num_chunks = (job->lhs.len + job->chunk_len - 1) / job->chunk_len;
+    job->next_chunk = 0;
 
-SLICE99_DEF_TYPED(FloatSlice99, float);
-SLICE99_DEF_TYPED(DoubleSlice99, double);
-SLICE99_DEF_TYPED(LongDoubleSlice99, long double);
+    // An empty slice has no chunks, so it must not reach the thread count computation below.
+    if (size < SLICE99_PAR_THRESHOLD || num_threads == 1 || job->num_chunks <= 1) {
+        job->kernel(job, 0, job->lhs.len);
+        pthread_mutex_destroy(&job->lock);
+        return;
+    }
 
-SLICE99_DEF_TYPED(BoolSlice99, _Bool);
+    if (num_threads > job->num_chunks) {
+        num_threads = job->num_chunks;
+    }
 
-// Unsigned integers {
-#ifdef UINT8_MAX
-SLICE99_DEF_TYPED(U8Slice99, uint8_t);
-#endif
+    pthread_t threads[SLICE99_PAR_MAX_THREADS];
+    size_t spawned = 0;
+    for (; spawned < num_threads - 1; spawned++) {
+        // If a thread cannot be created, the already running ones claim its chunks.
+        if (pthread_create(&threads[spawned], NULL, slice99_priv_par_worker, job) != 0) {
+            break;
+        }
+    }
 
-#ifdef UINT16_MAX
-SLICE99_DEF_TYPED(U16Slice99, uint16_t);
-#endif
+    slice99_priv_par_worker(job);
 
-#ifdef UINT32_MAX
-SLICE99_DEF_TYPED(U32Slice99, uint32_t);
-#endif
+    for (size_t i = 0; i < spawned; i++) {
+        pthread_join(threads[i], NULL);
+    }
 
-#ifdef UINT64_MAX
-SLICE99_DEF_TYPED(U64Slice99, uint64_t);
-#endif
-// } (Unsigned integers)
+    pthread_mutex_destroy(&job->lock);
+}
 
-// Signed integers {
-#ifdef INT8_MAX
-SLICE99_DEF_TYPED(I8Slice99, int8_t);
-#endif
+inline static void
+slice99_priv_par_for_each_kernel(struct slice99_priv_par_job *job, size_t start, size_t len) {
+    job->f(Slice99_sub(job->lhs, (ptrdiff_t)start, (ptrdiff_t)(start + len)), start, job->ctx);
+}
 
-#ifdef INT16_MAX
-SLICE99_DEF_TYPED(I16Slice99, int16_t);
-#endif
+inline static void
+slice99_priv_par_copy_kernel(struct slice99_priv_par_job *job, size_t start, size_t len) {
+    Slice99_copy_non_overlapping(
+        Slice99_sub(job->lhs, (ptrdiff_t)start, (ptrdiff_t)(start + len)),
+        Slice99_sub(job->rhs, (ptrdiff_t)start, (ptrdiff_t)(start + len)));
+}
 
-#ifdef INT32_MAX
-SLICE99_DEF_TYPED(I32Slice99, int32_t);
-#endif
+inline static void
+slice99_priv_par_eq_kernel(struct slice99_priv_par_job *job, size_t start, size_t len) {
+    const size_t offset = start * job->lhs.item_size, size = len * job->lhs.item_size;
 
-#ifdef INT64_MAX
-SLICE99_DEF_TYPED(I64Slice99, int64_t);
-#endif
-// } (Signed integers)
+    if (SLICE99_MEMCMP((char *)job->lhs.ptr + offset, (char *)job->rhs.ptr + offset, size) != 0) {
+        pthread_mutex_lock(&job->lock);
+        job->mismatch = true;
+        job->done = true;
+        pthread_mutex_unlock(&job->lock);
+    }
+}
+
+inline static void
+slice99_priv_par_swap_kernel(struct slice99_priv_par_job *job, size_t start, size_t len) {
+    // Swapping two ranges exchanges their bytes regardless of the item size.
+    const size_t offset = start * job->lhs.item_size, size = len * job->lhs.item_size;
+    char *lhs = (char *)job->lhs.ptr + offset, *rhs = (char *)job->rhs.ptr + offset;
+
+    unsigned char tmp[16];
+    slice99_priv_swap_ranges(lhs, rhs, size / 16, 16, tmp);
+    slice99_priv_swap_ranges(lhs + size / 16 * 16, rhs + size / 16 * 16, size % 16, 1, tmp);
+}
+
+#endif // DOXYGEN_IGNORE
 
 /**
- * The same as #Slice99_from_str.
+ * Invokes @p f on consecutive chunks of @p self in parallel.
+ *
+ * The chunks cover @p self without overlapping; their sizes are multiples of both the item size and
+ * 64 bytes (except for the last one), so that no cache line is shared between two chunks if
+ * `self.ptr` is aligned to the cache line. If @p self is smaller than #SLICE99_PAR_THRESHOLD bytes,
+ * @p f is invoked once on the whole @p self on the calling thread.
+ *
+ * The chunks are claimed dynamically by up to @p num_threads threads, including the calling one, so
+ * that threads finishing early take over the remaining work. The threads are created and joined
+ * during the call; in case a thread cannot be created, its chunks are processed by the others.
+ *
+ * Defined only if `SLICE99_ENABLE_PARALLEL` is defined. Requires POSIX threads.
+ *
+ * @param[in] self The slice to process.
+ * @param[in] num_threads The maximum number of threads, or 0 to use the number of online CPUs.
+ * It is capped by #SLICE99_PAR_MAX_THREADS.
+ * @param[in] f The function to call on each chunk. It can be called concurrently from different
+ * threads.
+ * @param[in] ctx The context passed to @p f.
+ *
+ * @pre `f != NULL`
  */
-inline static SLICE99_WARN_UNUSED_RESULT CharSlice99 CharSlice99_from_str(char *str) {
-    return (CharSlice99)SLICE99_TO_TYPED(Slice99_from_str(str));
+inline static void
+Slice99_par_for_each(Slice99 self, size_t num_threads, Slice99ParFn f, void *ctx) {
+    SLICE99_ASSERT(f);
+
+    struct slice99_priv_par_job job = {
+        .lhs = self, .kernel = slice99_priv_par_for_each_kernel, .f = f, .ctx = ctx};
+    slice99_priv_par_run(&job, num_threads);
 }
 
 /**
- * The same as #Slice99_c_str.
+ * The parallel version of #Slice99_copy_non_overlapping.
+ *
+ * See #Slice99_par_for_each for the splitting of the work.
+ *
+ * Defined only if `SLICE99_ENABLE_PARALLEL` is defined.
+ *
+ * @pre `self.len == other.len`
+ * @pre `self.item_size == other.item_size`
  */
-inline static char *CharSlice99_c_str(CharSlice99 self, char out[restrict]) {
-    return Slice99_c_str(SLICE99_TO_UNTYPED(self), out);
+inline static void
+Slice99_par_copy_non_overlapping(Slice99 self, Slice99 other, size_t num_threads) {
+    SLICE99_ASSERT(self.len == other.len);
+    SLICE99_ASSERT(self.item_size == other.item_size);
+
+    struct slice99_priv_par_job job = {
+        .lhs = self, .rhs = other, .kernel = slice99_priv_par_copy_kernel};
+    slice99_priv_par_run(&job, num_threads);
 }
 
 /**
- * Makes a null-terminated string out of `CharSlice99` using `alloca`.
+ * The parallel version of #Slice99_primitive_eq.
  *
- * The same as #CharSlice99_c_str, except that the second parameter is allocated using `alloca`. Do
- * not use this macro for big strings to avoid stack overflow.
+ * See #Slice99_par_for_each for the splitting of the work. Once a thread finds a mismatch, the
+ * remaining chunks are not compared.
+ *
+ * Defined only if `SLICE99_ENABLE_PARALLEL` is defined.
  */
-#define CharSlice99_alloca_c_str(self) CharSlice99_c_str((self), alloca((self).len + 1))
+inline static SLICE99_WARN_UNUSED_RESULT bool
+Slice99_par_primitive_eq(Slice99 lhs, Slice99 rhs, size_t num_threads) {
+    if (Slice99_size(lhs) != Slice99_size(rhs)) {
+        return false;
+    }
+
+    // Compare bytes, so that both slices are split at the same offsets.
+    struct slice99_priv_par_job job = {
+        .lhs = Slice99_new(lhs.ptr, 1, Slice99_size(lhs)),
+        .rhs = Slice99_new(rhs.ptr, 1, Slice99_size(rhs)),
+        .kernel = slice99_priv_par_eq_kernel,
+        .mismatch = false,
+    };
+    slice99_priv_par_run(&job, num_threads);
+    return !job.mismatch;
+}
+
+/**
+ * The parallel version of #Slice99_swap_with_slice.
+ *
+ * Unlike #Slice99_swap_with_slice, it does not need a backup memory area. See #Slice99_par_for_each
+ * for the splitting of the work.
+ *
+ * Defined only if `SLICE99_ENABLE_PARALLEL` is defined.
+ *
+ * @pre `self.len == other.len`
+ * @pre `self.item_size == other.item_size`
+ * @pre @p self and @p other must not overlap.
+ */
+inline static void Slice99_par_swap_with_slice(Slice99 self, Slice99 other, size_t num_threads) {
+    SLICE99_ASSERT(self.len == other.len);
+    SLICE99_ASSERT(self.item_size == other.item_size);
+
+    struct slice99_priv_par_job job = {
+        .lhs = self, .rhs = other, .kernel = slice99_priv_par_swap_kernel};
+    slice99_priv_par_run(&job, num_threads);
+}
+
+#endif // SLICE99_ENABLE_PARALLEL
 
 #ifndef SLICE99_DISABLE_STDIO
 
@@ -1000,6 +10214,18 @@ inline static char *CharSlice99_c_str(CharSlice99 self, char out[restrict]) {
 #define SLICE99_FORMAT_HINT_2_3 SLICE99_FORMAT_HINT(printf, 2, 3)
 #define SLICE99_FORMAT_HINT_3_0 SLICE99_FORMAT_HINT(printf, 3, 0)
 #define SLICE99_FORMAT_HINT_3_4 SLICE99_FORMAT_HINT(printf, 3, 4)
+#define SLICE99_FORMAT_HINT_4_0 SLICE99_FORMAT_HINT(printf, 4, 0)
+#define SLICE99_FORMAT_HINT_4_5 SLICE99_FORMAT_HINT(printf, 4, 5)
+
+// Constructs the slice of the characters actually written by `vsnprintf` returning `len`.
+inline static SLICE99_WARN_UNUSED_RESULT CharSlice99
+slice99_priv_nfmt_result(char *out, size_t bufsz, int len) {
+    if (len < 0 || bufsz == 0) {
+        return CharSlice99_empty();
+    }
+
+    return CharSlice99_new(out, (size_t)len < bufsz ? (size_t)len : bufsz - 1);
+}
 
 #endif // DOXYGEN_IGNORE
 
@@ -1013,7 +10239,8 @@ inline static char *CharSlice99_c_str(CharSlice99 self, char out[restrict]) {
  * @param[in] fmt The `printf`-like format string.
  * @param[in] list The variadic function arguments reified into `va_list`.
  *
- * @return A character slice constructed from @p out.
+ * @return A character slice of the characters written to @p out, whose length is the one returned
+ * by #SLICE99_VSPRINTF, or an empty slice if formatting has failed.
  *
  * @pre `out != NULL`
  * @pre `fmt != NULL`
@@ -1023,8 +10250,12 @@ CharSlice99_vfmt(char out[restrict], const char *restrict fmt, va_list list) {
     SLICE99_ASSERT(out);
     SLICE99_ASSERT(fmt);
 
-    SLICE99_VSPRINTF(out, fmt, list);
-    return CharSlice99_from_str(out);
+    const int len = SLICE99_VSPRINTF(out, fmt, list);
+    const CharSlice99 result = CharSlice99_new(out, len < 0 ? 0 : (size_t)len);
+
+    SLICE99_PRIV_STATS_RECORD(SLICE99_STATS_FMT, result.len, false, false);
+
+    return result;
 }
 
 /**
@@ -1044,12 +10275,19 @@ CharSlice99_fmt(char out[restrict], const char *restrict fmt, ...) {
 /**
  * The same as #CharSlice99_vfmt but writes at most `bufsz - 1` characters.
  *
+ * The output is silently truncated; use #CharSlice99_try_vnfmt to detect truncation.
+ *
  * Defined only if `SLICE99_DISABLE_STDIO` is **not** defined.
  */
 inline static SLICE99_WARN_UNUSED_RESULT SLICE99_FORMAT_HINT_3_0 CharSlice99
 CharSlice99_vnfmt(char out[restrict], size_t bufsz, const char *restrict fmt, va_list list) {
-    SLICE99_VSNPRINTF(out, bufsz, fmt, list);
-    return CharSlice99_from_str(out);
+    const int len = SLICE99_VSNPRINTF(out, bufsz, fmt, list);
+    const CharSlice99 result = slice99_priv_nfmt_result(out, bufsz, len);
+
+    SLICE99_PRIV_STATS_RECORD(
+        SLICE99_STATS_NFMT, result.len, false, len >= 0 && (size_t)len >= bufsz);
+
+    return result;
 }
 
 /**
@@ -1066,12 +10304,197 @@ CharSlice99_nfmt(char out[restrict], size_t bufsz, const char *restrict fmt, ...
     return result;
 }
 
+/**
+ * Prints a formatted string to @p out of @p bufsz characters, reporting truncation.
+ *
+ * Defined only if `SLICE99_DISABLE_STDIO` is **not** defined.
+ *
+ * @param[out] out The buffer to print to, followed by the null character if `bufsz > 0`.
+ * @param[in] bufsz The size of @p out.
+ * @param[out] result The location to which the slice of the characters written to @p out will be
+ * written: the whole string, its first `bufsz - 1` characters if it has been truncated, or an
+ * empty slice if formatting has failed.
+ * @param[in] fmt The `printf`-like format string.
+ * @param[in] list The variadic function arguments reified into `va_list`.
+ *
+ * @return `true` if the whole string has been written, `false` if it has been truncated or
+ * formatting has failed.
+ *
+ * @pre `out != NULL || bufsz == 0`
+ * @pre `result != NULL`
+ * @pre `fmt != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_FORMAT_HINT_4_0 bool CharSlice99_try_vnfmt(
+    char out[restrict], size_t bufsz, CharSlice99 *restrict result, const char *restrict fmt,
+    va_list list) {
+    SLICE99_ASSERT(out || bufsz == 0);
+    SLICE99_ASSERT(result);
+    SLICE99_ASSERT(fmt);
+
+    const int len = SLICE99_VSNPRINTF(out, bufsz, fmt, list);
+    *result = slice99_priv_nfmt_result(out, bufsz, len);
+
+    SLICE99_PRIV_STATS_RECORD(
+        SLICE99_STATS_NFMT, result->len, false, len >= 0 && (size_t)len >= bufsz);
+
+    return len >= 0 && (size_t)len < bufsz;
+}
+
+/**
+ * The #CharSlice99_try_vnfmt twin.
+ *
+ * Defined only if `SLICE99_DISABLE_STDIO` is **not** defined.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_FORMAT_HINT_4_5 bool CharSlice99_try_nfmt(
+    char out[restrict], size_t bufsz, CharSlice99 *restrict result, const char *restrict fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    const bool ok = CharSlice99_try_vnfmt(out, bufsz, result, fmt, ap);
+    va_end(ap);
+    return ok;
+}
+
+/**
+ * Prints a formatted string to memory allocated from @p arena.
+ *
+ * The string is formatted in place if it fits into the remaining space of the current arena
+ * region; otherwise, it is formatted again into a freshly allocated chunk. The resulting slice is
+ * followed by the null character, so `out->ptr` is also a null-terminated string.
+ *
+ * Defined only if `SLICE99_DISABLE_STDIO` is **not** defined.
+ *
+ * @param[in,out] arena The arena to allocate from.
+ * @param[out] out The location to which the formatted character slice will be written.
+ * @param[in] fmt The `printf`-like format string.
+ * @param[in] list The variadic function arguments reified into `va_list`.
+ *
+ * @return `true` on success, `false` if the allocation or formatting has failed. In the latter
+ * case, @p out is left unchanged.
+ *
+ * @pre `arena != NULL`
+ * @pre `out != NULL`
+ * @pre `fmt != NULL`
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_FORMAT_HINT_3_0 bool CharSlice99_arena_vfmt(
+    Slice99Arena *restrict arena, CharSlice99 *restrict out, const char *restrict fmt,
+    va_list list) {
+    SLICE99_ASSERT(arena);
+    SLICE99_ASSERT(out);
+    SLICE99_ASSERT(fmt);
+
+    va_list list_copy;
+    va_copy(list_copy, list);
+
+    char *start = arena->ptr == NULL ? NULL : arena->ptr + arena->used;
+    const size_t available = arena->cap - arena->used;
+
+    const int len = SLICE99_VSNPRINTF(start, available, fmt, list);
+    if (len >= 0 && (size_t)len < available) {
+        arena->used += (size_t)len + 1;
+    } else if (len >= 0) {
+        start = (char *)Slice99Arena_alloc(arena, (size_t)len + 1, 1);
+        if (start != NULL) {
+            SLICE99_VSNPRINTF(start, (size_t)len + 1, fmt, list_copy);
+        }
+    }
+
+    va_end(list_copy);
+
+    const bool ok = len >= 0 && start != NULL;
+    SLICE99_PRIV_STATS_RECORD(SLICE99_STATS_FMT, ok ? (size_t)len : 0, false, false);
+    if (!ok) {
+        return false;
+    }
+
+    *out = CharSlice99_new(start, (size_t)len);
+    return true;
+}
+
+/**
+ * The #CharSlice99_arena_vfmt twin.
+ *
+ * Defined only if `SLICE99_DISABLE_STDIO` is **not** defined.
+ */
+inline static SLICE99_WARN_UNUSED_RESULT SLICE99_FORMAT_HINT_3_4 bool CharSlice99_arena_fmt(
+    Slice99Arena *restrict arena, CharSlice99 *restrict out, const char *restrict fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    const bool result = CharSlice99_arena_vfmt(arena, out, fmt, ap);
+    va_end(ap);
+    return result;
+}
+
+#if defined(UINT8_MAX) && defined(UINT16_MAX) && defined(UINT32_MAX) && defined(UINT64_MAX)
+
+/**
+ * Prints a formatted string to the remaining space of @p self.
+ *
+ * The string is formatted directly into the buffer of the writer in a single pass. Because
+ * #SLICE99_VSNPRINTF always terminates its output with the null character, one byte of the
+ * remaining space beyond the string is required; the null character itself is not counted as
+ * written. If the string does not fit or formatting fails, the writer becomes overflowed, and the
+ * bytes after the written ones may be clobbered.
+ *
+ * Defined only if `SLICE99_DISABLE_STDIO` is **not** defined and `uint8_t`, `uint16_t`,
+ * `uint32_t`, and `uint64_t` are available.
+ *
+ * @param[in,out] self The writer.
+ * @param[in] fmt The `printf`-like format string.
+ * @param[in] list The variadic function arguments reified into `va_list`.
+ *
+ * @return `true` if the string has been written, `false` if the writer is overflowed.
+ *
+ * @pre `self != NULL`
+ * @pre `fmt != NULL`
+ */
+inline static SLICE99_FORMAT_HINT_2_0 bool
+Slice99Writer_vfmt(Slice99Writer *restrict self, const char *restrict fmt, va_list list) {
+    SLICE99_ASSERT(self);
+    SLICE99_ASSERT(fmt);
+
+    if (self->overflowed) {
+        SLICE99_PRIV_STATS_RECORD(SLICE99_STATS_NFMT, 0, false, false);
+        return false;
+    }
+
+    const size_t remaining = Slice99Writer_remaining(*self);
+    const int len = SLICE99_VSNPRINTF((char *)self->cursor, remaining, fmt, list);
+    const bool fits = len >= 0 && (size_t)len < remaining;
+    SLICE99_PRIV_STATS_RECORD(SLICE99_STATS_NFMT, fits ? (size_t)len : 0, false, len >= 0 && !fits);
+    if (!fits) {
+        self->overflowed = true;
+        return false;
+    }
+
+    self->cursor += len;
+    return true;
+}
+
+/**
+ * The #Slice99Writer_vfmt twin.
+ *
+ * Defined only if `SLICE99_DISABLE_STDIO` is **not** defined and `uint8_t`, `uint16_t`,
+ * `uint32_t`, and `uint64_t` are available.
+ */
+inline static SLICE99_FORMAT_HINT_2_3 bool
+Slice99Writer_fmt(Slice99Writer *restrict self, const char *restrict fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    const bool result = Slice99Writer_vfmt(self, fmt, ap);
+    va_end(ap);
+    return result;
+}
+
+#endif // defined(UINT8_MAX) && defined(UINT16_MAX) && defined(UINT32_MAX) && defined(UINT64_MAX)
+
 #ifndef DOXYGEN_IGNORE
 
 #undef SLICE99_FORMAT_HINT_2_0
 #undef SLICE99_FORMAT_HINT_2_3
 #undef SLICE99_FORMAT_HINT_3_0
 #undef SLICE99_FORMAT_HINT_3_4
+#undef SLICE99_FORMAT_HINT_4_0
+#undef SLICE99_FORMAT_HINT_4_5
 
 #endif // DOXYGEN_IGNORE
 
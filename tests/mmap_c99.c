@@ -0,0 +1,23 @@
+// Compiled in the strict ISO C99 mode, where only the requested POSIX declarations are visible.
+#define _POSIX_C_SOURCE 200112L
+
+#define SLICE99_ENABLE_MMAP
+
+#include <slice99.h>
+
+#include <assert.h>
+#include <stdio.h>
+
+int main(void) {
+    U8Slice99 mapping;
+    assert(Slice99_mmap_file("/dev/null", SLICE99_MMAP_READ, &mapping));
+    assert(U8Slice99_is_empty(mapping));
+    assert(Slice99_munmap(SLICE99_TO_UNTYPED(mapping)));
+
+    Slice99Ring ring;
+    assert(Slice99Ring_new_mirrored(1, &ring));
+    assert(Slice99_madvise(Slice99_new(ring.ptr, 1, ring.cap), SLICE99_ADVICE_SEQUENTIAL));
+    assert(Slice99Ring_munmap(ring));
+
+    puts("The strict C99 build of the mmap module works!");
+}
@@ -1,7 +1,33 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define SLICE99_ENABLE_MMAP
+#define SLICE99_ENABLE_PARALLEL
+#define SLICE99_ENABLE_IOVEC
+#define SLICE99_ENABLE_STATS
+
+// The number of bytes reported to `SLICE99_STATS_HOOK` by the current thread, and the mismatches
+// and truncations of the last reported operation as seen by the hook (see `test_stats`).
+static __thread unsigned long long stats_hook_bytes, stats_hook_flagged;
+#define SLICE99_STATS_HOOK(op, bytes)                                                              \
+    (stats_hook_bytes += (bytes),                                                                  \
+     stats_hook_flagged = Slice99Stats_snapshot().ops[op].mismatches +                             \
+                          Slice99Stats_snapshot().ops[op].truncations)
+
+// Exercise the parallel code paths on small slices. A variable, so that `test_par` can lower it.
+static unsigned long par_threshold = 4096;
+#define SLICE99_PAR_THRESHOLD  par_threshold
+#define SLICE99_PAR_CHUNK_SIZE 1000
+
+// Exercise the non-temporal fill on small slices.
+#define SLICE99_STREAM_THRESHOLD 4096
+
 #include <slice99.h>
 
 #include <assert.h>
+#include <inttypes.h>
 #include <limits.h>
+#include <math.h>
+#include <sched.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -569,6 +595,149 @@ TEST(ends_with) {
 
 #undef ENDS_WITH
 
+TEST(primitive_find_item) {
+    {
+        Slice99 str = Slice99_from_str("hello world");
+
+        assert(Slice99_primitive_find_item(str, "o") == 4);
+        assert(Slice99_primitive_rfind_item(str, "o") == 7);
+        assert(Slice99_primitive_find_item(str, "z") == -1);
+        assert(Slice99_primitive_rfind_item(str, "z") == -1);
+        assert(Slice99_primitive_find_item(Slice99_empty(1), "a") == -1);
+        assert(Slice99_primitive_rfind_item(Slice99_empty(1), "a") == -1);
+    }
+
+    {
+        Slice99 data = Slice99_from_array((int[]){1, 2, 3, 2, 1});
+        const int two = 2, four = 4;
+
+        assert(Slice99_primitive_find_item(data, &two) == 1);
+        assert(Slice99_primitive_rfind_item(data, &two) == 3);
+        assert(Slice99_primitive_find_item(data, &four) == -1);
+        assert(Slice99_primitive_rfind_item(data, &four) == -1);
+    }
+
+    // Long inputs go through the vectorised paths.
+    {
+        char buffer[1000];
+        memset(buffer, 'a', sizeof buffer);
+        Slice99 slice = Slice99_from_array(buffer);
+
+        for (size_t i = 0; i < sizeof buffer; i += 37) {
+            buffer[i] = 'x';
+            assert(Slice99_primitive_find_item(slice, "x") == (ptrdiff_t)i);
+            assert(Slice99_primitive_rfind_item(slice, "x") == (ptrdiff_t)i);
+            buffer[i] = 'a';
+        }
+    }
+
+    // The unaligned bytes at both ends are scanned separately from the aligned blocks.
+    {
+        char buffer[64];
+        memset(buffer, 'a', sizeof buffer);
+
+        for (size_t start = 0; start < 16; start++) {
+            for (size_t len = 0; start + len <= sizeof buffer; len++) {
+                const Slice99 slice = Slice99_new(buffer + start, 1, len);
+                assert(Slice99_primitive_rfind_item(slice, "x") == -1);
+
+                for (size_t i = 0; i < len; i++) {
+                    buffer[start + i] = 'x';
+                    assert(Slice99_primitive_rfind_item(slice, "x") == (ptrdiff_t)i);
+                    buffer[start + i] = 'a';
+                }
+            }
+        }
+    }
+}
+
+TEST(primitive_find_basic) {
+    Slice99 str = Slice99_from_str("abcabcab");
+
+    assert(Slice99_primitive_find(str, Slice99_from_str("")) == 0);
+    assert(Slice99_primitive_rfind(str, Slice99_from_str("")) == 8);
+    assert(Slice99_primitive_find(str, Slice99_from_str("bca")) == 1);
+    assert(Slice99_primitive_rfind(str, Slice99_from_str("bca")) == 4);
+    assert(Slice99_primitive_find(str, Slice99_from_str("abcabcab")) == 0);
+    assert(Slice99_primitive_rfind(str, Slice99_from_str("abcabcab")) == 0);
+    assert(Slice99_primitive_find(str, Slice99_from_str("abcabcabc")) == -1);
+    assert(Slice99_primitive_rfind(str, Slice99_from_str("abcabcabc")) == -1);
+    assert(Slice99_primitive_find(str, Slice99_from_str("cc")) == -1);
+    assert(Slice99_primitive_rfind(str, Slice99_from_str("cc")) == -1);
+
+    // Occurrences must start at item boundaries.
+    {
+        uint16_t data[] = {0x0100, 0x0302, 0x0100};
+        uint16_t needle[] = {0x0302};
+        Slice99 misaligned = Slice99_from_array(data);
+
+        // In little-endian, the bytes are 00 01 02 03 00 01, so 01 02 is misaligned.
+        uint8_t bytes[] = {0x01, 0x02};
+        U8Slice99 octets = U8Slice99_new((uint8_t *)data, sizeof data);
+        if (octets.ptr[0] == 0x00) {
+            assert(U8Slice99_primitive_find(octets, U8Slice99_new(bytes, 2)) == 1);
+            assert(Slice99_primitive_find(misaligned, Slice99_new(bytes, 2, 1)) == -1);
+        }
+
+        assert(Slice99_primitive_find(misaligned, Slice99_from_array(needle)) == 1);
+        assert(Slice99_primitive_rfind(misaligned, Slice99_from_array(needle)) == 1);
+    }
+}
+
+static ptrdiff_t naive_find(Slice99 self, Slice99 needle, bool reverse) {
+    ptrdiff_t result = -1;
+
+    for (size_t i = 0; i + needle.len <= self.len; i++) {
+        if (Slice99_primitive_eq(
+                Slice99_sub(self, (ptrdiff_t)i, (ptrdiff_t)(i + needle.len)), needle)) {
+            result = (ptrdiff_t)i;
+            if (!reverse) {
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+TEST(primitive_find_random) {
+    char haystack[200], needle[5];
+
+    for (size_t i = 0; i < 1000; i++) {
+        const size_t haystack_len = (size_t)rand() % sizeof haystack,
+                     needle_len = 1 + (size_t)rand() % sizeof needle;
+
+        for (size_t j = 0; j < haystack_len; j++) {
+            haystack[j] = "ab"[rand() % 2];
+        }
+        for (size_t j = 0; j < needle_len; j++) {
+            needle[j] = "ab"[rand() % 2];
+        }
+
+        Slice99 h = Slice99_new(haystack, 1, haystack_len), n = Slice99_new(needle, 1, needle_len);
+        assert(Slice99_primitive_find(h, n) == naive_find(h, n, false));
+        assert(Slice99_primitive_rfind(h, n) == naive_find(h, n, true));
+    }
+}
+
+TEST(primitive_find) {
+    test_primitive_find_basic();
+    test_primitive_find_random();
+}
+
+TEST(find) {
+    Slice99 data = Slice99_from_array((int[]){1, 2, 3, 2, 3});
+    const int three = 3, four = 4;
+
+    assert(Slice99_find_item(data, &three, int_cmp) == 2);
+    assert(Slice99_find_item(data, &four, int_cmp) == -1);
+
+    assert(Slice99_find(data, Slice99_from_array((int[]){2, 3}), int_cmp) == 1);
+    assert(Slice99_find(data, Slice99_from_array((int[]){3, 3}), int_cmp) == -1);
+    assert(Slice99_find(data, Slice99_empty(sizeof(int)), int_cmp) == 0);
+    assert(Slice99_find(Slice99_empty(sizeof(int)), data, int_cmp) == -1);
+}
+
 TEST(copy) {
 #define CHECK_COPY                                                                                 \
     do {                                                                                           \
@@ -619,6 +788,82 @@ TEST(copy_non_overlapping) {
 }
 // clang-format on
 
+static bool is_filled(Slice99 self, const void *item) {
+    for (size_t i = 0; i < self.len; i++) {
+        if (memcmp(Slice99_get(self, (ptrdiff_t)i), item, self.item_size) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+TEST(fill) {
+    {
+        char data[] = "abcdefghij";
+        Slice99_fill(Slice99_from_str(data), "x");
+        assert(strcmp(data, "xxxxxxxxxx") == 0);
+
+        Slice99_memset(Slice99_new(data, 1, 3), 'y');
+        assert(strcmp(data, "yyyxxxxxxx") == 0);
+    }
+
+    // Items of odd sizes, including the same-byte ones.
+    {
+        unsigned char data[1000];
+        const unsigned char items[][5] = {{1, 2, 3, 4, 5}, {0, 0, 0, 0, 0}, {7, 7, 7, 7, 7}};
+
+        for (size_t i = 0; i < SLICE99_ARRAY_LEN(items); i++) {
+            for (size_t item_size = 1; item_size <= 5; item_size++) {
+                const Slice99 self = Slice99_new(data, item_size, sizeof data / item_size);
+                Slice99_fill(self, items[i]);
+                assert(is_filled(self, items[i]));
+            }
+        }
+    }
+
+    // The item may reside in the slice.
+    {
+        int data[] = {1, 2, 3, 4, 5};
+        Slice99_fill(Slice99_from_array(data), &data[3]);
+        assert(memcmp(data, (int[]){4, 4, 4, 4, 4}, sizeof data) == 0);
+    }
+
+    {
+        int data[] = {1, 2};
+        Slice99_fill(Slice99_new(data, sizeof data[0], 0), &(int){42});
+        assert(data[0] == 1 && data[1] == 2);
+    }
+
+    // Non-temporal stores, from every alignment and up to the very last byte.
+    {
+        const size_t size = 5 * SLICE99_STREAM_THRESHOLD;
+        unsigned char *buffer = malloc(size + 32);
+        assert(buffer);
+        const unsigned char item[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17};
+
+        for (size_t offset = 0; offset < 16; offset += 3) {
+            for (size_t item_size = 1; item_size <= sizeof item; item_size += 4) {
+                memset(buffer, 0xEE, size + 32);
+
+                const Slice99 self = Slice99_new(buffer + offset, item_size, size / item_size);
+                Slice99_fill(self, item);
+                assert(is_filled(self, item));
+
+                assert(offset == 0 || buffer[offset - 1] == 0xEE);
+                assert(buffer[offset + Slice99_size(self)] == 0xEE);
+            }
+        }
+
+        memset(buffer, 0xEE, size + 32);
+        Slice99_memset(Slice99_new(buffer + 1, 1, size), 0xAB);
+        assert(buffer[0] == 0xEE && buffer[size + 1] == 0xEE);
+        assert(is_filled(Slice99_new(buffer + 1, 1, size), &(unsigned char){0xAB}));
+
+        free(buffer);
+    }
+}
+
 TEST(swap) {
     int backup;
 
@@ -627,6 +872,22 @@ TEST(swap) {
     Slice99_swap(slice, 1, 3, &backup);
     assert(*(int *)Slice99_get(slice, 1) == 4);
     assert(*(int *)Slice99_get(slice, 3) == 2);
+
+    // Swapping an item with itself.
+    Slice99_swap(slice, 2, 2, &backup);
+    assert(*(int *)Slice99_get(slice, 2) == 3);
+
+    // `backup` is not needed for the fixed item sizes.
+    Slice99_swap(slice, 0, 4, NULL);
+    assert(*(int *)Slice99_get(slice, 0) == 5);
+    assert(*(int *)Slice99_get(slice, 4) == 1);
+
+    // A generic item size.
+    char chars[3][3] = {"ab", "cd", "ef"}, chars_backup[3];
+    Slice99 triples = Slice99_from_array(chars);
+    Slice99_swap(triples, 0, 2, chars_backup);
+    Slice99_swap(triples, 1, 1, chars_backup);
+    assert(memcmp(chars, "ef\0cd\0ab", sizeof chars) == 0);
 }
 
 TEST(swap_with_slice) {
@@ -678,9 +939,31 @@ TEST(reverse_involutive) {
     }
 }
 
+TEST(reverse_item_sizes) {
+    const size_t item_sizes[] = {1, 2, 3, 4, 8, 16, 24};
+
+    for (size_t i = 0; i < SLICE99_ARRAY_LEN(item_sizes); i++) {
+        const size_t item_size = item_sizes[i];
+
+        for (size_t len = 0; len < 40; len++) {
+            unsigned char data[40 * 24], expected[40 * 24], backup[24];
+            for (size_t j = 0; j < len * item_size; j++) {
+                data[j] = (unsigned char)rand();
+            }
+            for (size_t j = 0; j < len; j++) {
+                memcpy(expected + j * item_size, data + (len - j - 1) * item_size, item_size);
+            }
+
+            Slice99_reverse(Slice99_new(data, item_size, len), backup);
+            assert(memcmp(data, expected, len * item_size) == 0);
+        }
+    }
+}
+
 TEST(reverse) {
     test_reverse_basic();
     test_reverse_involutive();
+    test_reverse_item_sizes();
 }
 
 TEST(split_at_empty_slice) {
@@ -770,6 +1053,186 @@ TEST(split_at) {
     test_split_at_end();
 }
 
+TEST(align_to) {
+    uint64_t storage[16];
+    const size_t item_sizes[] = {1, 2, 3, 4, 8, 12}, body_item_sizes[] = {1, 3, 4, 8, 16};
+
+    for (size_t a = 0; a < SLICE99_ARRAY_LEN(item_sizes); a++) {
+        for (size_t b = 0; b < SLICE99_ARRAY_LEN(body_item_sizes); b++) {
+            for (size_t align = 1; align <= 16; align *= 2) {
+                for (size_t offset = 0; offset < 16; offset++) {
+                    const size_t item_size = item_sizes[a], body_item_size = body_item_sizes[b];
+                    const Slice99 self = Slice99_new(
+                        (char *)storage + offset, item_size, (sizeof storage - 16) / item_size);
+
+                    Slice99 head, body, tail;
+                    Slice99_align_to(self, align, body_item_size, &head, &body, &tail);
+
+                    // The parts cover `self` in order.
+                    assert(head.ptr == self.ptr && head.item_size == item_size);
+                    assert(body.ptr == Slice99_get(self, (ptrdiff_t)head.len));
+                    assert(body.item_size == body_item_size);
+                    assert(tail.item_size == item_size);
+                    assert((char *)tail.ptr == (char *)body.ptr + Slice99_size(body));
+                    assert(Slice99_size(head) + Slice99_size(body) + Slice99_size(tail) ==
+                           Slice99_size(self));
+                    assert(Slice99_size(body) % item_size == 0);
+
+                    // The head is as short as possible.
+                    for (size_t i = 0; i < head.len; i++) {
+                        assert((uintptr_t)Slice99_get(self, (ptrdiff_t)i) % align != 0);
+                    }
+                    if (head.len < self.len) {
+                        assert((uintptr_t)body.ptr % align == 0);
+                    }
+
+                    // The body is as long as possible: the tail is shorter than the least common
+                    // multiple of the item sizes.
+                    assert(head.len == self.len || Slice99_size(tail) < item_size * body_item_size);
+                }
+            }
+        }
+    }
+
+    // No item is aligned.
+    {
+        Slice99 head, body, tail;
+        Slice99_align_to(Slice99_new((char *)storage + 1, 2, 10), 2, 2, &head, &body, &tail);
+        assert(head.len == 10 && body.len == 0 && tail.len == 0);
+    }
+
+    {
+        U8Slice99 head, tail;
+        Slice99 body;
+        U8Slice99_align_to(
+            U8Slice99_new((uint8_t *)storage + 3, 27), sizeof(uint64_t), sizeof(uint64_t), &head,
+            &body, &tail);
+
+        const U64Slice99 words = (U64Slice99)SLICE99_TO_TYPED(body);
+        assert(head.len == 5 && words.len == 2 && tail.len == 6);
+        assert(words.ptr == &storage[1]);
+    }
+}
+
+static void check_split(Slice99SplitIter iter, const char *const expected[], size_t expected_len) {
+    Slice99 piece;
+
+    for (size_t i = 0; i < expected_len; i++) {
+        assert(Slice99SplitIter_next(&iter, &piece));
+        assert(Slice99_primitive_eq(piece, Slice99_from_str((char *)expected[i])));
+    }
+
+    assert(!Slice99SplitIter_next(&iter, &piece));
+    assert(!Slice99SplitIter_next(&iter, &piece));
+}
+
+#define CHECK_SPLIT(iter, ...)                                                                     \
+    do {                                                                                           \
+        const char *const expected[] = {__VA_ARGS__};                                              \
+        check_split(iter, expected, SLICE99_ARRAY_LEN(expected));                                  \
+    } while (0)
+
+TEST(split_iter_by_item) {
+    CHECK_SPLIT(Slice99SplitIter_by_item(Slice99_from_str("a,b,,c"), ","), "a", "b", "", "c");
+    CHECK_SPLIT(Slice99SplitIter_by_item(Slice99_from_str(",a,"), ","), "", "a", "");
+    CHECK_SPLIT(Slice99SplitIter_by_item(Slice99_from_str("abc"), ","), "abc");
+    CHECK_SPLIT(Slice99SplitIter_by_item(Slice99_from_str(""), ","), "");
+
+    {
+        Slice99SplitIter iter =
+            Slice99SplitIter_by_item(Slice99_from_array((int[]){1, 0, 2, 3, 0}), &(int){0});
+        Slice99 piece;
+
+        assert(Slice99SplitIter_next(&iter, &piece));
+        assert(Slice99_primitive_eq(piece, Slice99_from_array((int[]){1})));
+        assert(Slice99SplitIter_next(&iter, &piece));
+        assert(Slice99_primitive_eq(piece, Slice99_from_array((int[]){2, 3})));
+        assert(Slice99SplitIter_next(&iter, &piece));
+        assert(Slice99_is_empty(piece));
+        assert(!Slice99SplitIter_next(&iter, &piece));
+    }
+}
+
+TEST(split_iter_by_slice) {
+    CHECK_SPLIT(
+        Slice99SplitIter_by_slice(Slice99_from_str("a\r\nb\r\n\r\n"), Slice99_from_str("\r\n")),
+        "a", "b", "", "");
+    CHECK_SPLIT(
+        Slice99SplitIter_by_slice(Slice99_from_str("a::b:c"), Slice99_from_str("::")), "a", "b:c");
+    CHECK_SPLIT(
+        Slice99SplitIter_by_slice(Slice99_from_str("a-b"), Slice99_from_str("-")), "a", "b");
+}
+
+TEST(split_iter_by_any) {
+    CHECK_SPLIT(
+        Slice99SplitIter_by_any(Slice99_from_str("a b\tc\t\td"), Slice99_from_str(" \t")), "a", "b",
+        "c", "", "d");
+    CHECK_SPLIT(Slice99SplitIter_by_any(Slice99_from_str("abc"), Slice99_from_str("")), "abc");
+    CHECK_SPLIT(Slice99SplitIter_by_any(Slice99_from_str("a;b"), Slice99_from_str(";")), "a", "b");
+
+    {
+        Slice99SplitIter iter = Slice99SplitIter_by_any(
+            Slice99_from_array((int[]){1, 5, 2, 6, 3}), Slice99_from_array((int[]){6, 5}));
+        Slice99 piece;
+
+        for (int i = 1; i <= 3; i++) {
+            assert(Slice99SplitIter_next(&iter, &piece));
+            assert(Slice99_primitive_eq(piece, Slice99_new(&i, sizeof i, 1)));
+        }
+        assert(!Slice99SplitIter_next(&iter, &piece));
+    }
+
+    // Every byte at every position relative to the 16-byte blocks of the vectorized code path.
+    {
+        unsigned char set[] = {0x00, 0x0F, 0x7F, 0x80, 0xF0, 0xFF, 0xA5, ' ', ','};
+        unsigned char buffer[48];
+
+        for (int byte = 0; byte < 256; byte++) {
+            const bool member = memchr(set, byte, sizeof set) != NULL;
+
+            for (size_t pos = 0; pos < sizeof buffer; pos++) {
+                memset(buffer, 'x', sizeof buffer);
+                buffer[pos] = (unsigned char)byte;
+
+                Slice99SplitIter iter = Slice99SplitIter_by_any(
+                    Slice99_from_array(buffer), Slice99_from_array(set));
+                Slice99 piece;
+                assert(Slice99SplitIter_next(&iter, &piece));
+                assert(piece.len == (member ? pos : sizeof buffer));
+            }
+        }
+    }
+}
+
+TEST(split_iter_typed) {
+    CharSlice99SplitIter iter =
+        CharSlice99SplitIter_by_item(CharSlice99_from_str("key: value"), &(char){':'});
+    CharSlice99 piece;
+
+    assert(CharSlice99SplitIter_next(&iter, &piece));
+    assert(CharSlice99_primitive_eq(piece, CharSlice99_from_str("key")));
+    assert(CharSlice99SplitIter_next(&iter, &piece));
+    assert(CharSlice99_primitive_eq(piece, CharSlice99_from_str(" value")));
+    assert(!CharSlice99SplitIter_next(&iter, &piece));
+
+    iter = CharSlice99SplitIter_by_slice(CharSlice99_from_str("1, 2"), CharSlice99_from_str(", "));
+    assert(CharSlice99SplitIter_next(&iter, &piece));
+    assert(CharSlice99_primitive_eq(piece, CharSlice99_from_str("1")));
+
+    iter = CharSlice99SplitIter_by_any(CharSlice99_from_str("1;2"), CharSlice99_from_str(",;"));
+    assert(CharSlice99SplitIter_next(&iter, &piece));
+    assert(CharSlice99_primitive_eq(piece, CharSlice99_from_str("1")));
+}
+
+#undef CHECK_SPLIT
+
+TEST(split_iter) {
+    test_split_iter_by_item();
+    test_split_iter_by_slice();
+    test_split_iter_by_any();
+    test_split_iter_typed();
+}
+
 TEST(to_c_str) {
     {
         Slice99 slice = Slice99_from_array((char[]){'a', 'b', 'c'});
@@ -784,6 +1247,443 @@ TEST(to_c_str) {
     }
 }
 
+TEST(strided) {
+    int data[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    const Slice99Strided all = Slice99Strided_from_slice(Slice99_from_array(data));
+
+    assert(all.len == 10);
+    assert(all.stride == (ptrdiff_t)sizeof(int));
+    assert(Slice99Strided_is_contiguous(all));
+    assert(Slice99_primitive_eq(Slice99Strided_to_slice(all), Slice99_from_array(data)));
+
+    // Sub and step.
+    {
+        const Slice99Strided even = Slice99Strided_step_by(all, 2);
+        assert(even.len == 5);
+        assert(!Slice99Strided_is_contiguous(even));
+        for (ptrdiff_t i = 0; i < 5; i++) {
+            assert(*(int *)Slice99Strided_get(even, i) == 2 * i);
+        }
+
+        const Slice99Strided sub = Slice99Strided_sub(even, 1, 4);
+        assert(sub.len == 3);
+        assert(*(int *)Slice99Strided_get(sub, 0) == 2);
+        assert(*(int *)Slice99Strided_get(sub, 2) == 6);
+        assert(*(int *)Slice99Strided_get(sub, -1) == 0);
+
+        assert(Slice99Strided_step_by(all, 3).len == 4);
+        assert(Slice99Strided_step_by(all, 10).len == 1);
+        assert(Slice99Strided_step_by(Slice99Strided_sub(all, 0, 0), 3).len == 0);
+        assert(Slice99Strided_is_contiguous(Slice99Strided_step_by(all, 10)));
+    }
+
+    // A negative stride.
+    {
+        const Slice99Strided reversed =
+            Slice99Strided_new(&data[9], sizeof(int), -(ptrdiff_t)sizeof(int), 10);
+        assert(!Slice99Strided_is_contiguous(reversed));
+        assert(*(int *)Slice99Strided_get(reversed, 0) == 9);
+        assert(*(int *)Slice99Strided_get(reversed, 9) == 0);
+    }
+
+    // Struct fields.
+    {
+        typedef struct {
+            char tag;
+            double value;
+        } Item;
+
+        Item items[] = {{'a', 1.5}, {'b', 2.5}, {'c', 3.5}};
+        const Slice99Strided values = SLICE99_FIELD(Slice99_from_array(items), Item, value);
+        const Slice99Strided tags = SLICE99_FIELD(Slice99_from_array(items), Item, tag);
+
+        assert(values.len == 3 && values.item_size == sizeof(double));
+        assert(values.stride == (ptrdiff_t)sizeof(Item));
+        assert(*(double *)Slice99Strided_get(values, 2) == 3.5);
+        assert(*(char *)Slice99Strided_get(tags, 1) == 'b');
+
+        double packed[3];
+        Slice99Strided_copy(Slice99Strided_from_slice(Slice99_from_array(packed)), values);
+        assert(packed[0] == 1.5 && packed[1] == 2.5 && packed[2] == 3.5);
+        assert(Slice99Strided_primitive_eq(
+            Slice99Strided_from_slice(Slice99_from_array(packed)), values));
+
+        packed[1] = 0.0;
+        assert(!Slice99Strided_primitive_eq(
+            Slice99Strided_from_slice(Slice99_from_array(packed)), values));
+        assert(!Slice99Strided_primitive_eq(values, Slice99Strided_sub(values, 0, 2)));
+        assert(!Slice99Strided_primitive_eq(values, tags));
+    }
+
+    // The contiguous copy may overlap.
+    {
+        int buffer[] = {1, 2, 3, 4, 5};
+        const Slice99Strided s = Slice99Strided_from_slice(Slice99_from_array(buffer));
+        Slice99Strided_copy(Slice99Strided_sub(s, 1, 5), Slice99Strided_sub(s, 0, 4));
+        assert(memcmp(buffer, (int[]){1, 1, 2, 3, 4}, sizeof buffer) == 0);
+    }
+
+    // Every item size, to exercise the dispatch.
+    for (size_t item_size = 1; item_size <= 12; item_size++) {
+        unsigned char src[12 * 8], dst[12 * 4];
+        for (size_t i = 0; i < sizeof src; i++) {
+            src[i] = (unsigned char)i;
+        }
+        memset(dst, 0, sizeof dst);
+
+        const Slice99Strided every_other =
+            Slice99Strided_new(src, item_size, (ptrdiff_t)(2 * item_size), 4);
+        const Slice99Strided packed = Slice99Strided_new(dst, item_size, (ptrdiff_t)item_size, 4);
+
+        Slice99Strided_copy(packed, every_other);
+        assert(Slice99Strided_primitive_eq(packed, every_other));
+        for (size_t i = 0; i < 4; i++) {
+            assert(memcmp(dst + i * item_size, src + 2 * i * item_size, item_size) == 0);
+        }
+
+        dst[3 * item_size + item_size - 1] ^= 1;
+        assert(!Slice99Strided_primitive_eq(packed, every_other));
+    }
+}
+
+TEST(matrix) {
+    int data[] = {
+        1, 2, 3, 4,    //
+        5, 6, 7, 8,    //
+        9, 10, 11, 12, //
+    };
+    const Slice99Matrix m = Slice99Matrix_from_slice(Slice99_from_array(data), 4);
+
+    assert(m.rows == 3 && m.cols == 4);
+    assert(m.row_stride == 4 * sizeof(int));
+    assert(Slice99Matrix_is_contiguous(m));
+    assert(*(int *)Slice99Matrix_get(m, 0, 0) == 1);
+    assert(*(int *)Slice99Matrix_get(m, 2, 3) == 12);
+
+    const Slice99 row = Slice99Matrix_row(m, 1);
+    assert(Slice99_primitive_eq(row, Slice99_from_array((int[]){5, 6, 7, 8})));
+
+    const Slice99Strided col = Slice99Matrix_col(m, 2);
+    assert(col.len == 3);
+    assert(*(int *)Slice99Strided_get(col, 0) == 3);
+    assert(*(int *)Slice99Strided_get(col, 1) == 7);
+    assert(*(int *)Slice99Strided_get(col, 2) == 11);
+
+    // A submatrix has padding between its rows.
+    const Slice99Matrix sub = Slice99Matrix_sub(m, 1, 3, 1, 3);
+    assert(sub.rows == 2 && sub.cols == 2);
+    assert(!Slice99Matrix_is_contiguous(sub));
+    assert(*(int *)Slice99Matrix_get(sub, 0, 0) == 6);
+    assert(*(int *)Slice99Matrix_get(sub, 1, 1) == 11);
+    assert(Slice99Matrix_is_contiguous(Slice99Matrix_sub(m, 1, 2, 1, 3)));
+    assert(Slice99Matrix_is_contiguous(Slice99Matrix_sub(m, 1, 3, 0, 4)));
+
+    // Copying and comparing.
+    {
+        int packed[4];
+        const Slice99Matrix dst = Slice99Matrix_new(packed, sizeof(int), 2, 2);
+        Slice99Matrix_copy(dst, sub);
+        assert(memcmp(packed, (int[]){6, 7, 10, 11}, sizeof packed) == 0);
+        assert(Slice99Matrix_primitive_eq(dst, sub));
+        assert(!Slice99Matrix_primitive_eq(dst, Slice99Matrix_sub(m, 0, 2, 0, 2)));
+        assert(!Slice99Matrix_primitive_eq(dst, Slice99Matrix_sub(m, 0, 1, 0, 4)));
+
+        int copy[12];
+        const Slice99Matrix whole = Slice99Matrix_new(copy, sizeof(int), 3, 4);
+        Slice99Matrix_copy(whole, m);
+        assert(Slice99Matrix_primitive_eq(whole, m));
+
+        Slice99Matrix_copy(Slice99Matrix_sub(whole, 1, 3, 2, 4), dst);
+        assert(memcmp(copy, (int[]){1, 2, 3, 4, 5, 6, 6, 7, 9, 10, 10, 11}, sizeof copy) == 0);
+    }
+
+    // An explicit row stride.
+    {
+        int padded[] = {1, 2, -1, 3, 4, -1};
+        const Slice99Matrix p =
+            Slice99Matrix_with_stride(padded, sizeof(int), 2, 2, 3 * sizeof(int));
+        assert(*(int *)Slice99Matrix_get(p, 1, 0) == 3);
+        assert(Slice99Matrix_primitive_eq(
+            p, Slice99Matrix_from_slice(Slice99_from_array((int[]){1, 2, 3, 4}), 2)));
+    }
+}
+
+TEST(gather_scatter) {
+    // Struct fields.
+    {
+        typedef struct {
+            uint8_t tag;
+            uint16_t count;
+            uint32_t id;
+            double value;
+            char name[3];
+        } Record;
+
+        Record records[7];
+        for (size_t i = 0; i < SLICE99_ARRAY_LEN(records); i++) {
+            records[i].tag = (uint8_t)i;
+            records[i].count = (uint16_t)(100 + i);
+            records[i].id = (uint32_t)(1000 + i);
+            records[i].value = (double)i / 2;
+            memcpy(records[i].name, (char[]){'a', (char)('a' + i), 'z'}, 3);
+        }
+
+        const Slice99 self = Slice99_from_array(records);
+        uint8_t tags[7];
+        uint16_t counts[7];
+        uint32_t ids[8];
+        double values[7];
+        char names[7][3];
+
+        Slice99Strided_gather(SLICE99_FIELD(self, Record, tag), Slice99_from_array(tags));
+        Slice99Strided_gather(SLICE99_FIELD(self, Record, count), Slice99_from_array(counts));
+        Slice99Strided_gather(SLICE99_FIELD(self, Record, id), Slice99_from_array(ids));
+        Slice99Strided_gather(SLICE99_FIELD(self, Record, value), Slice99_from_array(values));
+        Slice99Strided_gather(SLICE99_FIELD(self, Record, name), Slice99_from_array(names));
+
+        for (size_t i = 0; i < SLICE99_ARRAY_LEN(records); i++) {
+            assert(tags[i] == i);
+            assert(counts[i] == 100 + i);
+            assert(ids[i] == 1000 + i);
+            assert(values[i] == (double)i / 2);
+            assert(memcmp(names[i], records[i].name, 3) == 0);
+
+            ids[i] *= 2;
+            names[i][2] = 'y';
+        }
+
+        Slice99Strided_scatter(SLICE99_FIELD(self, Record, id), Slice99_from_array(ids));
+        Slice99Strided_scatter(SLICE99_FIELD(self, Record, name), Slice99_from_array(names));
+
+        for (size_t i = 0; i < SLICE99_ARRAY_LEN(records); i++) {
+            assert(records[i].id == 2 * (1000 + i));
+            assert(records[i].name[2] == 'y');
+            assert(records[i].count == 100 + i);
+        }
+    }
+
+    // By indices, for every item size and a length with a remainder after unrolling.
+    for (size_t item_size = 1; item_size <= 12; item_size++) {
+        unsigned char data[12 * 10], out[12 * 7], back[12 * 10];
+        uint32_t indices[] = {9, 0, 3, 3, 7, 1, 8};
+
+        for (size_t i = 0; i < sizeof data; i++) {
+            data[i] = (unsigned char)i;
+        }
+
+        const Slice99 self = Slice99_new(data, item_size, 10);
+        const U32Slice99 idx = (U32Slice99)Slice99_typed_from_array(indices);
+
+        Slice99_gather(self, idx, Slice99_new(out, item_size, 7));
+        for (size_t i = 0; i < 7; i++) {
+            assert(memcmp(out + i * item_size, Slice99_get(self, indices[i]), item_size) == 0);
+        }
+
+        const unsigned char zeros[12] = {0};
+        memset(back, 0, sizeof back);
+        Slice99_scatter(Slice99_new(back, item_size, 10), idx, Slice99_new(out, item_size, 7));
+        for (size_t i = 0; i < 10; i++) {
+            const bool scattered = i != 2 && i != 4 && i != 5 && i != 6;
+            const unsigned char *expected = scattered ? data + i * item_size : zeros;
+            assert(memcmp(back + i * item_size, expected, item_size) == 0);
+        }
+    }
+
+    // The last occurrence of a repeated index wins.
+    {
+        int self[2] = {0, 0};
+        uint32_t indices[] = {1, 0, 1};
+        Slice99_scatter(
+            Slice99_from_array(self), (U32Slice99)Slice99_typed_from_array(indices),
+            Slice99_from_array((int[]){1, 2, 3}));
+        assert(self[0] == 2 && self[1] == 3);
+    }
+
+    // Empty indices.
+    {
+        int self[1] = {5};
+        Slice99_gather(Slice99_from_array(self), U32Slice99_empty(), Slice99_empty(sizeof(int)));
+        Slice99_scatter(Slice99_from_array(self), U32Slice99_empty(), Slice99_empty(sizeof(int)));
+        assert(self[0] == 5);
+    }
+}
+
+TEST(chain) {
+    // The chunks are consecutive parts of `data`, so the chain must behave exactly as `data`.
+    int data[40];
+    for (int i = 0; i < 40; i++) {
+        data[i] = i;
+    }
+    const Slice99 flat = Slice99_from_array(data);
+    const size_t lens[] = {1, 7, 0, 3, 16, 2, 11};
+
+    // The empty slice does not take a chunk.
+    Slice99ChainChunk buffer[SLICE99_ARRAY_LEN(lens) - 1];
+    Slice99Chain chain = Slice99Chain_new(buffer, SLICE99_ARRAY_LEN(buffer), sizeof(int));
+    assert(chain.len == 0 && Slice99Chain_primitive_eq(chain, Slice99_empty(sizeof(int))));
+
+    for (size_t i = 0, start = 0; i < SLICE99_ARRAY_LEN(lens); start += lens[i++]) {
+        assert(Slice99Chain_push(
+            &chain, Slice99_sub(flat, (ptrdiff_t)start, (ptrdiff_t)(start + lens[i]))));
+    }
+
+    assert(chain.count == SLICE99_ARRAY_LEN(buffer));
+    assert(chain.len == 40 && Slice99Chain_size(chain) == sizeof data);
+    assert(!Slice99Chain_push(&chain, Slice99_sub(flat, 0, 1)));
+    assert(Slice99Chain_push(&chain, Slice99_sub(flat, 0, 0)));
+
+    for (size_t i = 0; i < chain.len; i++) {
+        assert(Slice99Chain_get(chain, i) == &data[i]);
+    }
+
+    for (size_t start = 0; start <= chain.len; start++) {
+        for (size_t end = start; end <= chain.len; end++) {
+            Slice99Chain sub = Slice99Chain_sub(chain, start, end);
+            const Slice99 expected = Slice99_sub(flat, (ptrdiff_t)start, (ptrdiff_t)end);
+
+            assert(sub.len == end - start);
+            assert(Slice99Chain_primitive_eq(sub, expected));
+            assert(!Slice99Chain_push(&sub, Slice99_sub(flat, 0, 1)));
+
+            // The pieces are contiguous and non-empty.
+            size_t cursor = 0, total = 0;
+            Slice99 piece;
+            while (Slice99Chain_next(sub, &cursor, &piece)) {
+                assert(piece.len > 0);
+                assert(piece.ptr == Slice99_get(expected, (ptrdiff_t)total));
+                total += piece.len;
+            }
+            assert(total == sub.len);
+
+            if (sub.len > 0) {
+                assert(Slice99Chain_get(sub, 0) == expected.ptr);
+                assert(Slice99Chain_get(sub, sub.len - 1) == Slice99_last(expected));
+
+                // Subslicing a view.
+                const Slice99Chain inner = Slice99Chain_sub(sub, 1 % sub.len, sub.len);
+                assert(Slice99Chain_primitive_eq(
+                    inner, Slice99_advance(expected, (ptrdiff_t)(1 % sub.len))));
+            }
+        }
+    }
+
+    assert(!Slice99Chain_primitive_eq(chain, Slice99_sub(flat, 0, 39)));
+    assert(!Slice99Chain_primitive_eq(chain, Slice99_from_array((int[40]){0})));
+
+    int flattened[41];
+    const Slice99 result = Slice99Chain_flatten_into(chain, Slice99_from_array(flattened));
+    assert(result.ptr == flattened && Slice99_primitive_eq(result, flat));
+}
+
+TEST(arena_alloc) {
+    char buffer[64];
+    Slice99Arena arena = Slice99Arena_new(buffer, sizeof buffer);
+
+    // From the caller-provided buffer.
+    {
+        char *x = Slice99Arena_alloc(&arena, 3, 1);
+        int *y = Slice99Arena_alloc(&arena, sizeof(int), sizeof(int));
+
+        assert(x == buffer);
+        assert((char *)y >= buffer + 3 && (char *)y < buffer + sizeof buffer);
+        assert((uintptr_t)y % sizeof(int) == 0);
+    }
+
+    // Growth.
+    {
+        char *big = Slice99Arena_alloc(&arena, 10000, 8);
+        assert(big != NULL);
+        assert(big < buffer || big >= buffer + sizeof buffer);
+        assert((uintptr_t)big % 8 == 0);
+        memset(big, 'x', 10000);
+
+        for (size_t i = 0; i < 100; i++) {
+            char *small = Slice99Arena_alloc(&arena, 100, 1);
+            assert(small != NULL);
+            memset(small, 'y', 100);
+        }
+    }
+
+    // Resetting retains the biggest chunk.
+    {
+        Slice99Arena_reset(&arena);
+        assert(arena.chunks != NULL && arena.chunks->prev == NULL);
+
+        char *x = Slice99Arena_alloc(&arena, 100, 1);
+        assert(x == (char *)(arena.chunks + 1));
+    }
+
+    Slice99Arena_free(&arena);
+    assert(arena.chunks == NULL);
+    assert(Slice99Arena_alloc(&arena, 1, 1) == buffer);
+    Slice99Arena_free(&arena);
+
+    // Without a caller-provided buffer.
+    {
+        Slice99Arena heap = Slice99Arena_new(NULL, 0);
+        assert(Slice99Arena_alloc(&heap, 0, 1) != NULL);
+        Slice99Arena_reset(&heap);
+        Slice99Arena_free(&heap);
+    }
+}
+
+TEST(arena_dup) {
+    Slice99Arena arena = Slice99Arena_new(NULL, 0);
+
+    {
+        Slice99 data = Slice99_from_array((int[]){1, 2, 3}), copy;
+        assert(Slice99_arena_dup(data, &arena, &copy));
+        assert(copy.ptr != data.ptr);
+        assert((uintptr_t)copy.ptr % sizeof(int) == 0);
+        assert(Slice99_primitive_eq(copy, data));
+    }
+
+    {
+        Slice99 copy;
+        assert(Slice99_arena_dup(Slice99_empty(1), &arena, &copy));
+        assert(Slice99_is_empty(copy));
+    }
+
+    {
+        IntSlice99 data = (IntSlice99)Slice99_typed_from_array((int[]){4, 5}), copy;
+        assert(IntSlice99_arena_dup(data, &arena, &copy));
+        assert(copy.ptr != data.ptr);
+        assert(IntSlice99_primitive_eq(copy, data));
+    }
+
+    {
+        char *str = CharSlice99_arena_c_str(CharSlice99_from_str("abc"), &arena);
+        assert(strcmp(str, "abc") == 0);
+    }
+
+    Slice99Arena_free(&arena);
+}
+
+TEST(arena_fmt) {
+    char buffer[16];
+    Slice99Arena arena = Slice99Arena_new(buffer, sizeof buffer);
+    CharSlice99 result;
+
+    // Fits into the buffer.
+    assert(CharSlice99_arena_fmt(&arena, &result, "%d-%s", 42, "abc"));
+    assert(result.ptr == buffer);
+    assert(CharSlice99_primitive_eq(result, CharSlice99_from_str("42-abc")));
+    assert(result.ptr[result.len] == '\0');
+
+    // Does not fit.
+    assert(CharSlice99_arena_fmt(&arena, &result, "%s %s", "hello", "world"));
+    assert(CharSlice99_primitive_eq(result, CharSlice99_from_str("hello world")));
+    assert(result.ptr[result.len] == '\0');
+
+    Slice99Arena_free(&arena);
+}
+
+TEST(arena) {
+    test_arena_alloc();
+    test_arena_dup();
+    test_arena_fmt();
+}
+
 typedef struct {
     int x, y;
 } Point;
@@ -820,6 +1720,16 @@ TEST(def_typed) {
     TYPECHECK(
         MyPoints_ends_with, bool (*_)(MyPoints, MyPoints, int (*)(const Point *, const Point *)));
 
+    TYPECHECK(MyPoints_primitive_find_item, ptrdiff_t(*_)(MyPoints, const Point *));
+    TYPECHECK(MyPoints_primitive_rfind_item, ptrdiff_t(*_)(MyPoints, const Point *));
+    TYPECHECK(MyPoints_primitive_find, ptrdiff_t(*_)(MyPoints, MyPoints));
+    TYPECHECK(MyPoints_primitive_rfind, ptrdiff_t(*_)(MyPoints, MyPoints));
+    TYPECHECK(
+        MyPoints_find_item,
+        ptrdiff_t(*_)(MyPoints, const Point *, int (*)(const Point *, const Point *)));
+    TYPECHECK(
+        MyPoints_find, ptrdiff_t(*_)(MyPoints, MyPoints, int (*)(const Point *, const Point *)));
+
     TYPECHECK(MyPoints_copy, void (*_)(MyPoints, MyPoints));
     TYPECHECK(MyPoints_copy_non_overlapping, void (*_)(MyPoints, MyPoints));
     TYPECHECK(MyPoints_swap, void (*_)(MyPoints, ptrdiff_t, ptrdiff_t, Point *restrict));
@@ -838,69 +1748,2070 @@ TEST(def_typed) {
     }
 }
 
-TEST(fundamentals) {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-result"
+#define POINT_CMP(lhs, rhs) ((lhs)->x != (rhs)->x || (lhs)->y != (rhs)->y)
+#define INT_CMP(lhs, rhs)   (*(lhs) != *(rhs))
 
-    (void)CharSlice99_new((char[]){'a', 'b', 'c'}, 3);
-    (void)SCharSlice99_new((signed char[]){'a', 'b', 'c'}, 3);
-    (void)UCharSlice99_new((unsigned char[]){'a', 'b', 'c'}, 3);
+SLICE99_DEF_TYPED_EQ(MyPoints, Point, POINT_CMP);
+SLICE99_DEF_TYPED_EQ(IntSlice99, int, INT_CMP);
 
-    (void)ShortSlice99_new((short[]){1, 2, 3}, 3);
-    (void)UShortSlice99_new((unsigned short[]){1, 2, 3}, 3);
+#undef POINT_CMP
+#undef INT_CMP
 
-    (void)IntSlice99_new((int[]){1, 2, 3}, 3);
-    (void)UIntSlice99_new((unsigned int[]){1, 2, 3}, 3);
+TEST(def_typed_eq) {
+    {
+        MyPoints points = (MyPoints)Slice99_typed_from_array((Point[]){{1, 2}, {3, 4}, {5, 6}}),
+                 other = (MyPoints)Slice99_typed_from_array((Point[]){{1, 2}, {3, 4}, {5, 7}});
 
-    (void)LongSlice99_new((long[]){1, 2, 3}, 3);
-    (void)ULongSlice99_new((unsigned long[]){1, 2, 3}, 3);
-    (void)LongLongSlice99_new((long long[]){1, 2, 3}, 3);
-    (void)ULongLongSlice99_new((unsigned long long[]){1, 2, 3}, 3);
+        assert(MyPoints_eq_inline(points, points));
+        assert(!MyPoints_eq_inline(points, other));
+        assert(!MyPoints_eq_inline(points, MyPoints_sub(points, 0, 2)));
 
-    (void)FloatSlice99_new((float[]){1, 2, 3}, 3);
-    (void)DoubleSlice99_new((double[]){1, 2, 3}, 3);
-    (void)LongDoubleSlice99_new((long double[]){1, 2, 3}, 3);
+        assert(MyPoints_starts_with_inline(points, MyPoints_sub(other, 0, 2)));
+        assert(!MyPoints_starts_with_inline(points, other));
+        assert(MyPoints_ends_with_inline(points, MyPoints_sub(points, 1, 3)));
+        assert(!MyPoints_ends_with_inline(points, MyPoints_sub(other, 1, 3)));
+    }
 
-    (void)BoolSlice99_new((_Bool[]){1, 2, 3}, 3);
+    // Exercise both the chunked and the remainder loops.
+    for (size_t len = 0; len < 40; len++) {
+        int lhs[40], rhs[40];
+        for (size_t i = 0; i < len; i++) {
+            lhs[i] = rhs[i] = rand();
+        }
+
+        IntSlice99 x = IntSlice99_new(lhs, len), y = IntSlice99_new(rhs, len);
+        assert(IntSlice99_eq_inline(x, y));
+
+        for (size_t i = 0; i < len; i++) {
+            rhs[i]++;
+            assert(!IntSlice99_eq_inline(x, y));
+            assert(IntSlice99_starts_with_inline(x, IntSlice99_sub(y, 0, (ptrdiff_t)i)));
+            assert(
+                !IntSlice99_ends_with_inline(x, IntSlice99_sub(y, (ptrdiff_t)i, (ptrdiff_t)len)));
+            rhs[i]--;
+        }
+    }
+}
 
-    (void)U8Slice99_new((uint8_t[]){1, 2, 3}, 3);
-    (void)U16Slice99_new((uint16_t[]){1, 2, 3}, 3);
-    (void)U32Slice99_new((uint32_t[]){1, 2, 3}, 3);
-    (void)U64Slice99_new((uint64_t[]){1, 2, 3}, 3);
+SLICE99_DEF_VEC(IntSlice99, int);
+SLICE99_DEF_VEC(MyPoints, Point);
 
-    (void)I8Slice99_new((int8_t[]){1, 2, 3}, 3);
-    (void)I16Slice99_new((int16_t[]){1, 2, 3}, 3);
-    (void)I32Slice99_new((int32_t[]){1, 2, 3}, 3);
-    (void)I64Slice99_new((int64_t[]){1, 2, 3}, 3);
+TEST(vec) {
+    {
+        IntSlice99Vec vec = IntSlice99Vec_new();
+        assert(vec.ptr == NULL && vec.len == 0 && vec.cap == 0);
+        assert(IntSlice99_is_empty(IntSlice99Vec_as_slice(vec)));
+
+        for (int i = 0; i < 1000; i++) {
+            assert(IntSlice99Vec_push(&vec, i));
+            assert(vec.len <= vec.cap);
+        }
+
+        const IntSlice99 items = IntSlice99Vec_as_slice(vec);
+        assert(items.ptr == vec.ptr);
+        assert(items.len == 1000);
+        for (int i = 0; i < 1000; i++) {
+            assert(*IntSlice99_get(items, i) == i);
+        }
+
+        assert(IntSlice99Vec_shrink_to_fit(&vec));
+        assert(vec.cap == vec.len);
+
+        IntSlice99Vec_clear(&vec);
+        assert(vec.len == 0 && vec.cap == 1000);
+        assert(IntSlice99Vec_shrink_to_fit(&vec));
+        assert(vec.ptr == NULL && vec.cap == 0);
+
+        IntSlice99Vec_free(&vec);
+    }
 
-#pragma GCC diagnostic pop
-}
+    {
+        MyPoints pts = (MyPoints)Slice99_typed_from_array((Point[]){{1, 2}, {3, 4}, {5, 6}});
 
-TEST(to_typed) {
-    char *str = "abc";
-    const Slice99 x = Slice99_from_str(str);
-    CharSlice99 y = (CharSlice99)SLICE99_TO_TYPED(x);
+        MyPointsVec vec = MyPointsVec_new();
+        assert(MyPointsVec_reserve(&vec, 10));
+        assert(vec.cap >= 10);
+        Point *ptr = vec.ptr;
 
-    assert(x.ptr == y.ptr);
-    assert(x.len == y.len);
-}
+        assert(MyPointsVec_extend_from_slice(&vec, pts));
+        assert(MyPointsVec_extend_from_slice(&vec, MyPoints_empty()));
+        assert(MyPointsVec_push(&vec, (Point){7, 8}));
+        assert(vec.ptr == ptr);
+        assert(vec.len == 4);
 
-TEST(to_untyped) {
-    // clang-format off
-    char *str = "abc";
-    ASSERT_SLICE(
-        SLICE99_TO_UNTYPED(CharSlice99_from_str(str)),
-        PTR str,
-        ITEM_SIZE sizeof str[0],
-        LEN strlen(str)
-    );
-    // clang-format on
-}
+        const MyPoints items = MyPointsVec_as_slice(vec);
+        assert(MyPoints_starts_with_inline(items, pts));
+        assert(MyPoints_last(items)->x == 7 && MyPoints_last(items)->y == 8);
 
-TEST(fmt) {
-    char *expected = "123 --- abc", *fmt = "%d --- %s";
-    const size_t bufsz = strlen(expected) + 1;
-    char *buffer = alloca(bufsz);
+        // Overflows the size computation.
+        assert(!MyPointsVec_reserve(&vec, SIZE_MAX));
+        assert(vec.ptr == ptr && vec.len == 4);
+
+        MyPointsVec_free(&vec);
+        assert(vec.ptr == NULL && vec.len == 0 && vec.cap == 0);
+    }
+
+    assert(Slice99_grow_capacity(0, 1, 1) == 64);
+    assert(Slice99_grow_capacity(0, 1, 100) == 1);
+    assert(Slice99_grow_capacity(100, 101, 1) == 150);
+    assert(Slice99_grow_capacity(100, 200, 1) == 200);
+    assert(Slice99_grow_capacity(SIZE_MAX - 1, SIZE_MAX, 1) == SIZE_MAX);
+}
+
+TEST(writer) {
+    {
+        uint8_t buffer[32];
+        Slice99Writer w = Slice99Writer_new((U8Slice99)Slice99_typed_from_array(buffer));
+        assert(Slice99Writer_remaining(w) == sizeof buffer);
+
+        assert(Slice99Writer_reserve(&w, 1 + 2 + 2 + 4 + 4));
+        Slice99Writer_put_u8(&w, 0x01);
+        Slice99Writer_put_u16le(&w, 0x0302);
+        Slice99Writer_put_u16be(&w, 0x0405);
+        Slice99Writer_put_u32le(&w, 0x09080706);
+        Slice99Writer_put_u32be(&w, 0x0A0B0C0D);
+
+        assert(Slice99Writer_write_u64le(&w, UINT64_C(0x1514131211100F0E)));
+        assert(Slice99Writer_write_u64be(&w, UINT64_C(0x161718191A1B1C1D)));
+
+        const uint8_t expected[] = {
+            0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B,
+            0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
+            0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D,
+        };
+        assert(Slice99Writer_written(w).len == sizeof expected);
+        assert(memcmp(buffer, expected, sizeof expected) == 0);
+        assert(Slice99Writer_remaining(w) == sizeof buffer - sizeof expected);
+
+        // Does not fit; nothing is written and the error is latched.
+        assert(!Slice99Writer_write_u32le(&w, 0));
+        assert(w.overflowed);
+        assert(Slice99Writer_written(w).len == sizeof expected);
+        assert(!Slice99Writer_write_u8(&w, 0));
+        assert(!Slice99Writer_reserve(&w, 0));
+        assert(Slice99Writer_written(w).len == sizeof expected);
+    }
+
+    {
+        uint8_t buffer[8];
+        Slice99Writer w = Slice99Writer_new((U8Slice99)Slice99_typed_from_array(buffer));
+
+        assert(Slice99Writer_write_slice(&w, SLICE99_TO_UNTYPED(CharSlice99_from_str("abc"))));
+
+        const uint16_t x = 0x1234;
+        assert(Slice99Writer_write_obj(&w, x));
+        assert(memcmp(buffer + 3, &x, sizeof x) == 0);
+
+        assert(Slice99Writer_write_u8(&w, 0xFF));
+        assert(Slice99Writer_write(&w, "de", 2));
+        assert(Slice99Writer_remaining(w) == 0);
+        assert(memcmp(buffer, "abc", 3) == 0 && memcmp(buffer + 6, "de", 2) == 0);
+        assert(!w.overflowed);
+
+        assert(!Slice99Writer_write_slice(&w, SLICE99_TO_UNTYPED(CharSlice99_from_str("x"))));
+        assert(w.overflowed);
+    }
+}
+
+TEST(writer_varint) {
+    const struct {
+        uint64_t value;
+        size_t size;
+        uint8_t bytes[SLICE99_VARINT_MAX_SIZE];
+    } cases[] = {
+        {0, 1, {0x00}},
+        {1, 1, {0x01}},
+        {127, 1, {0x7F}},
+        {128, 2, {0x80, 0x01}},
+        {300, 2, {0xAC, 0x02}},
+        {16383, 2, {0xFF, 0x7F}},
+        {16384, 3, {0x80, 0x80, 0x01}},
+        {UINT64_MAX, 10, {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01}},
+    };
+
+    for (size_t i = 0; i < SLICE99_ARRAY_LEN(cases); i++) {
+        assert(Slice99Writer_varint_size(cases[i].value) == cases[i].size);
+
+        // Both with plenty of space and with exactly enough space.
+        uint8_t buffer[SLICE99_VARINT_MAX_SIZE + 1];
+        const size_t capacities[] = {sizeof buffer, cases[i].size};
+        for (size_t j = 0; j < SLICE99_ARRAY_LEN(capacities); j++) {
+            Slice99Writer w = Slice99Writer_new(U8Slice99_new(buffer, capacities[j]));
+            assert(Slice99Writer_write_varint(&w, cases[i].value));
+            assert(Slice99Writer_written(w).len == cases[i].size);
+            assert(memcmp(buffer, cases[i].bytes, cases[i].size) == 0);
+        }
+
+        Slice99Writer w = Slice99Writer_new(U8Slice99_new(buffer, cases[i].size - 1));
+        assert(!Slice99Writer_write_varint(&w, cases[i].value));
+        assert(w.overflowed);
+        assert(Slice99Writer_written(w).len == 0);
+    }
+}
+
+TEST(reader) {
+    uint8_t buffer[] = {
+        0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0xAC,
+        0x02, 'a',  'b',  'c',  'd',
+    };
+
+    {
+        Slice99Reader r = Slice99Reader_new((U8Slice99)Slice99_typed_from_array(buffer));
+        assert(Slice99Reader_remaining(r) == sizeof buffer);
+
+        assert(Slice99Reader_require(&r, 1 + 2 + 2 + 4 + 4));
+        assert(Slice99Reader_take_u8(&r) == 0x01);
+        assert(Slice99Reader_take_u16le(&r) == 0x0302);
+        assert(Slice99Reader_take_u16be(&r) == 0x0405);
+        assert(Slice99Reader_take_u32le(&r) == 0x09080706);
+        assert(Slice99Reader_take_u32be(&r) == 0x0A0B0C0D);
+
+        assert(Slice99Reader_read_u64le(&r) == UINT64_C(0x1514131211100F0E));
+        assert(Slice99Reader_read_u64be(&r) == UINT64_C(0x161718191A1B1C1D));
+        assert(Slice99Reader_read_varint(&r) == 300);
+
+        // Peeking does not consume anything.
+        U8Slice99 peeked = Slice99Reader_peek(r, 2);
+        assert(peeked.ptr == buffer + 31 && peeked.len == 2);
+        assert(Slice99Reader_peek(r, 100).len == 4);
+
+        // Zero-copy.
+        const U8Slice99 slice = Slice99Reader_read_slice(&r, 3);
+        assert(slice.ptr == buffer + 31 && slice.len == 3);
+        assert(Slice99Reader_rest(r).ptr == buffer + 34 && Slice99Reader_rest(r).len == 1);
+
+        // Does not fit; nothing is consumed and the error is latched.
+        assert(Slice99Reader_read_u16be(&r) == 0);
+        assert(r.failed);
+        assert(Slice99Reader_remaining(r) == 1);
+        assert(Slice99Reader_read_u8(&r) == 0);
+        assert(U8Slice99_is_empty(Slice99Reader_read_slice(&r, 0)));
+        assert(U8Slice99_is_empty(Slice99Reader_peek(r, 1)));
+        assert(!Slice99Reader_require(&r, 0));
+        assert(Slice99Reader_remaining(r) == 1);
+    }
+
+    {
+        Slice99Reader r = Slice99Reader_new((U8Slice99)Slice99_typed_from_array(buffer));
+
+        uint16_t x = 0;
+        assert(Slice99Reader_read_obj(&r, x));
+        assert(memcmp(&x, buffer, sizeof x) == 0);
+
+        char out[3];
+        assert(Slice99Reader_read(&r, out, sizeof out));
+        assert(memcmp(out, buffer + 2, sizeof out) == 0);
+
+        assert(U8Slice99_is_empty(Slice99Reader_read_slice(&r, sizeof buffer)));
+        assert(r.failed);
+        assert(!Slice99Reader_read(&r, out, 0));
+        assert(Slice99Reader_read_u16le(&r) == 0 && Slice99Reader_read_u32le(&r) == 0);
+        assert(Slice99Reader_read_u32be(&r) == 0 && Slice99Reader_read_u64le(&r) == 0);
+        assert(Slice99Reader_read_u64be(&r) == 0 && Slice99Reader_read_varint(&r) == 0);
+        assert(Slice99Reader_remaining(r) == sizeof buffer - 5);
+    }
+}
+
+TEST(reader_varint) {
+    // Round-trips through the writer.
+    const uint64_t values[] = {0, 1, 127, 128, 300, 16383, 16384, UINT32_MAX, UINT64_MAX};
+    for (size_t i = 0; i < SLICE99_ARRAY_LEN(values); i++) {
+        uint8_t buffer[SLICE99_VARINT_MAX_SIZE];
+        Slice99Writer w = Slice99Writer_new((U8Slice99)Slice99_typed_from_array(buffer));
+        assert(Slice99Writer_write_varint(&w, values[i]));
+
+        Slice99Reader r = Slice99Reader_new(Slice99Writer_written(w));
+        assert(Slice99Reader_read_varint(&r) == values[i]);
+        assert(!r.failed && Slice99Reader_remaining(r) == 0);
+
+        // Truncated.
+        const U8Slice99 written = Slice99Writer_written(w);
+        r = Slice99Reader_new(U8Slice99_sub(written, 0, (ptrdiff_t)written.len - 1));
+        assert(Slice99Reader_read_varint(&r) == 0);
+        assert(r.failed && Slice99Reader_remaining(r) == written.len - 1);
+    }
+
+    // Does not fit into 64 bits.
+    {
+        uint8_t buffer[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02};
+        Slice99Reader r = Slice99Reader_new((U8Slice99)Slice99_typed_from_array(buffer));
+        assert(Slice99Reader_read_varint(&r) == 0);
+        assert(r.failed);
+    }
+    {
+        uint8_t buffer[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00};
+        Slice99Reader r = Slice99Reader_new((U8Slice99)Slice99_typed_from_array(buffer));
+        assert(Slice99Reader_read_varint(&r) == 0);
+        assert(r.failed);
+    }
+}
+
+TEST(mmap_file) {
+    const char *path = "slice99_test_mmap.bin";
+    unsigned char contents[10000];
+    for (size_t i = 0; i < sizeof contents; i++) {
+        contents[i] = (unsigned char)i;
+    }
+
+    FILE *file = fopen(path, "wb");
+    assert(file);
+    assert(fwrite(contents, 1, sizeof contents, file) == sizeof contents);
+    assert(fclose(file) == 0);
+
+    {
+        U8Slice99 mapping;
+        assert(Slice99_mmap_file(path, SLICE99_MMAP_READ | SLICE99_MMAP_HUGE_PAGES, &mapping));
+        assert(mapping.len == sizeof contents);
+        assert(memcmp(mapping.ptr, contents, sizeof contents) == 0);
+
+        assert(Slice99_madvise(SLICE99_TO_UNTYPED(mapping), SLICE99_ADVICE_SEQUENTIAL));
+        // Not page-aligned.
+        const U8Slice99 part = U8Slice99_sub(mapping, 5000, 6000);
+        assert(Slice99_madvise(SLICE99_TO_UNTYPED(part), SLICE99_ADVICE_WILLNEED));
+        assert(Slice99_madvise(SLICE99_TO_UNTYPED(part), SLICE99_ADVICE_RANDOM));
+        assert(Slice99_madvise(SLICE99_TO_UNTYPED(part), SLICE99_ADVICE_NORMAL));
+
+        assert(Slice99_munmap(SLICE99_TO_UNTYPED(mapping)));
+    }
+
+    // Writes through a read-write mapping reach the file.
+    {
+        CharSlice99 mapping;
+        assert(CharSlice99_mmap_file(path, SLICE99_MMAP_WRITE, &mapping));
+        assert(mapping.len == sizeof contents);
+        mapping.ptr[0] = 'x';
+        assert(Slice99_munmap(SLICE99_TO_UNTYPED(mapping)));
+
+        file = fopen(path, "rb");
+        assert(file);
+        assert(fgetc(file) == 'x');
+        assert(fclose(file) == 0);
+    }
+
+    // An empty file.
+    {
+        file = fopen(path, "wb");
+        assert(file);
+        assert(fclose(file) == 0);
+
+        U8Slice99 mapping;
+        assert(Slice99_mmap_file(path, SLICE99_MMAP_READ, &mapping));
+        assert(U8Slice99_is_empty(mapping));
+        assert(Slice99_madvise(SLICE99_TO_UNTYPED(mapping), SLICE99_ADVICE_DONTNEED));
+        assert(Slice99_munmap(SLICE99_TO_UNTYPED(mapping)));
+    }
+
+    assert(remove(path) == 0);
+
+    {
+        U8Slice99 mapping = U8Slice99_empty();
+        assert(!Slice99_mmap_file(path, SLICE99_MMAP_READ, &mapping));
+        assert(errno == ENOENT);
+        assert(U8Slice99_is_empty(mapping));
+    }
+}
+
+TEST(iovec) {
+    // Building and advancing.
+    {
+        struct iovec buffer[4];
+        Slice99IoVec v = Slice99IoVec_new(buffer, 4);
+        assert(Slice99IoVec_is_empty(v));
+
+        assert(Slice99IoVec_push(&v, Slice99_from_str("abc")));
+        assert(Slice99IoVec_push(&v, Slice99_empty(1)));
+        assert(Slice99IoVec_push(&v, SLICE99_TO_UNTYPED(CharSlice99_from_str("de"))));
+        assert(Slice99IoVec_push(&v, Slice99_from_array((uint16_t[]){1, 2})));
+        assert(v.len == 3 && v.size == 9);
+
+        assert(Slice99IoVec_push(&v, Slice99_from_str("f")));
+        assert(!Slice99IoVec_push(&v, Slice99_from_str("g")));
+        assert(v.len == 4 && v.size == 10);
+
+        Slice99IoVec_advance(&v, 0);
+        assert(v.len == 4 && v.iov == buffer);
+
+        Slice99IoVec_advance(&v, 1);
+        assert(v.len == 4 && v.size == 9);
+        assert(v.iov[0].iov_len == 2 && memcmp(v.iov[0].iov_base, "bc", 2) == 0);
+
+        // Exactly to the end of an entry.
+        Slice99IoVec_advance(&v, 2);
+        assert(v.len == 3 && v.cap == 3 && v.size == 7);
+        assert(v.iov == buffer + 1 && v.iov[0].iov_len == 2);
+
+        Slice99IoVec_advance(&v, 3);
+        assert(v.len == 2 && v.size == 4);
+        assert(v.iov[0].iov_len == 3);
+
+        Slice99IoVec_advance(&v, 4);
+        assert(v.len == 0 && v.cap == 0 && Slice99IoVec_is_empty(v));
+        assert(!Slice99IoVec_push(&v, Slice99_from_str("h")));
+    }
+
+    // Writing and reading more entries than `IOV_MAX` through a pipe.
+    {
+        enum { count = 3000 };
+        static char bytes[count], received[count];
+        static struct iovec write_buffer[count], read_buffer[count];
+
+        int fds[2];
+        assert(pipe(fds) == 0);
+
+        Slice99IoVec w = Slice99IoVec_new(write_buffer, count),
+                     r = Slice99IoVec_new(read_buffer, count / 2);
+        for (size_t i = 0; i < count; i++) {
+            bytes[i] = (char)i;
+            assert(Slice99IoVec_push(&w, Slice99_new(&bytes[i], 1, 1)));
+        }
+        for (size_t i = 0; i < count; i += 2) {
+            assert(Slice99IoVec_push(&r, Slice99_new(&received[i], 1, 2)));
+        }
+
+        assert(Slice99IoVec_writev(&w, fds[1]));
+        assert(Slice99IoVec_is_empty(w));
+        assert(close(fds[1]) == 0);
+
+        assert(Slice99IoVec_readv(&r, fds[0]));
+        assert(Slice99IoVec_is_empty(r));
+        assert(memcmp(bytes, received, count) == 0);
+
+        // The end of file.
+        char extra[4];
+        r = Slice99IoVec_new(read_buffer, 1);
+        assert(Slice99IoVec_push(&r, Slice99_from_array(extra)));
+        assert(Slice99IoVec_readv(&r, fds[0]));
+        assert(r.size == 4);
+        assert(close(fds[0]) == 0);
+    }
+
+    // More empty entries than `IOV_MAX` in front, as in a manually filled vector.
+    {
+        enum { count = 3000 };
+        static struct iovec buffer[count + 1];
+
+        int fds[2];
+        assert(pipe(fds) == 0);
+
+        for (size_t i = 0; i < count; i++) {
+            buffer[i].iov_base = NULL;
+            buffer[i].iov_len = 0;
+        }
+        buffer[count].iov_base = "abc";
+        buffer[count].iov_len = 3;
+
+        Slice99IoVec v = {.iov = buffer, .len = count + 1, .cap = count + 1, .size = 3};
+        assert(Slice99IoVec_writev(&v, fds[1]));
+        assert(Slice99IoVec_is_empty(v));
+        assert(close(fds[1]) == 0);
+
+        char received[4];
+        for (size_t i = 0; i < count; i++) {
+            buffer[i].iov_base = NULL;
+            buffer[i].iov_len = 0;
+        }
+        buffer[count].iov_base = received;
+        buffer[count].iov_len = sizeof received;
+
+        v = (Slice99IoVec){.iov = buffer, .len = count + 1, .cap = count + 1, .size = 4};
+        assert(Slice99IoVec_readv(&v, fds[0]));
+        assert(v.size == 1 && memcmp(received, "abc", 3) == 0);
+        assert(close(fds[0]) == 0);
+    }
+
+    // A write error.
+    {
+        struct iovec buffer[1];
+        Slice99IoVec v = Slice99IoVec_new(buffer, 1);
+        assert(Slice99IoVec_push(&v, Slice99_from_str("abc")));
+
+        errno = 0;
+        assert(!Slice99IoVec_writev(&v, -1));
+        assert(errno == EBADF);
+        assert(v.size == 3);
+    }
+}
+
+TEST(ring) {
+    // Without mirroring.
+    {
+        uint8_t buffer[8];
+        Slice99Ring ring = Slice99Ring_new((U8Slice99)Slice99_typed_from_array(buffer));
+
+        assert(Slice99Ring_len(ring) == 0);
+        assert(Slice99Ring_readable(ring).len == 0);
+        assert(Slice99Ring_writable(ring).len == 8);
+
+        U8Slice99 space = Slice99Ring_writable(ring);
+        memcpy(space.ptr, "abcdefgh", 8);
+        Slice99Ring_commit(&ring, 8);
+        assert(Slice99Ring_len(ring) == 8);
+        assert(Slice99Ring_writable(ring).len == 0);
+
+        Slice99Ring_consume(&ring, 3);
+        assert(Slice99Ring_readable(ring).len == 5);
+        assert(Slice99Ring_readable(ring).ptr == buffer + 3);
+
+        // The free space at the beginning.
+        space = Slice99Ring_writable(ring);
+        assert(space.ptr == buffer && space.len == 3);
+        memcpy(space.ptr, "ijk", 3);
+        Slice99Ring_commit(&ring, 3);
+
+        // The readable bytes stop at the end, and continue at the beginning.
+        U8Slice99 data = Slice99Ring_readable(ring);
+        assert(Slice99Ring_len(ring) == 8);
+        assert(data.len == 5 && memcmp(data.ptr, "defgh", 5) == 0);
+        Slice99Ring_consume(&ring, 5);
+        data = Slice99Ring_readable(ring);
+        assert(data.len == 3 && memcmp(data.ptr, "ijk", 3) == 0);
+        Slice99Ring_consume(&ring, 3);
+        assert(Slice99Ring_len(ring) == 0);
+
+        // The writable space stops at the end too.
+        space = Slice99Ring_writable(ring);
+        assert(space.ptr == buffer + 3 && space.len == 5);
+    }
+
+    // With mirroring.
+    {
+        Slice99Ring ring;
+        assert(Slice99Ring_new_mirrored(1, &ring));
+        assert(ring.mirrored);
+        assert(ring.cap >= 1 && (ring.cap & (ring.cap - 1)) == 0);
+
+        const size_t cap = ring.cap;
+        Slice99Ring_commit(&ring, cap - 2);
+        Slice99Ring_consume(&ring, cap - 2);
+
+        U8Slice99 space = Slice99Ring_writable(ring);
+        assert(space.len == cap);
+        assert(space.ptr == ring.ptr + cap - 2);
+        memcpy(space.ptr, "wrap", 4);
+        Slice99Ring_commit(&ring, 4);
+
+        // Both copies see the same bytes.
+        assert(memcmp(ring.ptr + cap - 2, "wr", 2) == 0);
+        assert(memcmp(ring.ptr, "ap", 2) == 0);
+
+        const U8Slice99 data = Slice99Ring_readable(ring);
+        assert(data.len == 4 && memcmp(data.ptr, "wrap", 4) == 0);
+
+        assert(Slice99Ring_munmap(ring));
+
+        Slice99Ring big;
+        assert(Slice99Ring_new_mirrored(3 * cap, &big));
+        assert(big.cap == 4 * cap);
+        assert(Slice99Ring_munmap(big));
+    }
+}
+
+enum { spsc_ring_total = 1 << 22 };
+
+static void *spsc_ring_produce(void *arg) {
+    Slice99SpscRing *ring = (Slice99SpscRing *)arg;
+
+    for (size_t written = 0; written < spsc_ring_total;) {
+        U8Slice99 space = Slice99SpscRing_writable(ring);
+        // Commit in uneven pieces to exercise the wraparound.
+        const size_t len = space.len < 1000 ? space.len : 1000;
+        for (size_t i = 0; i < len && written + i < spsc_ring_total; i++) {
+            space.ptr[i] = (uint8_t)((written + i) % 251);
+        }
+
+        const size_t n = len < spsc_ring_total - written ? len : spsc_ring_total - written;
+        if (n == 0) {
+            sched_yield();
+        }
+        Slice99SpscRing_commit(ring, n);
+        written += n;
+    }
+
+    return NULL;
+}
+
+TEST(spsc_ring) {
+    uint8_t buffer[4096];
+    static Slice99SpscRing rings[2];
+    rings[0] = Slice99SpscRing_new(Slice99Ring_new((U8Slice99)Slice99_typed_from_array(buffer)));
+
+    Slice99Ring mirrored;
+    assert(Slice99Ring_new_mirrored(4096, &mirrored));
+    rings[1] = Slice99SpscRing_new(mirrored);
+
+    for (size_t r = 0; r < 2; r++) {
+        Slice99SpscRing *ring = &rings[r];
+        pthread_t producer;
+        assert(pthread_create(&producer, NULL, spsc_ring_produce, ring) == 0);
+
+        for (size_t read = 0; read < spsc_ring_total;) {
+            const U8Slice99 data = Slice99SpscRing_readable(ring);
+            for (size_t i = 0; i < data.len; i++) {
+                assert(data.ptr[i] == (uint8_t)((read + i) % 251));
+            }
+
+            if (data.len == 0) {
+                sched_yield();
+            }
+            Slice99SpscRing_consume(ring, data.len);
+            read += data.len;
+        }
+
+        assert(pthread_join(producer, NULL) == 0);
+        assert(Slice99SpscRing_readable(ring).len == 0);
+    }
+
+    assert(Slice99Ring_munmap(mirrored));
+}
+
+TEST(spsc_queue) {
+    Slice99 buffer[4];
+    Slice99SpscQueue queue = Slice99SpscQueue_new(buffer, 4);
+    int data[8];
+    Slice99 item, items[8];
+
+    for (size_t i = 0; i < 8; i++) {
+        items[i] = Slice99_new(&data[i], sizeof(int), i);
+    }
+
+    assert(!Slice99SpscQueue_pop(&queue, &item));
+    assert(Slice99SpscQueue_push(&queue, items[0]));
+    assert(Slice99SpscQueue_pop(&queue, &item));
+    assert(item.ptr == &data[0] && item.len == 0);
+
+    // A batch that wraps around and does not fit.
+    assert(Slice99SpscQueue_push_batch(&queue, items + 1, 6) == 4);
+    assert(!Slice99SpscQueue_push(&queue, items[7]));
+
+    Slice99 out[8];
+    assert(Slice99SpscQueue_pop_batch(&queue, out, 3) == 3);
+    assert(Slice99SpscQueue_push_batch(&queue, items + 5, 3) == 3);
+    assert(Slice99SpscQueue_pop_batch(&queue, out + 3, 8) == 4);
+    for (size_t i = 0; i < 7; i++) {
+        assert(out[i].ptr == &data[i + 1] && out[i].len == i + 1);
+    }
+    assert(Slice99SpscQueue_pop_batch(&queue, out, 8) == 0);
+}
+
+TEST(mpmc_queue) {
+    Slice99MpmcCell cells[4];
+    Slice99MpmcQueue queue = Slice99MpmcQueue_new(cells, 4);
+    int data[8];
+    Slice99 item, items[8];
+
+    for (size_t i = 0; i < 8; i++) {
+        items[i] = Slice99_new(&data[i], sizeof(int), i);
+    }
+
+    assert(!Slice99MpmcQueue_pop(&queue, &item));
+    assert(Slice99MpmcQueue_push(&queue, items[0]));
+    assert(Slice99MpmcQueue_pop(&queue, &item));
+    assert(item.ptr == &data[0] && item.len == 0);
+
+    assert(Slice99MpmcQueue_push_batch(&queue, items + 1, 6) == 4);
+    assert(!Slice99MpmcQueue_push(&queue, items[7]));
+
+    Slice99 out[8];
+    assert(Slice99MpmcQueue_pop_batch(&queue, out, 3) == 3);
+    assert(Slice99MpmcQueue_push_batch(&queue, items + 5, 3) == 3);
+    assert(Slice99MpmcQueue_pop_batch(&queue, out + 3, 8) == 4);
+    for (size_t i = 0; i < 7; i++) {
+        assert(out[i].ptr == &data[i + 1] && out[i].len == i + 1);
+    }
+    assert(Slice99MpmcQueue_pop_batch(&queue, out, 8) == 0);
+}
+
+enum {
+    queue_threads = 4,
+    queue_items = 100000,
+};
+
+// The producer of an item is identified by its pointer into this array, and its sequence number
+// is its length.
+static char queue_tags[queue_threads];
+
+typedef struct {
+    Slice99SpscQueue *spsc;
+    Slice99MpmcQueue *mpmc;
+    size_t producer;
+    size_t *remaining;
+    size_t sums[queue_threads];
+} QueueCtx;
+
+static void *queue_produce(void *arg) {
+    QueueCtx *ctx = (QueueCtx *)arg;
+    Slice99 items[8];
+
+    for (size_t seq = 0; seq < queue_items;) {
+        // Vary the batch size to exercise partial batches.
+        size_t n = 0;
+        for (; n < 1 + seq % 8 && seq + n < queue_items; n++) {
+            items[n] = Slice99_new(&queue_tags[ctx->producer], 1, seq + n);
+        }
+
+        const size_t pushed = ctx->spsc != NULL ? Slice99SpscQueue_push_batch(ctx->spsc, items, n)
+                                                : Slice99MpmcQueue_push_batch(ctx->mpmc, items, n);
+        if (pushed == 0) {
+            sched_yield();
+        }
+        seq += pushed;
+    }
+
+    return NULL;
+}
+
+static void *queue_consume(void *arg) {
+    QueueCtx *ctx = (QueueCtx *)arg;
+    size_t next[queue_threads] = {0};
+    Slice99 items[8];
+
+    for (size_t i = 0; __atomic_load_n(ctx->remaining, __ATOMIC_RELAXED) > 0; i++) {
+        const size_t batch = 1 + i % 8;
+        const size_t n = ctx->spsc != NULL ? Slice99SpscQueue_pop_batch(ctx->spsc, items, batch)
+                                           : Slice99MpmcQueue_pop_batch(ctx->mpmc, items, batch);
+        if (n == 0) {
+            sched_yield();
+            continue;
+        }
+        __atomic_fetch_sub(ctx->remaining, n, __ATOMIC_RELAXED);
+
+        for (size_t j = 0; j < n; j++) {
+            const size_t producer = (size_t)((char *)items[j].ptr - queue_tags);
+            assert(producer < queue_threads);
+
+            // The items of every producer are popped in order.
+            assert(items[j].len >= next[producer]);
+            next[producer] = items[j].len + 1;
+            ctx->sums[producer] += items[j].len;
+        }
+    }
+
+    return NULL;
+}
+
+static void queue_run(Slice99SpscQueue *spsc, Slice99MpmcQueue *mpmc, size_t threads) {
+    pthread_t producers[queue_threads], consumers[queue_threads];
+    QueueCtx producer_ctxs[queue_threads], consumer_ctxs[queue_threads];
+    size_t remaining = threads * queue_items;
+
+    for (size_t i = 0; i < threads; i++) {
+        producer_ctxs[i] = (QueueCtx){.spsc = spsc, .mpmc = mpmc, .producer = i};
+        consumer_ctxs[i] = (QueueCtx){.spsc = spsc, .mpmc = mpmc, .remaining = &remaining};
+        assert(pthread_create(&producers[i], NULL, queue_produce, &producer_ctxs[i]) == 0);
+        assert(pthread_create(&consumers[i], NULL, queue_consume, &consumer_ctxs[i]) == 0);
+    }
+
+    for (size_t i = 0; i < threads; i++) {
+        assert(pthread_join(producers[i], NULL) == 0);
+        assert(pthread_join(consumers[i], NULL) == 0);
+    }
+
+    // Every item has been popped exactly once.
+    for (size_t producer = 0; producer < threads; producer++) {
+        size_t sum = 0;
+        for (size_t i = 0; i < threads; i++) {
+            sum += consumer_ctxs[i].sums[producer];
+        }
+        assert(sum == (size_t)queue_items * (queue_items - 1) / 2);
+    }
+}
+
+TEST(queue_threads) {
+    {
+        Slice99 buffer[64];
+        static Slice99SpscQueue queue;
+        queue = Slice99SpscQueue_new(buffer, 64);
+        queue_run(&queue, NULL, 1);
+    }
+
+    {
+        Slice99MpmcCell cells[64];
+        static Slice99MpmcQueue queue;
+        queue = Slice99MpmcQueue_new(cells, 64);
+        queue_run(NULL, &queue, queue_threads);
+    }
+}
+
+typedef struct {
+    pthread_mutex_t lock;
+    size_t items_seen;
+    size_t max_chunk_len;
+} ParForEachCtx;
+
+static void par_for_each_increment(Slice99 chunk, size_t offset, void *ctx) {
+    ParForEachCtx *c = (ParForEachCtx *)ctx;
+
+    for (size_t i = 0; i < chunk.len; i++) {
+        uint32_t *item = (uint32_t *)Slice99_get(chunk, (ptrdiff_t)i);
+        assert(*item == offset + i);
+        (*item)++;
+    }
+
+    pthread_mutex_lock(&c->lock);
+    c->items_seen += chunk.len;
+    c->max_chunk_len = chunk.len > c->max_chunk_len ? chunk.len : c->max_chunk_len;
+    pthread_mutex_unlock(&c->lock);
+}
+
+TEST(par) {
+    enum { len = 100003 };
+    uint32_t *lhs = malloc(len * sizeof(uint32_t)), *rhs = malloc(len * sizeof(uint32_t));
+    assert(lhs && rhs);
+
+    const size_t thread_counts[] = {0, 1, 3, 1000};
+    for (size_t t = 0; t < SLICE99_ARRAY_LEN(thread_counts); t++) {
+        const size_t num_threads = thread_counts[t];
+
+        for (uint32_t i = 0; i < len; i++) {
+            lhs[i] = i;
+        }
+
+        ParForEachCtx ctx = {.items_seen = 0, .max_chunk_len = 0};
+        pthread_mutex_init(&ctx.lock, NULL);
+        Slice99_par_for_each(
+            Slice99_new(lhs, sizeof(uint32_t), len), num_threads, par_for_each_increment, &ctx);
+        pthread_mutex_destroy(&ctx.lock);
+
+        assert(ctx.items_seen == len);
+        // Either runs serially or rounds the chunk size down to a multiple of the cache line.
+        assert(ctx.max_chunk_len == len || ctx.max_chunk_len == 960 / sizeof(uint32_t));
+        assert(num_threads != 1 || ctx.max_chunk_len == len);
+        assert(num_threads != 3 || ctx.max_chunk_len == 960 / sizeof(uint32_t));
+        for (uint32_t i = 0; i < len; i++) {
+            assert(lhs[i] == i + 1);
+        }
+
+        Slice99 lhs_slice = Slice99_new(lhs, sizeof(uint32_t), len),
+                rhs_slice = Slice99_new(rhs, sizeof(uint32_t), len);
+
+        Slice99_par_copy_non_overlapping(rhs_slice, lhs_slice, num_threads);
+        assert(memcmp(lhs, rhs, len * sizeof(uint32_t)) == 0);
+        assert(Slice99_par_primitive_eq(lhs_slice, rhs_slice, num_threads));
+
+        rhs[len / 2]++;
+        assert(!Slice99_par_primitive_eq(lhs_slice, rhs_slice, num_threads));
+        rhs[len / 2]--;
+        rhs[len - 1]++;
+        assert(!Slice99_par_primitive_eq(lhs_slice, rhs_slice, num_threads));
+        assert(!Slice99_par_primitive_eq(lhs_slice, Slice99_sub(rhs_slice, 1, len), num_threads));
+
+        for (uint32_t i = 0; i < len; i++) {
+            rhs[i] = ~i;
+        }
+        Slice99_par_swap_with_slice(lhs_slice, rhs_slice, num_threads);
+        for (uint32_t i = 0; i < len; i++) {
+            assert(lhs[i] == ~i && rhs[i] == i + 1);
+        }
+    }
+
+    // Items that do not divide the cache line, and an empty slice.
+    {
+        char a[5000 * 3], b[5000 * 3];
+        for (size_t i = 0; i < sizeof a; i++) {
+            a[i] = (char)i;
+        }
+
+        Slice99_par_copy_non_overlapping(Slice99_new(b, 3, 5000), Slice99_new(a, 3, 5000), 4);
+        assert(memcmp(a, b, sizeof a) == 0);
+
+        Slice99_par_copy_non_overlapping(Slice99_new(b, 3, 0), Slice99_new(a, 3, 0), 4);
+        assert(Slice99_par_primitive_eq(Slice99_new(b, 3, 0), Slice99_new(a, 3, 0), 4));
+    }
+
+    // Without a threshold, an empty slice has no chunks to hand out to the threads.
+    {
+        par_threshold = 0;
+
+        ParForEachCtx ctx = {.items_seen = 0, .max_chunk_len = 0};
+        pthread_mutex_init(&ctx.lock, NULL);
+        Slice99_par_for_each(
+            Slice99_new(lhs, sizeof(uint32_t), 0), 4, par_for_each_increment, &ctx);
+        pthread_mutex_destroy(&ctx.lock);
+        assert(ctx.items_seen == 0);
+
+        Slice99_par_copy_non_overlapping(
+            Slice99_new(rhs, sizeof(uint32_t), 0), Slice99_new(lhs, sizeof(uint32_t), 0), 4);
+        assert(Slice99_par_primitive_eq(
+            Slice99_new(rhs, sizeof(uint32_t), 0), Slice99_new(lhs, sizeof(uint32_t), 0), 4));
+        Slice99_par_swap_with_slice(
+            Slice99_new(rhs, sizeof(uint32_t), 0), Slice99_new(lhs, sizeof(uint32_t), 0), 4);
+
+        par_threshold = 4096;
+    }
+
+    free(lhs);
+    free(rhs);
+}
+
+#define INT_CMP(lhs, rhs)   ((*(lhs) > *(rhs)) - (*(lhs) < *(rhs)))
+#define POINT_CMP(lhs, rhs) ((lhs)->x != (rhs)->x ? (lhs)->x - (rhs)->x : (lhs)->y - (rhs)->y)
+
+SLICE99_DEF_TYPED_SORT(IntSlice99, int, INT_CMP);
+SLICE99_DEF_TYPED_SORT(MyPoints, Point, POINT_CMP);
+
+#undef INT_CMP
+#undef POINT_CMP
+
+// Fills `ints` with a pattern that exercises a specific path of introsort.
+static void fill_ints(int *ints, size_t len, int pattern) {
+    for (size_t i = 0; i < len; i++) {
+        switch (pattern) {
+        case 0:
+            ints[i] = rand();
+            break;
+        case 1:
+            ints[i] = rand() % 4;
+            break;
+        case 2:
+            ints[i] = (int)i;
+            break;
+        case 3:
+            ints[i] = -(int)i;
+            break;
+        default:
+            // Organ pipe.
+            ints[i] = (int)(i < len / 2 ? i : len - i);
+            break;
+        }
+    }
+}
+
+static bool ints_are_sorted(const int *ints, size_t len) {
+    for (size_t i = 1; i < len; i++) {
+        if (ints[i - 1] > ints[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(sort) {
+    enum { max_len = 5000 };
+    int *ints = malloc(max_len * sizeof(int)), *copy = malloc(max_len * sizeof(int));
+    assert(ints && copy);
+
+    const size_t lens[] = {0, 1, 2, 3, 16, 17, 100, max_len};
+    for (size_t i = 0; i < SLICE99_ARRAY_LEN(lens); i++) {
+        for (int pattern = 0; pattern < 5; pattern++) {
+            fill_ints(ints, lens[i], pattern);
+            memcpy(copy, ints, lens[i] * sizeof(int));
+
+            int backup;
+            Slice99_sort(Slice99_new(ints, sizeof(int), lens[i]), int_cmp, &backup);
+            assert(ints_are_sorted(ints, lens[i]));
+
+            IntSlice99_sort_inline(IntSlice99_new(copy, lens[i]));
+            assert(memcmp(ints, copy, lens[i] * sizeof(int)) == 0);
+
+            IntSlice99_reverse(IntSlice99_new(copy, lens[i]), NULL);
+            IntSlice99_sort(
+                IntSlice99_new(copy, lens[i]), (int (*)(const int *, const int *))int_cmp,
+                &backup);
+            assert(memcmp(ints, copy, lens[i] * sizeof(int)) == 0);
+        }
+    }
+
+    // Exhaust the depth limit to reach heapsort.
+    {
+        int backup;
+        fill_ints(ints, max_len, 0);
+        memcpy(copy, ints, max_len * sizeof(int));
+
+        const struct slice99_priv_sort_ctx ctx = {
+            .item_size = sizeof(int), .cmp = int_cmp, .backup = &backup};
+        slice99_priv_sort(&ctx, (char *)ints, max_len, 0);
+        assert(ints_are_sorted(ints, max_len));
+
+        IntSlice99_priv_sort(copy, max_len, 0);
+        assert(memcmp(ints, copy, max_len * sizeof(int)) == 0);
+    }
+
+    free(ints);
+    free(copy);
+
+    {
+        MyPoints points =
+            (MyPoints)Slice99_typed_from_array((Point[]){{2, 1}, {1, 5}, {2, 0}, {1, 2}});
+        MyPoints_sort_inline(points);
+
+        MyPoints expected =
+            (MyPoints)Slice99_typed_from_array((Point[]){{1, 2}, {1, 5}, {2, 0}, {2, 1}});
+        assert(MyPoints_primitive_eq(points, expected));
+    }
+}
+
+TEST(bsearch) {
+    int ints[] = {1, 3, 3, 3, 5, 8};
+    const Slice99 slice = Slice99_from_array(ints);
+    const IntSlice99 typed = (IntSlice99)Slice99_typed_from_array(ints);
+
+    const struct {
+        int key;
+        size_t lower, upper;
+        ptrdiff_t found;
+    } cases[] = {
+        {0, 0, 0, -1}, {1, 0, 1, 0}, {2, 1, 1, -1}, {3, 1, 4, 1},
+        {4, 4, 4, -1}, {5, 4, 5, 4}, {8, 5, 6, 5}, {9, 6, 6, -1},
+    };
+
+    for (size_t i = 0; i < SLICE99_ARRAY_LEN(cases); i++) {
+        const int key = cases[i].key;
+
+        assert(Slice99_lower_bound(slice, &key, int_cmp) == cases[i].lower);
+        assert(Slice99_upper_bound(slice, &key, int_cmp) == cases[i].upper);
+        assert(Slice99_bsearch(slice, &key, int_cmp) == cases[i].found);
+
+        assert(IntSlice99_lower_bound_inline(typed, &key) == cases[i].lower);
+        assert(IntSlice99_upper_bound_inline(typed, &key) == cases[i].upper);
+        assert(IntSlice99_bsearch_inline(typed, &key) == cases[i].found);
+
+        int (*typed_cmp)(const int *, const int *) = (int (*)(const int *, const int *))int_cmp;
+        assert(IntSlice99_lower_bound(typed, &key, typed_cmp) == cases[i].lower);
+        assert(IntSlice99_upper_bound(typed, &key, typed_cmp) == cases[i].upper);
+        assert(IntSlice99_bsearch(typed, &key, typed_cmp) == cases[i].found);
+    }
+
+    const int key = 1;
+    assert(Slice99_lower_bound(Slice99_sub(slice, 0, 0), &key, int_cmp) == 0);
+    assert(Slice99_upper_bound(Slice99_sub(slice, 0, 0), &key, int_cmp) == 0);
+    assert(Slice99_bsearch(Slice99_sub(slice, 0, 0), &key, int_cmp) == -1);
+    assert(IntSlice99_bsearch_inline(IntSlice99_empty(), &key) == -1);
+}
+
+TEST(radix_sort) {
+    enum { len = 3000 };
+
+    {
+        uint32_t *keys = malloc(len * sizeof(uint32_t)), *scratch = malloc(len * sizeof(uint32_t));
+        assert(keys && scratch);
+
+        // Random keys, and keys whose high bytes are all equal so that passes are skipped.
+        for (int pattern = 0; pattern < 2; pattern++) {
+            for (size_t i = 0; i < len; i++) {
+                const uint32_t r = (uint32_t)rand() ^ ((uint32_t)rand() << 16);
+                keys[i] = pattern == 0 ? r : 0xAB000000 | (r & 0xFF);
+            }
+
+            U32Slice99_radix_sort(U32Slice99_new(keys, len), U32Slice99_new(scratch, len));
+            for (size_t i = 1; i < len; i++) {
+                assert(keys[i - 1] <= keys[i]);
+            }
+        }
+
+        free(keys);
+        free(scratch);
+    }
+
+    {
+        int64_t keys[] = {5, -1, INT64_MIN, 0, INT64_MAX, -300, 300, -1}, scratch[8];
+        I64Slice99_radix_sort(
+            (I64Slice99)Slice99_typed_from_array(keys),
+            (I64Slice99)Slice99_typed_from_array(scratch));
+
+        const int64_t expected[] = {INT64_MIN, -300, -1, -1, 0, 5, 300, INT64_MAX};
+        assert(memcmp(keys, expected, sizeof keys) == 0);
+    }
+
+    {
+        int8_t keys[] = {3, -128, 127, -1, 0}, scratch[5];
+        I8Slice99_radix_sort(
+            (I8Slice99)Slice99_typed_from_array(keys),
+            (I8Slice99)Slice99_typed_from_array(scratch));
+
+        const int8_t expected[] = {-128, -1, 0, 3, 127};
+        assert(memcmp(keys, expected, sizeof keys) == 0);
+    }
+
+    {
+        uint16_t keys[] = {7, 7, 7}, scratch[3];
+        U16Slice99_radix_sort(
+            (U16Slice99)Slice99_typed_from_array(keys),
+            (U16Slice99)Slice99_typed_from_array(scratch));
+        assert(keys[0] == 7 && keys[1] == 7 && keys[2] == 7);
+
+        U64Slice99_radix_sort(U64Slice99_empty(), U64Slice99_empty());
+    }
+}
+
+TEST(primitive_hash) {
+    // The wyhash test vectors, hashed with the seed equal to the index.
+    const struct {
+        const char *str;
+        uint64_t hash;
+    } vectors[] = {
+        {"", UINT64_C(0x93228a4de0eec5a2)},
+        {"a", UINT64_C(0xc5bac3db178713c4)},
+        {"abc", UINT64_C(0xa97f2f7b1d9b3314)},
+        {"message digest", UINT64_C(0x786d1f1df3801df4)},
+        {"abcdefghijklmnopqrstuvwxyz", UINT64_C(0xdca5a8138ad37c87)},
+        {"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+         UINT64_C(0xb9e734f117cfaf70)},
+        {"1234567890123456789012345678901234567890123456789012345678901234567890123456789"
+         "0",
+         UINT64_C(0x6cc5eab49a92d617)},
+    };
+
+    for (size_t i = 0; i < SLICE99_ARRAY_LEN(vectors); i++) {
+        const CharSlice99 str = CharSlice99_from_str((char *)vectors[i].str);
+        assert(CharSlice99_primitive_hash(str, i) == vectors[i].hash);
+        assert(Slice99_primitive_hash(SLICE99_TO_UNTYPED(str), i) == vectors[i].hash);
+    }
+
+    // Every length and every byte affects the hash; the item size does not.
+    unsigned char bytes[128];
+    for (size_t i = 0; i < sizeof bytes; i++) {
+        bytes[i] = (unsigned char)rand();
+    }
+
+    for (size_t len = 0; len <= sizeof bytes; len++) {
+        const Slice99 slice = Slice99_new(bytes, 1, len);
+        const uint64_t hash = Slice99_primitive_hash(slice, 42);
+
+        assert(hash != Slice99_primitive_hash(slice, 43));
+        if (len > 0) {
+            assert(hash != Slice99_primitive_hash(Slice99_new(bytes, 1, len - 1), 42));
+        }
+        if (len % 4 == 0) {
+            assert(hash == Slice99_primitive_hash(Slice99_new(bytes, 4, len / 4), 42));
+        }
+
+        for (size_t i = 0; i < len; i++) {
+            bytes[i] ^= 1;
+            assert(hash != Slice99_primitive_hash(slice, 42));
+            bytes[i] ^= 1;
+        }
+    }
+}
+
+TEST(crc32c) {
+    const struct {
+        const char *str;
+        uint32_t crc;
+    } vectors[] = {
+        {"", 0x00000000},
+        {"a", 0xC1D04330},
+        {"123456789", 0xE3069283},
+        {"The quick brown fox jumps over the lazy dog", 0x22620404},
+    };
+
+    for (size_t i = 0; i < SLICE99_ARRAY_LEN(vectors); i++) {
+        const CharSlice99 str = CharSlice99_from_str((char *)vectors[i].str);
+        assert(CharSlice99_crc32c(str, 0) == vectors[i].crc);
+
+        // Incremental computation at every split point.
+        for (size_t j = 0; j <= str.len; j++) {
+            const CharSlice99 lhs = CharSlice99_sub(str, 0, (ptrdiff_t)j),
+                              rhs = CharSlice99_advance(str, (ptrdiff_t)j);
+            assert(CharSlice99_crc32c(rhs, CharSlice99_crc32c(lhs, 0)) == vectors[i].crc);
+        }
+    }
+
+    // 32 bytes of zeros and of 0xFF (RFC 3720, B.4).
+    unsigned char bytes[32];
+    memset(bytes, 0, sizeof bytes);
+    assert(Slice99_crc32c(Slice99_from_array(bytes), 0) == 0x8A9136AA);
+    memset(bytes, 0xFF, sizeof bytes);
+    assert(Slice99_crc32c(Slice99_from_array(bytes), 0) == 0x62A8AB43);
+}
+
+TEST(map) {
+    Slice99Map map = Slice99Map_new(42);
+    int values[1000];
+
+    assert(Slice99Map_get(&map, Slice99_from_str("abc")) == NULL);
+    assert(!Slice99Map_remove(&map, Slice99_from_str("abc")));
+
+    // Keys are copied, so the buffer is reused for every key.
+    char buf[32];
+    for (int i = 0; i < 1000; i++) {
+        values[i] = i;
+        const Slice99 key = Slice99_new(buf, 1, (size_t)snprintf(buf, sizeof buf, "key%d", i));
+        assert(Slice99Map_insert(&map, key, &values[i]));
+    }
+    assert(map.len == 1000);
+
+    for (int i = 0; i < 1000; i++) {
+        const Slice99 key = Slice99_new(buf, 1, (size_t)snprintf(buf, sizeof buf, "key%d", i));
+        Slice99MapEntry *entry = Slice99Map_get(&map, key);
+        assert(entry != NULL && entry->value == &values[i]);
+        assert(entry->key.ptr != buf && Slice99_primitive_eq(entry->key, key));
+    }
+    assert(Slice99Map_get(&map, Slice99_from_str("key1000")) == NULL);
+    assert(Slice99Map_get(&map, Slice99_from_str("key")) == NULL);
+
+    // Lookups compare bytes regardless of the item size.
+    assert(Slice99Map_get(&map, SLICE99_TO_UNTYPED(CharSlice99_from_str("key7"))) != NULL);
+
+    // Replacing a value.
+    {
+        bool inserted = true;
+        Slice99MapEntry *entry = Slice99Map_entry(&map, Slice99_from_str("key5"), &inserted);
+        assert(entry != NULL && !inserted && entry->value == &values[5]);
+        assert(Slice99Map_insert(&map, Slice99_from_str("key5"), &values[6]));
+        assert(Slice99Map_get(&map, Slice99_from_str("key5"))->value == &values[6]);
+        assert(map.len == 1000);
+    }
+
+    // The empty key.
+    {
+        bool inserted = false;
+        Slice99MapEntry *entry = Slice99Map_entry(&map, Slice99_from_str(""), &inserted);
+        assert(entry != NULL && inserted && entry->value == NULL);
+        assert(Slice99Map_get(&map, Slice99_from_str("")) == entry);
+        assert(Slice99Map_remove(&map, Slice99_from_str("")));
+    }
+
+    // Removing every even key.
+    for (int i = 0; i < 1000; i += 2) {
+        const Slice99 key = Slice99_new(buf, 1, (size_t)snprintf(buf, sizeof buf, "key%d", i));
+        assert(Slice99Map_remove(&map, key));
+        assert(!Slice99Map_remove(&map, key));
+    }
+    assert(map.len == 500);
+
+    for (int i = 0; i < 1000; i++) {
+        const Slice99 key = Slice99_new(buf, 1, (size_t)snprintf(buf, sizeof buf, "key%d", i));
+        assert((Slice99Map_get(&map, key) != NULL) == (i % 2 == 1));
+    }
+
+    // Iteration visits every entry once.
+    {
+        size_t cursor = 0, count = 0;
+        int sum = 0;
+        Slice99MapEntry *entry;
+        while (Slice99Map_next(&map, &cursor, &entry)) {
+            sum += *(int *)entry->value;
+            count++;
+        }
+        // The odd values, with values[5] replaced by values[6].
+        assert(count == 500 && sum == 250000 + 1);
+    }
+
+    Slice99Map_free(&map);
+    assert(map.len == 0 && map.cap == 0 && map.seed == 42);
+    assert(Slice99Map_get(&map, Slice99_from_str("key1")) == NULL);
+
+    // Capacities that cannot be represented fail instead of wrapping around.
+    assert(!Slice99Map_reserve(&map, SIZE_MAX / 2 - 1));
+    assert(!Slice99Map_reserve(&map, SIZE_MAX / 2 / 8 * 7 + 1));
+    assert(!Slice99Map_reserve(&map, SIZE_MAX));
+    assert(map.cap == 0);
+
+    // Churn: inserting and removing many keys keeps the table small.
+    {
+        assert(Slice99Map_reserve(&map, 100));
+        assert(map.cap == 128);
+
+        for (int i = 0; i < 10000; i++) {
+            const Slice99 key = Slice99_new(buf, 1, (size_t)snprintf(buf, sizeof buf, "%d", i));
+            assert(Slice99Map_insert(&map, key, NULL));
+            if (i >= 50) {
+                const Slice99 old =
+                    Slice99_new(buf, 1, (size_t)snprintf(buf, sizeof buf, "%d", i - 50));
+                assert(Slice99Map_remove(&map, old));
+            }
+        }
+        assert(map.len == 50 && map.cap == 128);
+
+        for (int i = 9950; i < 10000; i++) {
+            const Slice99 key = Slice99_new(buf, 1, (size_t)snprintf(buf, sizeof buf, "%d", i));
+            assert(Slice99Map_get(&map, key) != NULL);
+        }
+
+        Slice99Map_free(&map);
+    }
+}
+
+TEST(interner) {
+    CharSlice99Interner interner = CharSlice99Interner_new(7);
+    uint32_t id;
+
+    assert(!CharSlice99Interner_get(&interner, CharSlice99_from_str("abc"), &id));
+
+    char buf[32];
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 1000; i++) {
+            const CharSlice99 str =
+                CharSlice99_new(buf, (size_t)snprintf(buf, sizeof buf, "s%d", i));
+            assert(CharSlice99Interner_intern(&interner, str, &id));
+            assert(id == (uint32_t)i);
+        }
+        assert(interner.len == 1000);
+    }
+
+    for (int i = 0; i < 1000; i++) {
+        const CharSlice99 str = CharSlice99_new(buf, (size_t)snprintf(buf, sizeof buf, "s%d", i));
+        assert(CharSlice99Interner_get(&interner, str, &id) && id == (uint32_t)i);
+
+        const CharSlice99 canonical = CharSlice99Interner_str(&interner, id);
+        assert(canonical.ptr != buf && CharSlice99_primitive_eq(canonical, str));
+
+        // The canonical copy is interned as itself.
+        uint32_t same;
+        assert(CharSlice99Interner_intern(&interner, canonical, &same) && same == id);
+        assert(CharSlice99Interner_str(&interner, same).ptr == canonical.ptr);
+    }
+    assert(!CharSlice99Interner_get(&interner, CharSlice99_from_str("s1000"), &id));
+
+    // The empty string.
+    {
+        uint32_t empty;
+        assert(CharSlice99Interner_intern(&interner, CharSlice99_from_str(""), &empty));
+        assert(empty == 1000 && CharSlice99Interner_str(&interner, empty).len == 0);
+        assert(CharSlice99Interner_get(&interner, CharSlice99_empty(), &id) && id == empty);
+    }
+
+    CharSlice99Interner_free(&interner);
+    assert(interner.len == 0 && interner.seed == 7);
+    assert(CharSlice99Interner_intern(&interner, CharSlice99_from_str("abc"), &id) && id == 0);
+    CharSlice99Interner_free(&interner);
+}
+
+#define INTERNER_READERS 3
+#define INTERNER_STRS    5000
+
+typedef struct {
+    const CharSlice99Interner *interner;
+    const bool *done;
+} InternerReaderCtx;
+
+// Looks up the strings interned concurrently by `test_interner_threads`.
+static void *interner_read(void *arg) {
+    const InternerReaderCtx *ctx = (const InternerReaderCtx *)arg;
+    char buf[32];
+
+    for (;;) {
+        const bool done = __atomic_load_n(ctx->done, __ATOMIC_ACQUIRE);
+
+        for (int i = 0; i < INTERNER_STRS; i += 7) {
+            const CharSlice99 str =
+                CharSlice99_new(buf, (size_t)snprintf(buf, sizeof buf, "s%d", i));
+            uint32_t id;
+            if (CharSlice99Interner_get(ctx->interner, str, &id)) {
+                assert(id == (uint32_t)i);
+                assert(CharSlice99_primitive_eq(CharSlice99Interner_str(ctx->interner, id), str));
+            } else {
+                assert(!done);
+            }
+        }
+
+        if (done) {
+            return NULL;
+        }
+        sched_yield();
+    }
+}
+
+TEST(interner_threads) {
+    CharSlice99Interner interner = CharSlice99Interner_new(3);
+    bool done = false;
+    const InternerReaderCtx ctx = {.interner = &interner, .done = &done};
+
+    pthread_t threads[INTERNER_READERS];
+    for (size_t i = 0; i < INTERNER_READERS; i++) {
+        assert(pthread_create(&threads[i], NULL, interner_read, (void *)&ctx) == 0);
+    }
+
+    // Replaces the lookup table several times while the readers are running.
+    char buf[32];
+    for (int i = 0; i < INTERNER_STRS; i++) {
+        const CharSlice99 str = CharSlice99_new(buf, (size_t)snprintf(buf, sizeof buf, "s%d", i));
+        uint32_t id;
+        assert(CharSlice99Interner_intern(&interner, str, &id) && id == (uint32_t)i);
+        if (i % 100 == 0) {
+            sched_yield();
+        }
+    }
+    __atomic_store_n(&done, true, __ATOMIC_RELEASE);
+
+    for (size_t i = 0; i < INTERNER_READERS; i++) {
+        assert(pthread_join(threads[i], NULL) == 0);
+    }
+
+    CharSlice99Interner_free(&interner);
+}
+
+#undef INTERNER_READERS
+#undef INTERNER_STRS
+
+TEST(shared) {
+    int data[] = {1, 2, 3, 4, 5};
+
+    Slice99Shared shared;
+    assert(Slice99Shared_from_slice(Slice99_from_array(data), &shared));
+    assert(shared.slice.ptr != data);
+    assert(Slice99_primitive_eq(shared.slice, Slice99_from_array(data)));
+    assert(Slice99Shared_is_unique(shared));
+
+    // Sharing does not copy.
+    Slice99Shared other = Slice99Shared_share(shared), tail = Slice99Shared_sub(shared, 3, 5);
+    assert(other.slice.ptr == shared.slice.ptr);
+    assert(tail.slice.ptr == Slice99_get(shared.slice, 3) && tail.slice.len == 2);
+    assert(!Slice99Shared_is_unique(shared) && !Slice99Shared_is_unique(tail));
+
+    // The sub-handle keeps the buffer alive.
+    Slice99Shared_release(shared);
+    Slice99Shared_release(other);
+    assert(Slice99Shared_is_unique(tail));
+    assert(*(int *)Slice99_first(tail.slice) == 4);
+
+    // A unique handle is modified in place.
+    {
+        void *ptr = tail.slice.ptr;
+        assert(Slice99Shared_make_mut(&tail));
+        assert(tail.slice.ptr == ptr);
+    }
+
+    // A shared one is copied first.
+    {
+        other = Slice99Shared_share(tail);
+        assert(Slice99Shared_make_mut(&other));
+        assert(other.slice.ptr != tail.slice.ptr);
+        assert(Slice99Shared_is_unique(other) && Slice99Shared_is_unique(tail));
+
+        *(int *)Slice99_first(other.slice) = 42;
+        assert(*(int *)Slice99_first(tail.slice) == 4);
+        assert(*(int *)Slice99_last(other.slice) == 5);
+
+        Slice99Shared_release(other);
+    }
+
+    Slice99Shared_release(tail);
+
+    {
+        assert(Slice99Shared_new(sizeof(double), 0, &shared));
+        assert(Slice99_is_empty(shared.slice));
+        Slice99Shared_release(shared);
+
+        assert(!Slice99Shared_new(2, SIZE_MAX / 2, &shared));
+    }
+}
+
+#define SHARED_THREADS 4
+
+static void *shared_consume(void *arg) {
+    Slice99Shared *shared = arg;
+    assert(*(int *)Slice99_last(shared->slice) == 5);
+    Slice99Shared_release(*shared);
+    return NULL;
+}
+
+TEST(shared_threads) {
+    Slice99Shared shared, handles[SHARED_THREADS];
+    assert(Slice99Shared_from_slice(Slice99_from_array((int[]){1, 2, 3, 4, 5}), &shared));
+
+    pthread_t threads[SHARED_THREADS];
+    for (size_t i = 0; i < SHARED_THREADS; i++) {
+        handles[i] = Slice99Shared_share(shared);
+        assert(pthread_create(&threads[i], NULL, shared_consume, &handles[i]) == 0);
+    }
+
+    // The last handle to be released frees the buffer, whichever thread it belongs to.
+    Slice99Shared_release(shared);
+
+    for (size_t i = 0; i < SHARED_THREADS; i++) {
+        assert(pthread_join(threads[i], NULL) == 0);
+    }
+}
+
+#undef SHARED_THREADS
+TEST(parse_int) {
+    CharSlice99 rest;
+    uint64_t u;
+    int64_t i;
+
+#define CHECK_U64(str, expected)                                                                   \
+    assert(CharSlice99_parse_u64(CharSlice99_from_str(str), &u, NULL) && u == (expected))
+#define CHECK_I64(str, expected)                                                                   \
+    assert(CharSlice99_parse_i64(CharSlice99_from_str(str), &i, NULL) && i == (expected))
+
+    CHECK_U64("0", 0);
+    CHECK_U64("7", 7);
+    CHECK_U64("12345678", 12345678);
+    CHECK_U64("123456789", 123456789);
+    CHECK_U64("1234567890123456789", UINT64_C(1234567890123456789));
+    CHECK_U64("18446744073709551615", UINT64_MAX);
+    CHECK_U64("000000000000000000000000018446744073709551615", UINT64_MAX);
+
+    CHECK_I64("0", 0);
+    CHECK_I64("-0", 0);
+    CHECK_I64("+42", 42);
+    CHECK_I64("-42", -42);
+    CHECK_I64("9223372036854775807", INT64_MAX);
+    CHECK_I64("-9223372036854775808", INT64_MIN);
+
+#undef CHECK_U64
+#undef CHECK_I64
+
+    // Failures leave the outputs unchanged.
+    u = 99;
+    assert(!CharSlice99_parse_u64(CharSlice99_from_str(""), &u, &rest));
+    assert(!CharSlice99_parse_u64(CharSlice99_from_str("-1"), &u, &rest));
+    assert(!CharSlice99_parse_u64(CharSlice99_from_str(" 1"), &u, &rest));
+    assert(!CharSlice99_parse_u64(CharSlice99_from_str("18446744073709551616"), &u, &rest));
+    assert(!CharSlice99_parse_u64(CharSlice99_from_str("99999999999999999999"), &u, &rest));
+    assert(!CharSlice99_parse_u64(CharSlice99_from_str("123456789012345678901"), &u, &rest));
+    assert(!CharSlice99_parse_u64(CharSlice99_from_str("12a"), &u, NULL));
+    assert(u == 99);
+
+    i = 99;
+    assert(!CharSlice99_parse_i64(CharSlice99_from_str("-"), &i, &rest));
+    assert(!CharSlice99_parse_i64(CharSlice99_from_str("+-1"), &i, &rest));
+    assert(!CharSlice99_parse_i64(CharSlice99_from_str("9223372036854775808"), &i, &rest));
+    assert(!CharSlice99_parse_i64(CharSlice99_from_str("-9223372036854775809"), &i, &rest));
+    assert(i == 99);
+
+    // The rest of the slice.
+    assert(CharSlice99_parse_u64(CharSlice99_from_str("1234567890123,x"), &u, &rest));
+    assert(u == UINT64_C(1234567890123));
+    assert(CharSlice99_primitive_eq(rest, CharSlice99_from_str(",x")));
+
+    assert(CharSlice99_parse_i64(CharSlice99_from_str("-5"), &i, &rest));
+    assert(i == -5 && rest.len == 0);
+
+    // Not null-terminated.
+    assert(CharSlice99_parse_u64(CharSlice99_new("123456789", 4), &u, NULL) && u == 1234);
+}
+
+TEST(write_int) {
+    char buffer[SLICE99_U64_STR_MAX];
+    char expected[32];
+
+    uint64_t u = 1;
+    for (int k = 0; k < 20; k++, u *= 10) {
+        const uint64_t values[] = {u - 1, u, u + 1, u * 9};
+        for (size_t j = 0; j < SLICE99_ARRAY_LEN(values); j++) {
+            snprintf(expected, sizeof expected, "%" PRIu64, values[j]);
+            assert(CharSlice99_primitive_eq(
+                CharSlice99_write_u64(buffer, values[j]), CharSlice99_from_str(expected)));
+        }
+    }
+    assert(CharSlice99_primitive_eq(
+        CharSlice99_write_u64(buffer, UINT64_MAX), CharSlice99_from_str("18446744073709551615")));
+
+    const int64_t values[] = {0, 1, -1, 10, -99, 100, INT64_MAX, INT64_MIN, INT64_MIN + 1};
+    for (size_t j = 0; j < SLICE99_ARRAY_LEN(values); j++) {
+        snprintf(expected, sizeof expected, "%" PRId64, values[j]);
+        const CharSlice99 str = CharSlice99_write_i64(buffer, values[j]);
+        assert(CharSlice99_primitive_eq(str, CharSlice99_from_str(expected)));
+
+        int64_t parsed;
+        assert(CharSlice99_parse_i64(str, &parsed, NULL) && parsed == values[j]);
+    }
+}
+
+TEST(f64) {
+    char buffer[SLICE99_F64_STR_MAX];
+    CharSlice99 rest;
+    double x;
+
+#define CHECK_PARSE(str, expected)                                                                 \
+    assert(CharSlice99_parse_f64(CharSlice99_from_str(str), &x, NULL) && x == (expected))
+
+    CHECK_PARSE("0", 0.0);
+    CHECK_PARSE("1", 1.0);
+    CHECK_PARSE("-1.5", -1.5);
+    CHECK_PARSE("+.25", 0.25);
+    CHECK_PARSE("3.", 3.0);
+    CHECK_PARSE("1e10", 1e10);
+    CHECK_PARSE("1E-10", 1e-10);
+    CHECK_PARSE("0.1", 0.1);
+    CHECK_PARSE("123.456e-2", 1.23456);
+    CHECK_PARSE("1.7976931348623157e308", 1.7976931348623157e308);
+    CHECK_PARSE("2.2250738585072014e-308", 2.2250738585072014e-308);
+    CHECK_PARSE("4.9406564584124654e-324", 4.9406564584124654e-324);
+    CHECK_PARSE("123456789012345678901234567890", 123456789012345678901234567890.0);
+    CHECK_PARSE("0.000000000000000000000000000001", 1e-30);
+    CHECK_PARSE("9007199254740993", 9007199254740992.0);
+    // Requires moving powers of ten from the exponent to the mantissa.
+    CHECK_PARSE("123e30", 123e30);
+    CHECK_PARSE("1e400", HUGE_VAL);
+    CHECK_PARSE("-INF", -HUGE_VAL);
+    CHECK_PARSE("infinity", HUGE_VAL);
+
+#undef CHECK_PARSE
+
+    assert(CharSlice99_parse_f64(CharSlice99_from_str("-0"), &x, NULL) && x == 0.0 && signbit(x));
+    assert(CharSlice99_parse_f64(CharSlice99_from_str("1e-400"), &x, NULL) && x == 0.0);
+    assert(CharSlice99_parse_f64(CharSlice99_from_str("nan"), &x, NULL) && isnan(x));
+
+    // The exponent is not consumed without digits.
+    assert(CharSlice99_parse_f64(CharSlice99_from_str("2e+x"), &x, &rest) && x == 2.0);
+    assert(CharSlice99_primitive_eq(rest, CharSlice99_from_str("e+x")));
+
+    // A long number goes through an allocated buffer.
+    {
+        char str[300];
+        memset(str, '1', sizeof str - 5);
+        memcpy(str + sizeof str - 5, "e-99", 5);
+        assert(CharSlice99_parse_f64(CharSlice99_from_str(str), &x, NULL));
+        assert(x == strtod(str, NULL));
+    }
+
+    // The exponent saturates relative to the number of the digits.
+    {
+        enum { zeros = 10000000 };
+        char *str = malloc(zeros + 32);
+        assert(str);
+        memcpy(str, "0.", 2);
+        memset(str + 2, '0', zeros - 1);
+        strcpy(str + 2 + zeros - 1, "15e10000000");
+        assert(CharSlice99_parse_f64(CharSlice99_from_str(str), &x, NULL) && x == 1.5);
+        free(str);
+
+        assert(CharSlice99_parse_f64(CharSlice99_from_str("1e99999999999999999999"), &x, NULL));
+        assert(x == HUGE_VAL);
+        assert(CharSlice99_parse_f64(CharSlice99_from_str("1e-99999999999999999999"), &x, NULL));
+        assert(x == 0.0);
+    }
+
+    x = 42.0;
+    assert(!CharSlice99_parse_f64(CharSlice99_from_str(""), &x, &rest));
+    assert(!CharSlice99_parse_f64(CharSlice99_from_str("."), &x, &rest));
+    assert(!CharSlice99_parse_f64(CharSlice99_from_str("-e1"), &x, &rest));
+    assert(!CharSlice99_parse_f64(CharSlice99_from_str("1.5x"), &x, NULL));
+    assert(x == 42.0);
+
+#define CHECK_WRITE(value, expected)                                                               \
+    assert(CharSlice99_primitive_eq(                                                               \
+        CharSlice99_write_f64(buffer, value), CharSlice99_from_str(expected)))
+
+    CHECK_WRITE(0.0, "0");
+    CHECK_WRITE(-0.0, "-0");
+    CHECK_WRITE(1.0, "1");
+    CHECK_WRITE(0.1, "0.1");
+    CHECK_WRITE(-123.456, "-123.456");
+    CHECK_WRITE(1000.0, "1000");
+    CHECK_WRITE(0.001, "0.001");
+    CHECK_WRITE(0.0001, "0.0001");
+    CHECK_WRITE(0.00001, "1e-5");
+    CHECK_WRITE(1e14, "100000000000000");
+    CHECK_WRITE(1e15, "1e15");
+    CHECK_WRITE(1.5e300, "1.5e300");
+    CHECK_WRITE(5e-324, "5e-324");
+    CHECK_WRITE(-2.2250738585072014e-308, "-2.2250738585072014e-308");
+    CHECK_WRITE(1.7976931348623157e308, "1.7976931348623157e308");
+    CHECK_WRITE(HUGE_VAL, "inf");
+    CHECK_WRITE(-HUGE_VAL, "-inf");
+    CHECK_WRITE(NAN, "nan");
+
+#undef CHECK_WRITE
+
+    // Round trips.
+    srand(7);
+    for (int k = 0; k < 100000; k++) {
+        uint64_t bits = 0;
+        for (int j = 0; j < 4; j++) {
+            bits = bits << 16 | (uint64_t)(rand() & 0xFFFF);
+        }
+
+        double value, parsed;
+        memcpy(&value, &bits, sizeof value);
+        if (isnan(value)) {
+            continue;
+        }
+
+        const CharSlice99 str = CharSlice99_write_f64(buffer, value);
+        assert(str.len <= SLICE99_F64_STR_MAX);
+        assert(CharSlice99_parse_f64(str, &parsed, NULL));
+        assert(memcmp(&parsed, &value, sizeof value) == 0);
+    }
+}
+
+TEST(utf8) {
+#define CHECK_VALIDATE(str, expected)                                                              \
+    assert(CharSlice99_utf8_validate(CharSlice99_from_str(str)) == (expected))
+
+    CHECK_VALIDATE("", true);
+    CHECK_VALIDATE("abc", true);
+    CHECK_VALIDATE("\xC2\x80 \xDF\xBF \xE0\xA0\x80 \xED\x9F\xBF \xEE\x80\x80 \xEF\xBF\xBF", true);
+    CHECK_VALIDATE("\xF0\x90\x80\x80 \xF4\x8F\xBF\xBF", true);
+
+    // Stray continuation bytes and invalid lead bytes.
+    CHECK_VALIDATE("\x80", false);
+    CHECK_VALIDATE("a\xBF", false);
+    CHECK_VALIDATE("\xC0\x80", false);
+    CHECK_VALIDATE("\xC1\xBF", false);
+    CHECK_VALIDATE("\xF5\x80\x80\x80", false);
+    CHECK_VALIDATE("\xFF", false);
+
+    // Overlong encodings, surrogates, and codepoints beyond U+10FFFF.
+    CHECK_VALIDATE("\xE0\x9F\xBF", false);
+    CHECK_VALIDATE("\xED\xA0\x80", false);
+    CHECK_VALIDATE("\xED\xBF\xBF", false);
+    CHECK_VALIDATE("\xF0\x8F\xBF\xBF", false);
+    CHECK_VALIDATE("\xF4\x90\x80\x80", false);
+
+    // Truncated and overlong sequences.
+    CHECK_VALIDATE("\xC2", false);
+    CHECK_VALIDATE("\xE2\x82", false);
+    CHECK_VALIDATE("\xF0\x9F\x98", false);
+    CHECK_VALIDATE("\xE2\x82\xAC\xAC", false);
+    CHECK_VALIDATE("\xC2 ", false);
+
+#undef CHECK_VALIDATE
+
+    // Every position relative to the 16-byte blocks of the vectorized code path.
+    {
+        const char *chars[] = {"\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"};
+        char buffer[80];
+
+        for (size_t c = 0; c < SLICE99_ARRAY_LEN(chars); c++) {
+            const size_t size = strlen(chars[c]);
+
+            for (size_t pos = 0; pos + size <= sizeof buffer; pos++) {
+                memset(buffer, 'a', sizeof buffer);
+                memcpy(buffer + pos, chars[c], size);
+
+                U8Slice99 bytes = U8Slice99_new((uint8_t *)buffer, sizeof buffer);
+                assert(U8Slice99_utf8_validate(bytes));
+                assert(U8Slice99_utf8_len(bytes) == sizeof buffer - size + 1);
+
+                // Truncated.
+                for (size_t len = pos + 1; len < pos + size; len++) {
+                    assert(!U8Slice99_utf8_validate(U8Slice99_new((uint8_t *)buffer, len)));
+                }
+
+                // Missing a continuation byte.
+                buffer[pos + size - 1] = 'a';
+                assert(!U8Slice99_utf8_validate(bytes));
+
+                // A stray continuation byte.
+                memset(buffer, 'a', sizeof buffer);
+                buffer[pos] = (char)0x80;
+                assert(!U8Slice99_utf8_validate(bytes));
+            }
+        }
+    }
+
+    // Random bytes, checked against the decoder.
+    {
+        uint8_t buffer[64];
+
+        for (int i = 0; i < 100000; i++) {
+            const size_t len = (size_t)(rand() % (int)sizeof buffer);
+            for (size_t j = 0; j < len; j++) {
+                // Mostly ASCII and continuation bytes, so that valid inputs are frequent too.
+                const int r = rand() % 8;
+                buffer[j] = (uint8_t)(r < 3 ? 'a' : r < 6 ? 0x80 + rand() % 0x40 : rand() % 256);
+            }
+
+            U8Slice99 bytes = U8Slice99_new(buffer, len);
+            bool expected = true;
+            uint32_t codepoint;
+            while (U8Slice99_utf8_next(&bytes, &codepoint)) {
+                expected = expected && codepoint != SLICE99_UTF8_REPLACEMENT;
+            }
+
+            assert(U8Slice99_utf8_validate(U8Slice99_new(buffer, len)) == expected);
+        }
+    }
+
+    // Decoding.
+    {
+        CharSlice99 str = CharSlice99_from_str("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+        uint32_t codepoint;
+
+        assert(CharSlice99_utf8_len(str) == 4);
+
+        assert(CharSlice99_utf8_next(&str, &codepoint) && codepoint == 'a');
+        assert(CharSlice99_utf8_next(&str, &codepoint) && codepoint == 0xE9);
+        assert(CharSlice99_utf8_next(&str, &codepoint) && codepoint == 0x20AC);
+        assert(CharSlice99_utf8_next(&str, &codepoint) && codepoint == 0x1F600);
+        assert(!CharSlice99_utf8_next(&str, &codepoint));
+        assert(str.len == 0);
+    }
+
+    // The maximal subparts of invalid sequences are replaced.
+    {
+        CharSlice99 str = CharSlice99_from_str("\xF0\x9F\x98" "a\xE0\x80\xC0\xED\xA0");
+        const uint32_t expected[] = {
+            SLICE99_UTF8_REPLACEMENT, 'a', SLICE99_UTF8_REPLACEMENT, SLICE99_UTF8_REPLACEMENT,
+            SLICE99_UTF8_REPLACEMENT, SLICE99_UTF8_REPLACEMENT, SLICE99_UTF8_REPLACEMENT,
+        };
+        uint32_t codepoint;
+        size_t i = 0;
+
+        while (CharSlice99_utf8_next(&str, &codepoint)) {
+            assert(i < SLICE99_ARRAY_LEN(expected) && codepoint == expected[i]);
+            i++;
+        }
+        assert(i == SLICE99_ARRAY_LEN(expected));
+    }
+}
+
+static unsigned char ref_to_lower(unsigned char c) {
+    return c >= 'A' && c <= 'Z' ? (unsigned char)(c + ('a' - 'A')) : c;
+}
+
+static unsigned char ref_to_upper(unsigned char c) {
+    return c >= 'a' && c <= 'z' ? (unsigned char)(c - ('a' - 'A')) : c;
+}
+
+TEST(ascii_case) {
+    assert(CharSlice99_eq_ignore_ascii_case(CharSlice99_empty(), CharSlice99_empty()));
+    assert(CharSlice99_eq_ignore_ascii_case(
+        CharSlice99_from_str("Content-Type"), CharSlice99_from_str("cONTENT-tYPE")));
+    assert(!CharSlice99_eq_ignore_ascii_case(
+        CharSlice99_from_str("Content-Type"), CharSlice99_from_str("Content-Typ")));
+    // '@' and '`', '[' and '{' differ in the same bit as the case of letters.
+    assert(!CharSlice99_eq_ignore_ascii_case(
+        CharSlice99_from_str("@["), CharSlice99_from_str("`{")));
+    // The bytes outside of ASCII are not folded.
+    assert(!CharSlice99_eq_ignore_ascii_case(
+        CharSlice99_from_str("\xC1\xE1"), CharSlice99_from_str("\xE1\xC1")));
+
+    assert(CharSlice99_starts_with_ignore_ascii_case(
+        CharSlice99_from_str("Transfer-Encoding: chunked"), CharSlice99_from_str("TRANSFER-")));
+    assert(!CharSlice99_starts_with_ignore_ascii_case(
+        CharSlice99_from_str("Trans"), CharSlice99_from_str("Transfer")));
+    assert(CharSlice99_ends_with_ignore_ascii_case(
+        CharSlice99_from_str("gzip, CHUNKED"), CharSlice99_from_str("chunked")));
+    assert(!CharSlice99_ends_with_ignore_ascii_case(
+        CharSlice99_from_str("gzip, chunked"), CharSlice99_from_str("gzip")));
+
+    // Every length and alignment around the 8- and 16-byte kernels, with every bit pattern.
+    unsigned char lhs[48], rhs[48], expected[48];
+    unsigned seed = 1;
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t len = 0; len <= sizeof lhs - offset; len++) {
+            for (size_t i = 0; i < len; i++) {
+                seed = seed * 1103515245 + 12345;
+                lhs[offset + i] = (unsigned char)(seed >> 16);
+                expected[i] = ref_to_lower(lhs[offset + i]);
+                rhs[offset + i] = seed >> 8 & 1 ? ref_to_upper(lhs[offset + i]) : expected[i];
+            }
+
+            const CharSlice99 l = CharSlice99_new((char *)lhs + offset, len),
+                              r = CharSlice99_new((char *)rhs + offset, len);
+            assert(CharSlice99_eq_ignore_ascii_case(l, r));
+            assert(CharSlice99_starts_with_ignore_ascii_case(l, CharSlice99_sub(r, 0, len / 2)));
+            assert(CharSlice99_ends_with_ignore_ascii_case(
+                l, CharSlice99_advance(r, (ptrdiff_t)(len / 2))));
+
+            for (size_t i = 0; i < len; i++) {
+                const unsigned char saved = rhs[offset + i];
+                rhs[offset + i] = (unsigned char)(expected[i] == 'q' ? 'w' : 'q');
+                assert(!CharSlice99_eq_ignore_ascii_case(l, r));
+                rhs[offset + i] = saved;
+            }
+
+            CharSlice99_to_ascii_lower(r);
+            for (size_t i = 0; i < len; i++) {
+                assert(rhs[offset + i] == expected[i]);
+            }
+
+            CharSlice99_to_ascii_upper(r);
+            for (size_t i = 0; i < len; i++) {
+                assert(rhs[offset + i] == ref_to_upper(expected[i]));
+            }
+        }
+    }
+}
+
+TEST(trim) {
+    assert(CharSlice99_is_empty(CharSlice99_trim(CharSlice99_empty())));
+    assert(CharSlice99_is_empty(CharSlice99_trim(CharSlice99_from_str(" \t\n\v\f\r"))));
+    assert(CharSlice99_primitive_eq(
+        CharSlice99_trim(CharSlice99_from_str("  a b  ")), CharSlice99_from_str("a b")));
+    assert(CharSlice99_primitive_eq(
+        CharSlice99_trim_start(CharSlice99_from_str("  a b  ")), CharSlice99_from_str("a b  ")));
+    assert(CharSlice99_primitive_eq(
+        CharSlice99_trim_end(CharSlice99_from_str("  a b  ")), CharSlice99_from_str("  a b")));
+    // The neighbours of the whitespace bytes and the non-breaking space are not whitespace.
+    assert(CharSlice99_primitive_eq(
+        CharSlice99_trim(CharSlice99_from_str("\x08\x0E\x1F!\xA0\x85")),
+        CharSlice99_from_str("\x08\x0E\x1F!\xA0\x85")));
+
+    // Runs of whitespace of every length and alignment around the 8- and 16-byte kernels.
+    char buffer[48];
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t len = 0; len <= sizeof buffer - offset; len++) {
+            for (size_t start = 0; start <= len; start++) {
+                const size_t end = start + (len - start) / 2;
+                for (size_t i = 0; i < len; i++) {
+                    buffer[offset + i] = i < start || i >= end ? " \t\n\v\f\r"[i % 6] : 'x';
+                }
+
+                const CharSlice99 s = CharSlice99_new(buffer + offset, len);
+                const size_t expected_start = start < end ? start : len,
+                             expected_end = start < end ? end : 0;
+
+                const CharSlice99 trimmed_start = CharSlice99_trim_start(s);
+                assert(trimmed_start.ptr == buffer + offset + expected_start);
+                assert(trimmed_start.len == len - expected_start);
+
+                const CharSlice99 trimmed_end = CharSlice99_trim_end(s);
+                assert(trimmed_end.ptr == s.ptr);
+                assert(trimmed_end.len == expected_end);
+
+                const CharSlice99 trimmed = CharSlice99_trim(s);
+                assert(trimmed.len == (start < end ? end - start : 0));
+            }
+        }
+    }
+}
+
+TEST(typed_mutators) {
+    // No backup is required for typed slices.
+    {
+        MyPoints points = (MyPoints)Slice99_typed_from_array((Point[]){{1, 2}, {3, 4}, {5, 6}});
+
+        MyPoints_swap(points, 0, 2, NULL);
+        assert(points.ptr[0].x == 5 && points.ptr[0].y == 6);
+        assert(points.ptr[2].x == 1 && points.ptr[2].y == 2);
+    }
+
+    {
+        int lhs_data[] = {1, 2, 3}, rhs_data[] = {4, 5, 6};
+        IntSlice99 lhs = (IntSlice99)Slice99_typed_from_array(lhs_data),
+                   rhs = (IntSlice99)Slice99_typed_from_array(rhs_data);
+
+        IntSlice99_swap_with_slice(lhs, rhs, NULL);
+        assert(memcmp(lhs_data, (int[]){4, 5, 6}, sizeof lhs_data) == 0);
+        assert(memcmp(rhs_data, (int[]){1, 2, 3}, sizeof rhs_data) == 0);
+    }
+
+    {
+        U8Slice99 empty = U8Slice99_empty(), one = U8Slice99_new((uint8_t[]){42}, 1);
+        U8Slice99_reverse(empty, NULL);
+        U8Slice99_reverse(one, NULL);
+        assert(one.ptr[0] == 42);
+
+        U32Slice99 data = (U32Slice99)Slice99_typed_from_array((uint32_t[]){1, 2, 3, 4});
+        U32Slice99_reverse(data, NULL);
+        assert(memcmp(data.ptr, (uint32_t[]){4, 3, 2, 1}, U32Slice99_size(data)) == 0);
+    }
+
+    {
+        Point data[3];
+        MyPoints points = (MyPoints)Slice99_typed_from_array(data);
+
+        MyPoints_fill(points, &(Point){1, 2});
+        assert(data[2].x == 1 && data[2].y == 2);
+
+        MyPoints_memset(points, 0);
+        assert(data[0].x == 0 && data[2].y == 0);
+    }
+}
+
+TEST(typed_constant_time) {
+    Point data[] = {{1, 2}, {3, 4}, {5, 6}, {7, 8}};
+    const MyPoints points = (MyPoints)Slice99_typed_from_array(data);
+
+    assert(MyPoints_size(points) == sizeof(data));
+    assert(!MyPoints_is_empty(points));
+    assert(MyPoints_is_empty(MyPoints_update_len(points, 0)));
+
+    assert(MyPoints_get(points, 2) == &data[2]);
+    assert(MyPoints_first(points) == &data[0]);
+    assert(MyPoints_last(points) == &data[3]);
+
+    // The results must match those of the untyped functions.
+    {
+        const Slice99 untyped = SLICE99_TO_UNTYPED(points);
+
+        const MyPoints sub = MyPoints_sub(points, 1, 3);
+        const Slice99 untyped_sub = Slice99_sub(untyped, 1, 3);
+        assert(sub.ptr == untyped_sub.ptr && sub.len == untyped_sub.len);
+
+        const MyPoints advanced = MyPoints_advance(points, 3);
+        const Slice99 untyped_advanced = Slice99_advance(untyped, 3);
+        assert(advanced.ptr == untyped_advanced.ptr && advanced.len == untyped_advanced.len);
+    }
+
+    // Negative indices.
+    {
+        const MyPoints tail = MyPoints_advance(points, 2);
+        assert(MyPoints_get(tail, -1) == &data[1]);
+
+        const MyPoints sub = MyPoints_sub(tail, -2, 1);
+        assert(sub.ptr == &data[0] && sub.len == 3);
+    }
+
+    {
+        MyPoints lhs, rhs;
+        MyPoints_split_at(points, 1, &lhs, &rhs);
+        assert(lhs.ptr == &data[0] && lhs.len == 1);
+        assert(rhs.ptr == &data[1] && rhs.len == 3);
+
+        MyPoints_split_at(points, 4, &lhs, &rhs);
+        assert(lhs.len == 4 && MyPoints_is_empty(rhs));
+    }
+
+    {
+        const MyPoints range = MyPoints_from_ptrdiff(&data[1], &data[4]);
+        assert(range.ptr == &data[1] && range.len == 3);
+
+        const MyPoints empty = MyPoints_from_ptrdiff(&data[2], &data[2]);
+        assert(MyPoints_is_empty(empty));
+    }
+}
+
+TEST(fundamentals) {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-result"
+
+    (void)CharSlice99_new((char[]){'a', 'b', 'c'}, 3);
+    (void)SCharSlice99_new((signed char[]){'a', 'b', 'c'}, 3);
+    (void)UCharSlice99_new((unsigned char[]){'a', 'b', 'c'}, 3);
+
+    (void)ShortSlice99_new((short[]){1, 2, 3}, 3);
+    (void)UShortSlice99_new((unsigned short[]){1, 2, 3}, 3);
+
+    (void)IntSlice99_new((int[]){1, 2, 3}, 3);
+    (void)UIntSlice99_new((unsigned int[]){1, 2, 3}, 3);
+
+    (void)LongSlice99_new((long[]){1, 2, 3}, 3);
+    (void)ULongSlice99_new((unsigned long[]){1, 2, 3}, 3);
+    (void)LongLongSlice99_new((long long[]){1, 2, 3}, 3);
+    (void)ULongLongSlice99_new((unsigned long long[]){1, 2, 3}, 3);
+
+    (void)FloatSlice99_new((float[]){1, 2, 3}, 3);
+    (void)DoubleSlice99_new((double[]){1, 2, 3}, 3);
+    (void)LongDoubleSlice99_new((long double[]){1, 2, 3}, 3);
+
+    (void)BoolSlice99_new((_Bool[]){1, 2, 3}, 3);
+
+    (void)U8Slice99_new((uint8_t[]){1, 2, 3}, 3);
+    (void)U16Slice99_new((uint16_t[]){1, 2, 3}, 3);
+    (void)U32Slice99_new((uint32_t[]){1, 2, 3}, 3);
+    (void)U64Slice99_new((uint64_t[]){1, 2, 3}, 3);
+
+    (void)I8Slice99_new((int8_t[]){1, 2, 3}, 3);
+    (void)I16Slice99_new((int16_t[]){1, 2, 3}, 3);
+    (void)I32Slice99_new((int32_t[]){1, 2, 3}, 3);
+    (void)I64Slice99_new((int64_t[]){1, 2, 3}, 3);
+
+#pragma GCC diagnostic pop
+}
+
+TEST(to_typed) {
+    char *str = "abc";
+    const Slice99 x = Slice99_from_str(str);
+    CharSlice99 y = (CharSlice99)SLICE99_TO_TYPED(x);
+
+    assert(x.ptr == y.ptr);
+    assert(x.len == y.len);
+}
+
+TEST(to_untyped) {
+    // clang-format off
+    char *str = "abc";
+    ASSERT_SLICE(
+        SLICE99_TO_UNTYPED(CharSlice99_from_str(str)),
+        PTR str,
+        ITEM_SIZE sizeof str[0],
+        LEN strlen(str)
+    );
+    // clang-format on
+}
+
+TEST(fmt) {
+    char *expected = "123 --- abc", *fmt = "%d --- %s";
+    const size_t bufsz = strlen(expected) + 1;
+    char *buffer = alloca(bufsz);
 
 #define CHECK assert(CharSlice99_primitive_eq(ret, CharSlice99_from_str(expected)))
 
@@ -921,6 +3832,155 @@ TEST(fmt) {
 #undef CHECK
 }
 
+TEST(try_fmt) {
+    char buffer[8];
+    CharSlice99 result;
+
+    // The length returned by the formatter is used as is, even with embedded null characters.
+    result = CharSlice99_fmt(buffer, "a%cb", '\0');
+    assert(result.ptr == buffer && result.len == 3);
+
+    result = CharSlice99_nfmt(buffer, sizeof buffer, "%s", "abc");
+    assert(CharSlice99_primitive_eq(result, CharSlice99_from_str("abc")));
+    result = CharSlice99_nfmt(buffer, sizeof buffer, "%s", "0123456789");
+    assert(CharSlice99_primitive_eq(result, CharSlice99_from_str("0123456")));
+    result = CharSlice99_nfmt(NULL, 0, "%s", "abc");
+    assert(result.len == 0);
+
+    assert(CharSlice99_try_nfmt(buffer, sizeof buffer, &result, "%d", 1234567));
+    assert(CharSlice99_primitive_eq(result, CharSlice99_from_str("1234567")));
+
+    assert(!CharSlice99_try_nfmt(buffer, sizeof buffer, &result, "%d", 12345678));
+    assert(CharSlice99_primitive_eq(result, CharSlice99_from_str("1234567")));
+    assert(buffer[7] == '\0');
+
+    assert(!CharSlice99_try_nfmt(NULL, 0, &result, "%d", 1));
+    assert(result.len == 0);
+}
+
+static void *stats_copy(void *arg) {
+    char *buffer = arg;
+    Slice99_copy(Slice99_new(buffer, 1, 4), Slice99_new(buffer + 4, 1, 4));
+
+    const Slice99Stats stats = Slice99Stats_snapshot();
+    assert(stats.ops[SLICE99_STATS_COPY].calls == 1);
+    assert(stats.ops[SLICE99_STATS_COPY].bytes == 4);
+
+    return NULL;
+}
+
+TEST(stats) {
+    char buffer[8] = "abcdefg";
+    Slice99Stats stats;
+
+    Slice99Stats_reset();
+    stats = Slice99Stats_snapshot();
+    for (int op = 0; op < SLICE99_STATS_OP_COUNT; op++) {
+        assert(stats.ops[op].calls == 0 && stats.ops[op].bytes == 0);
+    }
+
+    const unsigned long long hook_bytes = stats_hook_bytes;
+
+    Slice99_copy(Slice99_new(buffer, 1, 3), Slice99_new(buffer + 3, 1, 3));
+    Slice99_copy_non_overlapping(Slice99_new(buffer, 2, 1), Slice99_new(buffer + 4, 2, 1));
+
+    // Typed slices are counted as untyped ones.
+    assert(CharSlice99_primitive_eq(CharSlice99_new(buffer, 3), CharSlice99_new(buffer, 3)));
+    assert(!CharSlice99_primitive_eq(CharSlice99_new(buffer, 3), CharSlice99_new(buffer + 1, 3)));
+    // The hook observes the counters updated by its call.
+    assert(stats_hook_flagged == 1);
+    assert(!CharSlice99_primitive_eq(CharSlice99_new(buffer, 3), CharSlice99_new(buffer, 2)));
+    assert(stats_hook_flagged == 2);
+
+    CharSlice99 result = CharSlice99_fmt(buffer, "%d", 123);
+    result = CharSlice99_nfmt(buffer, 4, "%s", "abcdef");
+    assert(stats_hook_flagged == 1);
+    assert(!CharSlice99_try_nfmt(buffer, 3, &result, "%d", 123));
+    assert(CharSlice99_try_nfmt(buffer, 3, &result, "%d", 12));
+
+    // The arena and writer functions are counted as the ones formatting into a buffer.
+    {
+        char arena_buffer[16];
+        Slice99Arena arena = Slice99Arena_new(arena_buffer, sizeof arena_buffer);
+        assert(CharSlice99_arena_fmt(&arena, &result, "%d", 1234));
+        Slice99Arena_free(&arena);
+
+        uint8_t writer_buffer[4];
+        Slice99Writer w = Slice99Writer_new((U8Slice99)Slice99_typed_from_array(writer_buffer));
+        assert(Slice99Writer_fmt(&w, "%d", 1));
+        assert(!Slice99Writer_fmt(&w, "%d", 123));
+        assert(!Slice99Writer_fmt(&w, "%d", 1));
+    }
+
+    stats = Slice99Stats_snapshot();
+
+    assert(stats.ops[SLICE99_STATS_COPY].calls == 1);
+    assert(stats.ops[SLICE99_STATS_COPY].bytes == 3);
+    assert(stats.ops[SLICE99_STATS_COPY_NON_OVERLAPPING].calls == 1);
+    assert(stats.ops[SLICE99_STATS_COPY_NON_OVERLAPPING].bytes == 2);
+
+    assert(stats.ops[SLICE99_STATS_PRIMITIVE_EQ].calls == 3);
+    assert(stats.ops[SLICE99_STATS_PRIMITIVE_EQ].bytes == 6);
+    assert(stats.ops[SLICE99_STATS_PRIMITIVE_EQ].mismatches == 2);
+
+    assert(stats.ops[SLICE99_STATS_FMT].calls == 2);
+    assert(stats.ops[SLICE99_STATS_FMT].bytes == 3 + 4);
+
+    assert(stats.ops[SLICE99_STATS_NFMT].calls == 6);
+    assert(stats.ops[SLICE99_STATS_NFMT].bytes == 3 + 2 + 2 + 1);
+    assert(stats.ops[SLICE99_STATS_NFMT].truncations == 3);
+
+    assert(stats_hook_bytes - hook_bytes == 3 + 2 + 6 + 7 + 8);
+
+    // The counters are thread-local.
+    {
+        pthread_t thread;
+        assert(pthread_create(&thread, NULL, stats_copy, buffer) == 0);
+        assert(pthread_join(thread, NULL) == 0);
+
+        assert(Slice99Stats_snapshot().ops[SLICE99_STATS_COPY].calls == 1);
+    }
+
+    Slice99Stats_reset();
+    assert(Slice99Stats_snapshot().ops[SLICE99_STATS_NFMT].truncations == 0);
+
+    // Contiguous strided views are copied and compared as slices.
+    {
+        const Slice99Strided lhs = Slice99Strided_from_slice(Slice99_new(buffer, 1, 2)),
+                             rhs = Slice99Strided_from_slice(Slice99_new(buffer + 2, 1, 2));
+        Slice99Strided_copy(lhs, rhs);
+        assert(Slice99Strided_primitive_eq(lhs, rhs));
+
+        stats = Slice99Stats_snapshot();
+        assert(stats.ops[SLICE99_STATS_COPY].calls == 1);
+        assert(stats.ops[SLICE99_STATS_COPY].bytes == 2);
+        assert(stats.ops[SLICE99_STATS_PRIMITIVE_EQ].calls == 1);
+        assert(stats.ops[SLICE99_STATS_PRIMITIVE_EQ].bytes == 2);
+        Slice99Stats_reset();
+    }
+
+    assert(strcmp(Slice99StatsOp_name(SLICE99_STATS_COPY), "copy") == 0);
+    assert(strcmp(Slice99StatsOp_name(SLICE99_STATS_NFMT), "nfmt") == 0);
+}
+
+TEST(writer_fmt) {
+    uint8_t buffer[16];
+    Slice99Writer w = Slice99Writer_new((U8Slice99)Slice99_typed_from_array(buffer));
+
+    assert(Slice99Writer_fmt(&w, "%d-%s", 42, "abc"));
+    assert(Slice99Writer_write_u8(&w, '|'));
+    assert(Slice99Writer_fmt(&w, "%s", ""));
+    assert(Slice99Writer_fmt(&w, "%x", 255u));
+    assert(U8Slice99_primitive_eq(
+        Slice99Writer_written(w), (U8Slice99)Slice99_typed_from_array((uint8_t[]){
+                                      '4', '2', '-', 'a', 'b', 'c', '|', 'f', 'f'})));
+
+    // 7 bytes remain, but the null character needs one more.
+    assert(!Slice99Writer_fmt(&w, "%s", "1234567"));
+    assert(w.overflowed && Slice99Writer_written(w).len == 9);
+    assert(!Slice99Writer_fmt(&w, "%s", ""));
+}
+
 int main(void) {
     srand((unsigned)time(NULL));
 
@@ -945,20 +4005,66 @@ int main(void) {
     test_starts_with();
     test_primitive_ends_with();
     test_ends_with();
+    test_primitive_find_item();
+    test_primitive_find();
+    test_find();
     test_copy();
     test_copy_non_overlapping();
+    test_fill();
     test_swap();
     test_swap_with_slice();
     test_reverse();
     test_split_at();
+    test_align_to();
+    test_split_iter();
     test_to_c_str();
 
     test_def_typed();
+    test_def_typed_eq();
+    test_vec();
+    test_writer();
+    test_writer_varint();
+    test_reader();
+    test_reader_varint();
+    test_mmap_file();
+    test_iovec();
+    test_ring();
+    test_spsc_ring();
+    test_spsc_queue();
+    test_mpmc_queue();
+    test_queue_threads();
+    test_par();
+    test_sort();
+    test_bsearch();
+    test_radix_sort();
+    test_primitive_hash();
+    test_crc32c();
+    test_map();
+    test_interner();
+    test_interner_threads();
+    test_shared();
+    test_shared_threads();
+    test_parse_int();
+    test_write_int();
+    test_f64();
+    test_utf8();
+    test_ascii_case();
+    test_trim();
+    test_strided();
+    test_matrix();
+    test_chain();
+    test_gather_scatter();
+    test_typed_mutators();
+    test_typed_constant_time();
     test_fundamentals();
     test_to_typed();
     test_to_untyped();
 
     test_fmt();
+    test_try_fmt();
+    test_stats();
+    test_writer_fmt();
+    test_arena();
 
     puts("All the tests have passed!");
 }